@@ -106,6 +106,7 @@ typedef enum BifrostVMStandardModule
   BIFROST_VM_STD_MODULE_MEMORY      = (1 << 1), /*!< "std:memory"      */
   BIFROST_VM_STD_MODULE_FUNCTIONAL  = (1 << 2), /*!< "std:functional"  */
   BIFROST_VM_STD_MODULE_COLLECTIONS = (1 << 3), /*!< "std:collections" */
+  BIFROST_VM_STD_MODULE_STRING      = (1 << 4), /*!< "std:string"      */
 #define BIFROST_VM_STD_MODULE_ALL 0xFFFFFFFF    /*!< "std:*"           */
 
 } BifrostVMStandardModule;
@@ -207,6 +208,34 @@ typedef void (*bfPrintFn)(BifrostVM* vm, const char* message);
  */
 typedef void (*bfModuleFn)(BifrostVM* vm, const char* from, const char* module, BifrostVMModuleLookUp* out);
 
+/*!
+ * @brief
+ *   Receives consecutive chunks of a bytecode image from 'bfVM_moduleSaveBytecode'.
+ */
+typedef void (*bfBytecodeWriteFn)(void* user_data, const void* data, size_t data_size);
+
+/*!
+ * @brief
+ *   Copies up to \p buffer_size bytes of source into \p buffer for 'bfVM_execInModuleStream',
+ *   returns the number of bytes written, 0 marks the end of the source.
+ */
+typedef size_t (*bfSourceReadFn)(void* user_data, char* buffer, size_t buffer_size);
+
+/*!
+ * @brief
+ *   Asked for a previously stored bytecode image of \p module before its source is compiled.
+ *   On a hit [BifrostVMModuleLookUp::source] is set to the image, allocated the same way
+ *   'bfModuleFn' allocates source, otherwise \p out is left alone.
+ */
+typedef void (*bfCacheLookUpFn)(BifrostVM* vm, const char* module, uint64_t source_hash, BifrostVMModuleLookUp* out);
+
+/*!
+ * @brief
+ *   Receives the bytecode image of \p module right after it has been compiled from source,
+ *   \p bytecode is only valid for the duration of the call.
+ */
+typedef void (*bfCacheStoreFn)(BifrostVM* vm, const char* module, uint64_t source_hash, const void* bytecode, size_t bytecode_size);
+
 /*!
  * @brief
  *   If old_size is 0u / ptr == NULL : Act as Malloc.\n
@@ -217,14 +246,19 @@ typedef void* (*bfMemoryFn)(void* user_data, void* ptr, size_t old_size, size_t
 
 typedef struct BifrostVMParams
 {
-  bfErrorFn  error_fn;           /*!< The callback for anytime an error occurs.                                                              */
-  bfPrintFn  print_fn;           /*!< The callback for when a script tried to print a message.                                               */
-  bfModuleFn module_fn;          /*!< The callback for attempting to load a non std:* module.                                                */
-  bfMemoryFn memory_fn;          /*!< The callback for the vm asking for memory.                                                             */
-  size_t     min_heap_size;      /*!< The minimum size of the virtual heap must be at all times.                                             */
-  size_t     heap_size;          /*!< The starting heap size. Must be greater or equal to [BifrostVMParams::min_heap_size].                  */
-  float      heap_growth_factor; /*!< The percent amount to grow the size of the virtual heap before calling the GC again. (Ex: 0.5f = x1.5) */
-  void*      user_data;          /*!< The user_data for the memory allocation callback.                                                      */
+  bfErrorFn       error_fn;           /*!< The callback for anytime an error occurs.                                                              */
+  bfPrintFn       print_fn;           /*!< The callback for when a script tried to print a message.                                               */
+  bfModuleFn      module_fn;          /*!< The callback for attempting to load a non std:* module.                                                */
+  bfMemoryFn      memory_fn;          /*!< The callback for the vm asking for memory.                                                             */
+  size_t          min_heap_size;      /*!< The minimum size of the virtual heap must be at all times.                                             */
+  size_t          heap_size;          /*!< The starting heap size. Must be greater or equal to [BifrostVMParams::min_heap_size].                  */
+  float           heap_growth_factor; /*!< The percent amount to grow the size of the virtual heap before calling the GC again. (Ex: 0.5f = x1.5) */
+  void*           user_data;          /*!< The user_data for the memory allocation callback.                                                      */
+  uint32_t        inline_threshold;   /*!< Module functions with at most this many instructions are inlined at their call sites, 0 disables it.   */
+  bool            lazy_compile;       /*!< Module level function bodies are compiled on their first call, a copy of the module source is kept.    */
+  bool            strip_debug_info;   /*!< No line tables are kept for compiled functions (or written to bytecode), errors report line -1.       */
+  bfCacheLookUpFn cache_lookup_fn;    /*!< Optional compile cache, checked with the module name and a hash of its source before compiling.        */
+  bfCacheStoreFn  cache_store_fn;     /*!< Optional compile cache, given the bytecode of every module compiled from source (unless lazy).         */
 
 } BifrostVMParams; /*! The parameters in which to initialize a BifrostVM. */
 
@@ -239,6 +273,11 @@ typedef struct BifrostVMParams
  *    self->heap_size          = 5242880;              - 5mb
  *    self->heap_growth_factor = 0.5f;                 - Grow by x1.5
  *    self->user_data          = NULL;                 - User data for the memory allocator, and maybe other future things.
+ *    self->inline_threshold   = 0;                    - Inlining of small functions is opt-in.
+ *    self->lazy_compile       = false;                - Every function body is compiled up front.
+ *    self->strip_debug_info   = false;                - Functions keep a line table for errors and stack traces.
+ *    self->cache_lookup_fn    = NULL;                 - Modules are always compiled from source.
+ *    self->cache_store_fn     = NULL;                 - Nothing is handed to a compile cache.
  *
  * @param self
  *   The BifrostVMParams to initialize to reasonable defaults.
@@ -302,6 +341,7 @@ struct BifrostVM
   BifrostObj*          finalized;                               /*!< Objects that have finalized but still need to be freed                         */
   BifrostGCRoot*       gc_roots;                                /*!< Objects temporarily protected from the GC                                      */
   bool                 gc_is_running;                           /*!< This is so that when calling a finalizer the GC isn't run.                     */
+  uint32_t             class_version;                           /*!< Bumped whenever a class gains a member, a field or a base or is freed.         */
   uint32_t             build_in_symbols[BIFROST_VM_SYMBOL_MAX]; /*!< Symbols that should be loaded at startup for a faster runtime.                 */
   BifrostObjNativeFn*  current_native_fn;                       /*!< The currently executing native function for accessing of userdata and statics. */
 };
@@ -403,6 +443,39 @@ BF_VM_API BifrostVMError bfVM_moduleLoad(BifrostVM* self, size_t idx, const char
  */
 BF_VM_API void bfVM_moduleUnload(BifrostVM* self, const char* module, const size_t module_name_len);
 
+/*!
+ * @brief
+ *   Recompiles the already loaded module _ \p module_ from \p source
+ *   and patches the result into the live module.
+ *
+ *   Functions and classes are updated in place so every existing reference
+ *   to them (other modules, instances, handles) picks up the new code.
+ *   Module and static variables that already existed keep their values
+ *   and the module's top level code is not run again, new variables start as nil.
+ *
+ *   Constants take their new value, but other modules that imported them
+ *   have them inlined into their code and only see the new value once
+ *   they are reloaded too.
+ *
+ * @param self
+ *   The vm to operate on.
+ *
+ * @param module
+ *   The name of the module to reload.
+ *
+ * @param source
+ *   The new source code of the module.
+ *
+ * @param source_length
+ *   The length of \p source.
+ *
+ * @return BifrostVMError
+ *   BIFROST_VM_ERROR_MODULE_NOT_FOUND - The module was never loaded.
+ *   BIFROST_VM_ERROR_INVALID_ARGUMENT - The module is currently running (called from one of its own functions).
+ *   BIFROST_VM_ERROR_COMPILE          - \p source contains invalid code, the live module is left untouched.
+ */
+BF_VM_API BifrostVMError bfVM_moduleReload(BifrostVM* self, const char* module, const char* source, size_t source_length);
+
 /*!
  * @brief
  *   Purges all loaded modules from the vm.
@@ -1045,6 +1118,227 @@ BF_VM_API BifrostVMError bfVM_call(BifrostVM* self, size_t idx, size_t args_star
  */
 BF_VM_API BifrostVMError bfVM_execInModule(BifrostVM* self, const char* module, const char* source, size_t source_length);
 
+/*!
+ * @brief
+ *   Same as 'bfVM_execInModule' except the top level code of the
+ *   module is not run, imports are still resolved since that happens
+ *   at compile time. Useful for compiling a module to bytecode.
+ *
+ *   The final module will be located in API_stack[0].
+ *
+ * @param self
+ *   The vm that will be operated on.
+ *
+ * @param module
+ *   The name of the module to store the code into.
+ *   if NULL we will compile into an anon module.
+ *
+ * @param source
+ *   The beginning of the source string.
+ *
+ * @param source_length
+ *   The length of the source string.
+ *
+ * @return BifrostVMError
+ *   BIFROST_VM_ERROR_MODULE_ALREADY_DEFINED - If the module has already been defined we have a problem.
+ *   BIFROST_VM_ERROR_COMPILE                - If the \p source string contains invalid code.
+ */
+BF_VM_API BifrostVMError bfVM_compileInModule(BifrostVM* self, const char* module, const char* source, size_t source_length);
+
+/*!
+ * @brief
+ *   Same as 'bfVM_execInModule' except the source is pulled in chunks
+ *   from \p read_fn rather than needing to be in memory all at once.
+ *
+ *   The lexer only keeps a small window of the source around (the line
+ *   being compiled plus some look ahead), so peak memory does not grow
+ *   with the size of the script. Bytecode images, lazy compilation and
+ *   the compile cache all need the whole source so are not used.
+ *
+ *   The final module will be located in API_stack[0].
+ *
+ * @param self
+ *   The vm that will be operated on.
+ *
+ * @param module
+ *   The name of the module to store the code into.
+ *   if NULL we will exec in an anon module.
+ *
+ * @param read_fn
+ *   Called whenever the lexer needs more of the source.
+ *
+ * @param user_data
+ *   Passed through to \p read_fn.
+ *
+ * @return BifrostVMError
+ *   BIFROST_VM_ERROR_MODULE_ALREADY_DEFINED - If the module has already been defined we have a problem.
+ *   BIFROST_VM_ERROR_COMPILE                - If the source contains invalid code.
+ *   BIFROST_VM_ERROR_RUNTIME                - There was a runtime error somewhere along the source execution.
+ */
+BF_VM_API BifrostVMError bfVM_execInModuleStream(BifrostVM* self, const char* module, bfSourceReadFn read_fn, void* user_data);
+
+/*!
+ * @brief
+ *   The 'bfVM_compileInModule' version of 'bfVM_execInModuleStream',
+ *   the top level code of the module is not run.
+ *
+ *   The final module will be located in API_stack[0].
+ *
+ * @param self
+ *   The vm that will be operated on.
+ *
+ * @param module
+ *   The name of the module to store the code into.
+ *   if NULL we will compile into an anon module.
+ *
+ * @param read_fn
+ *   Called whenever the lexer needs more of the source.
+ *
+ * @param user_data
+ *   Passed through to \p read_fn.
+ *
+ * @return BifrostVMError
+ *   BIFROST_VM_ERROR_MODULE_ALREADY_DEFINED - If the module has already been defined we have a problem.
+ *   BIFROST_VM_ERROR_COMPILE                - If the source contains invalid code.
+ */
+BF_VM_API BifrostVMError bfVM_compileInModuleStream(BifrostVM* self, const char* module, bfSourceReadFn read_fn, void* user_data);
+
+/*!
+ * @brief
+ *   Serializes the compiled module at \p idx into a bytecode image.
+ *
+ *   The image contains the functions, constants, classes, line info and
+ *   the symbol names they use. Values imported from other modules are
+ *   saved by name and imported again on load. The module must not have
+ *   been run yet (see 'bfVM_compileInModule') since a module's top level
+ *   code is released once it runs, instances created by top level code
+ *   are saved as null.
+ *
+ * @param self
+ *   The vm that will be operated on.
+ *
+ * @param idx
+ *   The index on the stack of the module to save.
+ *
+ * @param write_fn
+ *   Called with each chunk of the image in order.
+ *
+ * @param user_data
+ *   Passed through to \p write_fn.
+ *
+ * @return BifrostVMError
+ *   BIFROST_VM_ERROR_INVALID_OP_ON_TYPE - The value at \p idx is not a module.
+ *   BIFROST_VM_ERROR_INVALID_ARGUMENT   - The module has already run or refers to a value that cannot be saved (Ex: A native function bound only to this module).
+ *   BIFROST_VM_ERROR_COMPILE            - A lazily compiled function body failed to compile.
+ */
+BF_VM_API BifrostVMError bfVM_moduleSaveBytecode(BifrostVM* self, size_t idx, bfBytecodeWriteFn write_fn, void* user_data);
+
+/*!
+ * @brief
+ *   Loads a bytecode image made by 'bfVM_moduleSaveBytecode' and runs it
+ *   just like 'bfVM_execInModule' does for source code.
+ *
+ *   'bfVM_execInModule' and module imports also accept bytecode images,
+ *   this function just rejects anything that is not one.
+ *
+ *   The final module will be located in API_stack[0].
+ *
+ * @param self
+ *   The vm that will be operated on.
+ *
+ * @param module
+ *   The name of the module to load into.
+ *   if NULL we will load into an anon module.
+ *
+ * @param bytecode
+ *   The beginning of the image.
+ *
+ * @param bytecode_size
+ *   The number of bytes in the image.
+ *
+ * @return BifrostVMError
+ *   BIFROST_VM_ERROR_MODULE_ALREADY_DEFINED - If the module has already been defined we have a problem.
+ *   BIFROST_VM_ERROR_INVALID_ARGUMENT       - The image is corrupt or was made by an incompatible version.
+ *   BIFROST_VM_ERROR_RUNTIME                - There was a runtime error somewhere along the module's execution.
+ */
+BF_VM_API BifrostVMError bfVM_moduleLoadBytecode(BifrostVM* self, const char* module, const void* bytecode, size_t bytecode_size);
+
+/*!
+ * @brief
+ *   Same as 'bfVM_moduleLoadBytecode' except the instructions, constants
+ *   and line info are used in place rather than copied, so \p bytecode can
+ *   be a read only memory mapped file shared between processes.
+ *
+ *   String constants are only created the first time they are used.
+ *
+ *   \p bytecode must stay valid and unchanged until the vm is destroyed.
+ *   It should be 8 byte aligned (any mapping or heap allocation is),
+ *   otherwise the image is copied like 'bfVM_moduleLoadBytecode' does.
+ *
+ *   The final module will be located in API_stack[0].
+ *
+ * @param self
+ *   The vm that will be operated on.
+ *
+ * @param module
+ *   The name of the module to load into.
+ *   if NULL we will load into an anon module.
+ *
+ * @param bytecode
+ *   The beginning of the image.
+ *
+ * @param bytecode_size
+ *   The number of bytes in the image.
+ *
+ * @return BifrostVMError
+ *   BIFROST_VM_ERROR_MODULE_ALREADY_DEFINED - If the module has already been defined we have a problem.
+ *   BIFROST_VM_ERROR_INVALID_ARGUMENT       - The image is corrupt or was made by an incompatible version.
+ *   BIFROST_VM_ERROR_RUNTIME                - There was a runtime error somewhere along the module's execution.
+ */
+BF_VM_API BifrostVMError bfVM_moduleMapBytecode(BifrostVM* self, const char* module, const void* bytecode, size_t bytecode_size);
+
+/*!
+ * @brief
+ *   Compiles \p source into a bytecode image without using any existing vm,
+ *   so modules can be compiled on several threads at once.
+ *
+ *   The compile happens in a private vm that shares no state with any other,
+ *   and the lexer, parser and code generator keep no mutable static state
+ *   (only constant tables) so nothing is shared between concurrent detached
+ *   compiles either.
+ *
+ *   Only std:* modules can be imported. None of the callbacks in \p params
+ *   are used except 'BifrostVMParams::memory_fn' (with 'BifrostVMParams::user_data'),
+ *   it must be safe to call from the calling thread.
+ *
+ *   The image is linked into a vm like any other, with 'bfVM_moduleLoadBytecode'
+ *   or by handing it out from a 'bfModuleFn', which also runs it.
+ *
+ * @param params
+ *   The settings that affect code generation (Ex: 'BifrostVMParams::inline_threshold')
+ *   should match the vm the image will be linked into.
+ *
+ * @param module
+ *   The name the module is compiled as, if NULL an anon module.
+ *
+ * @param source
+ *   The source code to compile.
+ *
+ * @param source_length
+ *   The length of \p source.
+ *
+ * @param write_fn
+ *   Called with each chunk of the image in order, nothing is written on an error.
+ *
+ * @param user_data
+ *   Passed through to \p write_fn.
+ *
+ * @return BifrostVMError
+ *   BIFROST_VM_ERROR_LEXER / BIFROST_VM_ERROR_COMPILE - \p source contains invalid code, the message is not kept.
+ *   BIFROST_VM_ERROR_INVALID_ARGUMENT                 - The module refers to a value that cannot be saved.
+ */
+BF_VM_API BifrostVMError bfVM_compileDetached(const BifrostVMParams* params, const char* module, const char* source, size_t source_length, bfBytecodeWriteFn write_fn, void* user_data);
+
 /*!
  * @brief
  *   Manually calls the garbage collection on the vm.
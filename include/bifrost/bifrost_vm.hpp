@@ -394,6 +394,12 @@ namespace bf
       bfVM_moduleUnload(self(), module);
     }
 
+    //! @copydoc bfVM_moduleReload
+    BifrostVMError moduleReload(const char* module, const char* source, size_t source_length) noexcept
+    {
+      return bfVM_moduleReload(self(), module, source, source_length);
+    }
+
     size_t stackSize() const noexcept
     {
       return bfVM_stackSize(self());
@@ -614,6 +620,42 @@ namespace bf
       return bfVM_execInModule(self(), module, source, source_length);
     }
 
+    //! @copydoc bfVM_compileInModule
+    BifrostVMError compileInModule(const char* module, const char* source, size_t source_length) noexcept
+    {
+      return bfVM_compileInModule(self(), module, source, source_length);
+    }
+
+    //! @copydoc bfVM_execInModuleStream
+    BifrostVMError execInModuleStream(const char* module, bfSourceReadFn read_fn, void* user_data) noexcept
+    {
+      return bfVM_execInModuleStream(self(), module, read_fn, user_data);
+    }
+
+    //! @copydoc bfVM_compileInModuleStream
+    BifrostVMError compileInModuleStream(const char* module, bfSourceReadFn read_fn, void* user_data) noexcept
+    {
+      return bfVM_compileInModuleStream(self(), module, read_fn, user_data);
+    }
+
+    //! @copydoc bfVM_moduleSaveBytecode
+    BifrostVMError moduleSaveBytecode(size_t idx, bfBytecodeWriteFn write_fn, void* user_data) noexcept
+    {
+      return bfVM_moduleSaveBytecode(self(), idx, write_fn, user_data);
+    }
+
+    //! @copydoc bfVM_moduleLoadBytecode
+    BifrostVMError moduleLoadBytecode(const char* module, const void* bytecode, size_t bytecode_size) noexcept
+    {
+      return bfVM_moduleLoadBytecode(self(), module, bytecode, bytecode_size);
+    }
+
+    //! @copydoc bfVM_moduleMapBytecode
+    BifrostVMError moduleMapBytecode(const char* module, const void* bytecode, size_t bytecode_size) noexcept
+    {
+      return bfVM_moduleMapBytecode(self(), module, bytecode, bytecode_size);
+    }
+
     //! @copydoc bfVM_gc
     void gc() noexcept
     {
@@ -0,0 +1,136 @@
+################################################################################
+#                                                                              #
+#                           BIFROST SCRIPT PROJECT                             #
+#                                                                              #
+################################################################################
+###  run_test.cmake : Runs a script through the command line interface and  ###
+###                   compares what it printed against an expected file.    ###
+################################################################################
+#
+# cmake -DCLI=<cli> -DSCRIPT=<file> -DEXPECTED=<file> -DMODE=<mode> -DWORK_DIR=<dir> [-DRELOAD_SCRIPT=<file>] -P run_test.cmake
+#
+# MODE is one of:
+#   source - Runs the script.
+#   lazy   - Runs the script with '--lazy'.
+#   stream - Runs the script with '--stream'.
+#   image  - Compiles the script with '--compile' then runs the image with '--map'.
+#   cache  - Runs the script with '--cache' three times, with an empty cache (miss),
+#            with the cache the first run filled (hit) and after every entry was
+#            overwritten with garbage (a failed load is a miss).
+#   reload - Runs the script with '--reload' against RELOAD_SCRIPT.
+#
+# Scripts are run from the directory they are in so imports are found,
+# the memory stats the command line interface prints are not compared.
+#
+
+foreach(required_var CLI SCRIPT EXPECTED MODE WORK_DIR)
+  if(NOT DEFINED ${required_var})
+    message(FATAL_ERROR "run_test.cmake: '${required_var}' was not defined.")
+  endif()
+endforeach()
+
+get_filename_component(script_dir  "${SCRIPT}" DIRECTORY)
+get_filename_component(script_name "${SCRIPT}" NAME)
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+# The command line interface waits for a key press after an error.
+set(empty_input "${WORK_DIR}/empty_input.txt")
+file(WRITE "${empty_input}" "")
+
+file(READ "${EXPECTED}" expected_output)
+string(REPLACE "\r\n" "\n" expected_output "${expected_output}")
+
+function(run_cli label)
+  execute_process(
+    COMMAND           "${CLI}" ${ARGN}
+    WORKING_DIRECTORY "${script_dir}"
+    INPUT_FILE        "${empty_input}"
+    OUTPUT_VARIABLE   output
+    ERROR_VARIABLE    output
+    RESULT_VARIABLE   result
+  )
+
+  string(REPLACE "\r\n" "\n" output "${output}")
+  string(REGEX REPLACE "Memory Stats:\n[^\n]*Peak    Usage[^\n]*\n[^\n]*Current Usage[^\n]*\n" "" output "${output}")
+  string(REGEX REPLACE "[^\n]*After    Dtor[^\n]*\n" "" output "${output}")
+
+  if(NOT output STREQUAL expected_output)
+    file(WRITE "${WORK_DIR}/${label}.actual" "${output}")
+    message(FATAL_ERROR
+      "${script_name} (${label}): output does not match '${EXPECTED}', exit code ${result}.\n"
+      "Got (also written to '${WORK_DIR}/${label}.actual'):\n${output}")
+  endif()
+endfunction()
+
+if(MODE STREQUAL "source")
+  run_cli(source "${script_name}")
+elseif(MODE STREQUAL "lazy")
+  run_cli(lazy --lazy "${script_name}")
+elseif(MODE STREQUAL "stream")
+  run_cli(stream --stream "${script_name}")
+elseif(MODE STREQUAL "image")
+  set(image_file "${WORK_DIR}/${script_name}.bsc")
+
+  execute_process(
+    COMMAND           "${CLI}" --compile "${script_name}" "${image_file}"
+    WORKING_DIRECTORY "${script_dir}"
+    INPUT_FILE        "${empty_input}"
+    OUTPUT_VARIABLE   compile_output
+    ERROR_VARIABLE    compile_output
+    RESULT_VARIABLE   compile_result
+  )
+
+  if(NOT compile_result EQUAL 0 OR NOT EXISTS "${image_file}")
+    message(FATAL_ERROR "${script_name} (image): '--compile' failed with exit code ${compile_result}:\n${compile_output}")
+  endif()
+
+  run_cli(image --map "${image_file}")
+elseif(MODE STREQUAL "cache")
+  set(cache_dir "${WORK_DIR}/cache")
+  file(MAKE_DIRECTORY "${cache_dir}")
+
+  run_cli(cache_miss --cache "${cache_dir}" "${script_name}")
+
+  file(GLOB cache_entries "${cache_dir}/*.bsc")
+
+  if(NOT cache_entries)
+    message(FATAL_ERROR "${script_name} (cache): nothing was stored in '${cache_dir}'.")
+  endif()
+
+  set(stored_hashes "")
+  foreach(entry ${cache_entries})
+    file(SHA256 "${entry}" entry_hash)
+    list(APPEND stored_hashes "${entry_hash}")
+  endforeach()
+
+  run_cli(cache_hit --cache "${cache_dir}" "${script_name}")
+
+  foreach(entry ${cache_entries})
+    file(WRITE "${entry}" "This is not a bytecode image, it must be treated as a cache miss and replaced.\n")
+  endforeach()
+
+  run_cli(cache_corrupt --cache "${cache_dir}" "${script_name}")
+
+  # A miss stores the image again, compiling the same source must give the same bytes.
+  set(restored_hashes "")
+  foreach(entry ${cache_entries})
+    file(SHA256 "${entry}" entry_hash)
+    list(APPEND restored_hashes "${entry_hash}")
+  endforeach()
+
+  if(NOT restored_hashes STREQUAL stored_hashes)
+    message(FATAL_ERROR "${script_name} (cache): the corrupt entries were not replaced with a fresh image.")
+  endif()
+elseif(MODE STREQUAL "reload")
+  if(NOT DEFINED RELOAD_SCRIPT)
+    message(FATAL_ERROR "run_test.cmake: 'RELOAD_SCRIPT' must be defined for the 'reload' mode.")
+  endif()
+
+  get_filename_component(reload_script_name "${RELOAD_SCRIPT}" NAME)
+
+  run_cli(reload --reload "${script_name}" "${reload_script_name}")
+else()
+  message(FATAL_ERROR "run_test.cmake: unknown MODE '${MODE}'.")
+endif()
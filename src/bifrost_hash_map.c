@@ -111,6 +111,13 @@ void bfHashMap_set(BifrostHashMap* self, const void* key, void* value)
   }
 }
 
+void bfHashMap_insertNew(BifrostHashMap* self, const void* key, unsigned hash, void* value)
+{
+  hash %= self->num_buckets;
+
+  self->buckets[hash] = bfHashMap_newNode(self->params.vm, key, self->params.value_size, value, self->buckets[hash]);
+}
+
 static int bfHashMap_has(const BifrostHashMap* self, const void* key)
 {
   const unsigned hash = self->params.hash(key) % self->num_buckets;
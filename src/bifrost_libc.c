@@ -1,9 +1,10 @@
 #include "bifrost_libc.h"
 
 #include <ctype.h>  /* isalpha, isdigit, isspace */
+#include <float.h>  /* DBL_MAX */
 #include <stdarg.h> /* va_list, va_start, va_copy, va_end */
 #include <stdio.h>  /* fprintf, stderr, fflush, vsnprintf,  */
-#include <stdlib.h> /* abort, strtod */
+#include <stdlib.h> /* abort, strtod, malloc, free */
 #include <string.h> /* memcpy, memmove, memset, strncmp */
 
 void(LibC_assert)(const char* const msg, const char* const condition_str, const char* const file, const int line, const char* const func)
@@ -53,3 +54,837 @@ void bfVMString_sprintf(BifrostVM* vm, BifrostString* self, const char* format,
 
   va_end(args);
 }
+
+/*
+  NOTE(SR):
+    Number parsing that only ever reads from [bgn, end) and does not depend on the
+    current locale, the source buffer given to the lexer is not required to be
+    nul terminated at 'source_end'.
+
+    Most literals have at most 19 significant digits and a small exponent, these are
+    computed exactly using Clinger's fast path ('mantissa' and '10^exponent' are both
+    exact doubles so the single multiply / divide is correctly rounded).
+    Anything else goes through 'bfVM_parseNumberSlow' which is also correctly rounded.
+*/
+
+static const double k_ExactPowersOf10[] =
+ {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+#define BF_PARSE_NUMBER_MAX_EXACT_MANTISSA      ((uint64_t)1 << 53)
+#define BF_PARSE_NUMBER_MAX_DIGITS              19
+#define BF_PARSE_NUMBER_MAX_BIG_DIGITS          768 /* A halfway point between two doubles has at most 767 significant digits. */
+#define BF_PARSE_NUMBER_BIG_NUM_LIMBS           128 /* Both sides of a comparison stay below 3700 bits.                         */
+#define BF_NUMBER_TO_STRING_MAX_FRACTION_DIGITS 15
+#define BF_NUMBER_TO_STRING_MAX_DIGITS          17  /* Enough to round trip any double.                                         */
+#define BF_DOUBLE_FRACTION_MASK                 (((uint64_t)1 << 52) - 1u)
+#define BF_DOUBLE_INFINITY_BITS                 ((uint64_t)0x7FF << 52)
+
+static bool bfVM_parseNumberIsDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+static int bfVM_parseNumberHexDigit(char c)
+{
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+static uint64_t bfVM_doubleToBits(double value)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static double bfVM_doubleFromBits(uint64_t bits)
+{
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/* Correctly rounded (to nearest even) 'mantissa * 2^exponent', [is_sticky] means there were more non zero bits below [mantissa]. */
+static double bfVM_parseNumberFromBinary(uint64_t mantissa, int exponent, bool is_sticky)
+{
+  if (mantissa == 0)
+  {
+    return 0.0;
+  }
+
+  while (!(mantissa >> 63))
+  {
+    mantissa <<= 1;
+    --exponent;
+  }
+
+  /* NOTE(SR): The value is now in [2^(exponent + 63), 2^(exponent + 64)), 53 bits are kept or fewer for a subnormal. */
+  const int binary_exponent = exponent + 63;
+
+  if (binary_exponent > 1023)
+  {
+    return bfVM_doubleFromBits(BF_DOUBLE_INFINITY_BITS);
+  }
+
+  const int num_dropped = binary_exponent < -1022 ? 11 + (-1022 - binary_exponent) : 11;
+
+  if (num_dropped > 64)
+  {
+    return 0.0;
+  }
+
+  const uint64_t kept      = num_dropped == 64 ? 0u : mantissa >> num_dropped;
+  const uint64_t remainder = num_dropped == 64 ? mantissa : mantissa & (((uint64_t)1 << num_dropped) - 1u);
+  const uint64_t half      = (uint64_t)1 << (num_dropped - 1);
+  const bool     round_up  = remainder > half || (remainder == half && (is_sticky || (kept & 1u)));
+
+  /* NOTE(SR): The hidden bit of [kept] lands in the exponent field, a carry out of the fraction bumps the exponent as it should. */
+  const uint64_t exponent_field = binary_exponent < -1022 ? 0u : (uint64_t)(binary_exponent + 1022) << 52;
+  const uint64_t bits           = exponent_field + kept + round_up;
+
+  return bfVM_doubleFromBits(bits >= BF_DOUBLE_INFINITY_BITS ? BF_DOUBLE_INFINITY_BITS : bits);
+}
+
+/*
+  NOTE(SR):
+    '0x' followed by hex digits, optionally a fraction and a 'p' binary exponent.
+    At most 16 significant hex digits are kept, the rest only matter as sticky bits.
+*/
+static double bfVM_parseNumberHex(const char* p, const char* end, const char** out_end)
+{
+  uint64_t mantissa   = 0;
+  int      num_digits = 0;
+  int      exponent   = 0;
+  bool     is_sticky  = false;
+  bool     is_frac    = false;
+  int      digit;
+
+  for (; p < end; ++p)
+  {
+    if (*p == '.' && !is_frac)
+    {
+      is_frac = true;
+      continue;
+    }
+
+    if ((digit = bfVM_parseNumberHexDigit(*p)) < 0)
+    {
+      break;
+    }
+
+    if (num_digits == 0 && digit == 0)
+    {
+      exponent -= is_frac ? 4 : 0;
+    }
+    else if (num_digits < 16)
+    {
+      mantissa = mantissa * 16u + (uint64_t)digit;
+      ++num_digits;
+      exponent -= is_frac ? 4 : 0;
+    }
+    else
+    {
+      is_sticky |= digit != 0;
+      exponent += is_frac ? 0 : 4;
+    }
+  }
+
+  if (p < end && (*p == 'p' || *p == 'P'))
+  {
+    const char* exp_p           = p + 1;
+    bool        is_exp_negative = false;
+
+    if (exp_p < end && (*exp_p == '-' || *exp_p == '+'))
+    {
+      is_exp_negative = *exp_p == '-';
+      ++exp_p;
+    }
+
+    if (exp_p < end && bfVM_parseNumberIsDigit(*exp_p))
+    {
+      int exp_value = 0;
+
+      while (exp_p < end && bfVM_parseNumberIsDigit(*exp_p))
+      {
+        if (exp_value < 100000)
+        {
+          exp_value = exp_value * 10 + (*exp_p - '0');
+        }
+
+        ++exp_p;
+      }
+
+      exponent += is_exp_negative ? -exp_value : exp_value;
+      p = exp_p;
+    }
+  }
+
+  *out_end = p;
+  return bfVM_parseNumberFromBinary(mantissa, exponent, is_sticky);
+}
+
+/* Just enough of an arbitrary precision unsigned integer to compare a decimal number against a double exactly. */
+typedef struct bfBigNum
+{
+  uint32_t limbs[BF_PARSE_NUMBER_BIG_NUM_LIMBS]; /*!< Least significant first. */
+  int      size;
+
+} bfBigNum;
+
+static void bfBigNum_init(bfBigNum* self, uint64_t value)
+{
+  self->size = 0;
+
+  while (value)
+  {
+    self->limbs[self->size++] = (uint32_t)value;
+    value >>= 32;
+  }
+}
+
+static void bfBigNum_mulAdd(bfBigNum* self, uint32_t mul, uint32_t add)
+{
+  uint64_t carry = add;
+
+  for (int i = 0; i < self->size; ++i)
+  {
+    const uint64_t product = (uint64_t)self->limbs[i] * mul + carry;
+
+    self->limbs[i] = (uint32_t)product;
+    carry          = product >> 32;
+  }
+
+  if (carry && self->size < BF_PARSE_NUMBER_BIG_NUM_LIMBS)
+  {
+    self->limbs[self->size++] = (uint32_t)carry;
+  }
+}
+
+static void bfBigNum_mulPow5(bfBigNum* self, int power)
+{
+  /* NOTE(SR): 5^13 is the largest power of five that fits in a limb. */
+  for (; power >= 13; power -= 13)
+  {
+    bfBigNum_mulAdd(self, 1220703125u, 0u);
+  }
+
+  uint32_t remaining = 1u;
+
+  while (power--)
+  {
+    remaining *= 5u;
+  }
+
+  bfBigNum_mulAdd(self, remaining, 0u);
+}
+
+static void bfBigNum_shiftLeft(bfBigNum* self, int num_bits)
+{
+  const int num_limbs = num_bits / 32;
+  const int bit_shift = num_bits % 32;
+
+  if (self->size == 0 || self->size + num_limbs + 1 > BF_PARSE_NUMBER_BIG_NUM_LIMBS)
+  {
+    return;
+  }
+
+  self->limbs[self->size] = 0u;
+
+  for (int i = self->size; i >= 0; --i)
+  {
+    const uint32_t high = self->limbs[i] << bit_shift;
+    const uint32_t low  = (i > 0 && bit_shift) ? self->limbs[i - 1] >> (32 - bit_shift) : 0u;
+
+    self->limbs[i + num_limbs] = high | low;
+  }
+
+  memset(self->limbs, 0x0, sizeof(uint32_t) * num_limbs);
+
+  self->size += num_limbs + 1;
+
+  while (self->size && !self->limbs[self->size - 1])
+  {
+    --self->size;
+  }
+}
+
+static int bfBigNum_cmp(const bfBigNum* lhs, const bfBigNum* rhs)
+{
+  if (lhs->size != rhs->size)
+  {
+    return lhs->size < rhs->size ? -1 : 1;
+  }
+
+  for (int i = lhs->size - 1; i >= 0; --i)
+  {
+    if (lhs->limbs[i] != rhs->limbs[i])
+    {
+      return lhs->limbs[i] < rhs->limbs[i] ? -1 : 1;
+    }
+  }
+
+  return 0;
+}
+
+/* Compares 'digits * 10^exp10' against 'halfway * 2^exp2'. */
+static int bfVM_parseNumberCompare(const bfBigNum* digits, int exp10, uint64_t halfway, int exp2)
+{
+  bfBigNum lhs = *digits;
+  bfBigNum rhs;
+
+  bfBigNum_init(&rhs, halfway);
+
+  /* NOTE(SR): 10^exp10 is split into 5^exp10 for whichever side keeps it an integer and 2^exp10 which joins [exp2]. */
+  if (exp10 >= 0)
+  {
+    bfBigNum_mulPow5(&lhs, exp10);
+  }
+  else
+  {
+    bfBigNum_mulPow5(&rhs, -exp10);
+  }
+
+  exp2 -= exp10;
+
+  if (exp2 >= 0)
+  {
+    bfBigNum_shiftLeft(&rhs, exp2);
+  }
+  else
+  {
+    bfBigNum_shiftLeft(&lhs, -exp2);
+  }
+
+  return bfBigNum_cmp(&lhs, &rhs);
+}
+
+/* 'value * 10^exponent' with a few rounding errors, only used as the starting guess. */
+static double bfVM_parseNumberEstimate(double value, int exponent)
+{
+  for (; exponent > 22; exponent -= 22)
+  {
+    value *= 1e22;
+  }
+
+  for (; exponent < -22; exponent += 22)
+  {
+    value /= 1e22;
+  }
+
+  return exponent < 0 ? value / k_ExactPowersOf10[-exponent] : value * k_ExactPowersOf10[exponent];
+}
+
+/*
+  NOTE(SR):
+    Correctly rounded decimal for when the fast path can not be exact.
+
+    The digits become a big integer 'D' (at most 'BF_PARSE_NUMBER_MAX_BIG_DIGITS', a trailing
+    non zero digit stands in for any that were cut off) so the number is exactly 'D * 10^E'.
+    Starting from an estimate a few ulps off, the guess moves towards the number until it
+    sits between the halfway points to both of its neighbours, each step compares
+    against a halfway point exactly with big integers (Clinger's AlgorithmR).
+*/
+static double bfVM_parseNumberSlow(const char* p, const char* mantissa_end, int exponent)
+{
+  bfBigNum digits;
+  uint64_t estimate_mantissa = 0;
+  int      num_digits        = 0;
+  bool     is_frac           = false;
+  bool     is_truncated      = false;
+
+  bfBigNum_init(&digits, 0u);
+
+  for (; p < mantissa_end; ++p)
+  {
+    if (*p == '.')
+    {
+      is_frac = true;
+      continue;
+    }
+
+    const uint32_t digit = (uint32_t)(*p - '0');
+
+    if (num_digits == 0 && digit == 0)
+    {
+      exponent -= is_frac;
+    }
+    else if (num_digits < BF_PARSE_NUMBER_MAX_BIG_DIGITS)
+    {
+      bfBigNum_mulAdd(&digits, 10u, digit);
+      estimate_mantissa = num_digits < BF_PARSE_NUMBER_MAX_DIGITS ? estimate_mantissa * 10u + digit : estimate_mantissa;
+      ++num_digits;
+      exponent -= is_frac;
+    }
+    else
+    {
+      is_truncated |= digit != 0;
+      exponent += !is_frac;
+    }
+  }
+
+  if (num_digits == 0)
+  {
+    return 0.0;
+  }
+
+  if (is_truncated)
+  {
+    bfBigNum_mulAdd(&digits, 10u, 1u);
+    --exponent;
+    ++num_digits;
+  }
+
+  /* NOTE(SR): The number is in [10^(num_digits + exponent - 1), 10^(num_digits + exponent)). */
+  if (num_digits + exponent > 310)
+  {
+    return bfVM_doubleFromBits(BF_DOUBLE_INFINITY_BITS);
+  }
+
+  if (num_digits + exponent < -324)
+  {
+    return 0.0;
+  }
+
+  const int num_estimate_digits = num_digits < BF_PARSE_NUMBER_MAX_DIGITS ? num_digits : BF_PARSE_NUMBER_MAX_DIGITS;
+  uint64_t  guess               = bfVM_doubleToBits(bfVM_parseNumberEstimate((double)estimate_mantissa, exponent + (num_digits - num_estimate_digits)));
+
+  if (guess == 0u)
+  {
+    guess = 1u;
+  }
+  else if (guess >= BF_DOUBLE_INFINITY_BITS)
+  {
+    guess = BF_DOUBLE_INFINITY_BITS - 1u;
+  }
+
+  /* NOTE(SR): Consecutive positive doubles have consecutive bit patterns. */
+  for (;;)
+  {
+    const uint64_t exponent_field = guess >> 52;
+    const uint64_t mantissa       = exponent_field ? (guess & BF_DOUBLE_FRACTION_MASK) | ((uint64_t)1 << 52) : guess;
+    const int      exp2           = exponent_field ? (int)exponent_field - 1075 : -1074;
+    const int      cmp_above      = bfVM_parseNumberCompare(&digits, exponent, mantissa * 2u + 1u, exp2 - 1);
+
+    if (cmp_above > 0 || (cmp_above == 0 && (mantissa & 1u)))
+    {
+      ++guess;
+
+      if (guess >= BF_DOUBLE_INFINITY_BITS || cmp_above == 0)
+      {
+        break;
+      }
+
+      continue;
+    }
+
+    /* NOTE(SR): Right above a power of two the gap below is half the size of the one above. */
+    const bool is_narrow_below = mantissa == ((uint64_t)1 << 52) && exponent_field > 1u;
+    const int  cmp_below       = is_narrow_below ? bfVM_parseNumberCompare(&digits, exponent, mantissa * 4u - 1u, exp2 - 2) :
+                                                   bfVM_parseNumberCompare(&digits, exponent, mantissa * 2u - 1u, exp2 - 1);
+
+    if (cmp_below < 0 || (cmp_below == 0 && (mantissa & 1u)))
+    {
+      --guess;
+
+      if (guess == 0u || cmp_below == 0)
+      {
+        break;
+      }
+
+      continue;
+    }
+
+    break;
+  }
+
+  return bfVM_doubleFromBits(guess);
+}
+
+double bfVM_parseNumber(const char* bgn, const char* end, const char** out_end)
+{
+  const char* p           = bgn;
+  bool        is_negative = false;
+
+  if (p < end && (*p == '-' || *p == '+'))
+  {
+    is_negative = *p == '-';
+    ++p;
+  }
+
+  /* Hexadecimal */
+
+  if (end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X') && bfVM_parseNumberHexDigit(p[2]) >= 0)
+  {
+    const double value = bfVM_parseNumberHex(p + 2, end, out_end);
+
+    return is_negative ? -value : value;
+  }
+
+  /* Decimal */
+
+  const char* const digits_bgn   = p;
+  uint64_t          mantissa     = 0;
+  int               num_digits   = 0; /* Significant digits stored in 'mantissa'. */
+  int               exponent     = 0; /* Decimal exponent applied to 'mantissa'.  */
+  bool              is_truncated = false;
+  bool              has_digits   = false;
+
+  while (p < end && *p == '0')
+  {
+    has_digits = true;
+    ++p;
+  }
+
+  while (p < end && bfVM_parseNumberIsDigit(*p))
+  {
+    if (num_digits < BF_PARSE_NUMBER_MAX_DIGITS)
+    {
+      mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+      ++num_digits;
+    }
+    else
+    {
+      is_truncated |= *p != '0';
+      ++exponent;
+    }
+
+    has_digits = true;
+    ++p;
+  }
+
+  if (p < end && *p == '.')
+  {
+    ++p;
+
+    if (num_digits == 0)
+    {
+      while (p < end && *p == '0')
+      {
+        has_digits = true;
+        --exponent;
+        ++p;
+      }
+    }
+
+    while (p < end && bfVM_parseNumberIsDigit(*p))
+    {
+      if (num_digits < BF_PARSE_NUMBER_MAX_DIGITS)
+      {
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        ++num_digits;
+        --exponent;
+      }
+      else
+      {
+        is_truncated |= *p != '0';
+      }
+
+      has_digits = true;
+      ++p;
+    }
+  }
+
+  if (!has_digits)
+  {
+    *out_end = bgn;
+    return 0.0;
+  }
+
+  const char* const mantissa_end = p;
+  int               exp_value    = 0;
+
+  if (p < end && (*p == 'e' || *p == 'E'))
+  {
+    const char* exp_p           = p + 1;
+    bool        is_exp_negative = false;
+
+    if (exp_p < end && (*exp_p == '-' || *exp_p == '+'))
+    {
+      is_exp_negative = *exp_p == '-';
+      ++exp_p;
+    }
+
+    /* NOTE(SR): Like 'strtod' an 'e' not followed by digits is not part of the number. */
+    if (exp_p < end && bfVM_parseNumberIsDigit(*exp_p))
+    {
+      while (exp_p < end && bfVM_parseNumberIsDigit(*exp_p))
+      {
+        if (exp_value < 100000)
+        {
+          exp_value = exp_value * 10 + (*exp_p - '0');
+        }
+
+        ++exp_p;
+      }
+
+      exp_value = is_exp_negative ? -exp_value : exp_value;
+      exponent += exp_value;
+      p = exp_p;
+    }
+  }
+
+  *out_end = p;
+
+  if (mantissa == 0 && !is_truncated)
+  {
+    return is_negative ? -0.0 : 0.0;
+  }
+
+  double value;
+
+  if (!is_truncated && mantissa <= BF_PARSE_NUMBER_MAX_EXACT_MANTISSA && exponent >= -22 && exponent <= 22)
+  {
+    value = (double)mantissa;
+
+    if (exponent < 0)
+    {
+      value /= k_ExactPowersOf10[-exponent];
+    }
+    else
+    {
+      value *= k_ExactPowersOf10[exponent];
+    }
+  }
+  else
+  {
+    value = bfVM_parseNumberSlow(digits_bgn, mantissa_end, exp_value);
+  }
+
+  return is_negative ? -value : value;
+}
+
+/*
+  NOTE(SR):
+    Writes the shortest string that parses back to exactly [value],
+    the return value and truncation follow 'snprintf'.
+
+    Integers (the common case for counters and HUD text) never touch 'snprintf'.
+    Numbers with a short decimal expansion ("12.5", "0.1") are found by
+    looking for the smallest 'k' where 'round(value * 10^k) / 10^k == value',
+    that division is the same exact operation 'bfVM_parseNumber' does on the
+    output so the result is guaranteed to round trip.
+    Everything else takes the digits of the shortest "%.*e" precision that round trips.
+*/
+static size_t bfVM_numberToStringFinish(const char* str, size_t length, char* buffer, size_t buffer_size)
+{
+  if (buffer_size)
+  {
+    const size_t num_to_copy = length < buffer_size ? length : buffer_size - 1;
+
+    memcpy(buffer, str, num_to_copy);
+    buffer[num_to_copy] = '\0';
+  }
+
+  return length;
+}
+
+static char* bfVM_numberToStringDigits(uint64_t value, char* buffer_end, int min_digits)
+{
+  do
+  {
+    *--buffer_end = (char)('0' + value % 10);
+    value /= 10;
+    --min_digits;
+  } while (value || min_digits > 0);
+
+  return buffer_end;
+}
+
+size_t bfVM_numberToString(double value, char* buffer, size_t buffer_size)
+{
+  char         temp[40];
+  char* const  temp_end    = temp + sizeof(temp);
+  const bool   is_negative = value < 0.0;
+  const double abs_value   = is_negative ? -value : value;
+
+  /* Integral Fast Path */
+
+  if (abs_value < (double)BF_PARSE_NUMBER_MAX_EXACT_MANTISSA && abs_value == (double)(uint64_t)abs_value)
+  {
+    char* str = bfVM_numberToStringDigits((uint64_t)abs_value, temp_end, 1);
+
+    if (is_negative && abs_value != 0.0)
+    {
+      *--str = '-';
+    }
+
+    return bfVM_numberToStringFinish(str, temp_end - str, buffer, buffer_size);
+  }
+
+  /* Short Decimal Expansion */
+
+  if (abs_value >= 1e-4 && abs_value < (double)BF_PARSE_NUMBER_MAX_EXACT_MANTISSA)
+  {
+    for (int k = 1; k <= BF_NUMBER_TO_STRING_MAX_FRACTION_DIGITS; ++k)
+    {
+      const double scaled = abs_value * k_ExactPowersOf10[k];
+
+      if (scaled >= (double)BF_PARSE_NUMBER_MAX_EXACT_MANTISSA)
+      {
+        break;
+      }
+
+      const uint64_t mantissa = (uint64_t)(scaled + 0.5);
+
+      if ((double)mantissa / k_ExactPowersOf10[k] == abs_value)
+      {
+        char* str = bfVM_numberToStringDigits(mantissa, temp_end, k + 1);
+
+        /* Shift the integer part over to make room for the '.' */
+        const size_t num_integer_digits = (temp_end - str) - k;
+
+        memmove(str - 1, str, num_integer_digits);
+        --str;
+        str[num_integer_digits] = '.';
+
+        if (is_negative)
+        {
+          *--str = '-';
+        }
+
+        return bfVM_numberToStringFinish(str, temp_end - str, buffer, buffer_size);
+      }
+    }
+  }
+
+  /* General Case */
+
+  if (value != value)
+  {
+    return bfVM_numberToStringFinish("nan", 3, buffer, buffer_size);
+  }
+
+  if (abs_value > DBL_MAX)
+  {
+    return is_negative ? bfVM_numberToStringFinish("-inf", 4, buffer, buffer_size) :
+                         bfVM_numberToStringFinish("inf", 3, buffer, buffer_size);
+  }
+
+  /*
+    NOTE(SR):
+      "%.*e" gives correctly rounded digits, the first precision that round trips is the shortest.
+      Only the digits and exponent are taken from it so the locale's radix character never leaks out.
+  */
+  char digits[BF_NUMBER_TO_STRING_MAX_DIGITS + 8];
+  int  num_digits = 0;
+  int  exponent   = 0;
+  int  precision  = 1;
+
+  for (; precision <= BF_NUMBER_TO_STRING_MAX_DIGITS; ++precision)
+  {
+    const int length = snprintf(temp, sizeof(temp), "%.*e", precision - 1, abs_value);
+
+    if (length < 0 || length >= (int)sizeof(temp))
+    {
+      return bfVM_numberToStringFinish("", 0, buffer, buffer_size);
+    }
+
+    const char* p = temp;
+
+    num_digits = 0;
+
+    for (; *p && *p != 'e'; ++p)
+    {
+      if (bfVM_parseNumberIsDigit(*p))
+      {
+        digits[num_digits++] = *p;
+      }
+    }
+
+    const bool is_exp_negative = p[1] == '-';
+
+    exponent = 0;
+
+    for (p += 2; bfVM_parseNumberIsDigit(*p); ++p)
+    {
+      exponent = exponent * 10 + (*p - '0');
+    }
+
+    exponent = is_exp_negative ? -exponent : exponent;
+
+    /* NOTE(SR): The round trip check sees the digits as an integer, 'exponent' is for the first digit. */
+    const char* parsed_end;
+    int         digits_end = num_digits;
+
+    digits[digits_end++] = 'e';
+    digits_end += snprintf(digits + digits_end, sizeof(digits) - digits_end, "%d", exponent - (num_digits - 1));
+
+    if (bfVM_parseNumber(digits, digits + digits_end, &parsed_end) == abs_value)
+    {
+      break;
+    }
+  }
+
+  while (num_digits > 1 && digits[num_digits - 1] == '0')
+  {
+    --num_digits;
+  }
+
+  /* NOTE(SR): Same layout the "%.15g" this replaced would have picked, scientific notation only for very small or large exponents. */
+  const int max_fixed_exponent = precision < 15 ? 15 : precision;
+  char*     str                = temp;
+
+  if (is_negative)
+  {
+    *str++ = '-';
+  }
+
+  if (exponent < -4 || exponent >= max_fixed_exponent)
+  {
+    *str++ = digits[0];
+
+    if (num_digits > 1)
+    {
+      *str++ = '.';
+      memcpy(str, digits + 1, num_digits - 1);
+      str += num_digits - 1;
+    }
+
+    *str++ = 'e';
+    *str++ = exponent < 0 ? '-' : '+';
+
+    char exponent_digits[8];
+    char* const exponent_end = exponent_digits + sizeof(exponent_digits);
+    char* const exponent_bgn = bfVM_numberToStringDigits((uint64_t)(exponent < 0 ? -exponent : exponent), exponent_end, 2);
+
+    memcpy(str, exponent_bgn, exponent_end - exponent_bgn);
+    str += exponent_end - exponent_bgn;
+  }
+  else if (exponent < 0)
+  {
+    *str++ = '0';
+    *str++ = '.';
+    memset(str, '0', -exponent - 1);
+    str += -exponent - 1;
+    memcpy(str, digits, num_digits);
+    str += num_digits;
+  }
+  else
+  {
+    for (int i = 0; i <= exponent || i < num_digits; ++i)
+    {
+      if (i == exponent + 1)
+      {
+        *str++ = '.';
+      }
+
+      *str++ = i < num_digits ? digits[i] : '0';
+    }
+  }
+
+  return bfVM_numberToStringFinish(temp, str - temp, buffer, buffer_size);
+}
+
+#undef BF_PARSE_NUMBER_MAX_EXACT_MANTISSA
+#undef BF_PARSE_NUMBER_MAX_DIGITS
+#undef BF_PARSE_NUMBER_MAX_BIG_DIGITS
+#undef BF_PARSE_NUMBER_BIG_NUM_LIMBS
+#undef BF_NUMBER_TO_STRING_MAX_DIGITS
+#undef BF_DOUBLE_FRACTION_MASK
+#undef BF_DOUBLE_INFINITY_BITS
+#undef BF_NUMBER_TO_STRING_MAX_FRACTION_DIGITS
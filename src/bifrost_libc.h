@@ -45,6 +45,8 @@ int  LibC_strcmp(const char* const lhs, const char* const rhs);
 typedef char*            BifrostString;
 typedef struct BifrostVM BifrostVM;
 
-void bfVMString_sprintf(BifrostVM* vm, BifrostString* self, const char* format, ...);
+void   bfVMString_sprintf(BifrostVM* vm, BifrostString* self, const char* format, ...);
+double bfVM_parseNumber(const char* bgn, const char* end, const char** out_end);
+size_t bfVM_numberToString(double value, char* buffer, size_t buffer_size);
 
 #endif /* BIFROST_LIBC_H */
@@ -16,6 +16,7 @@
 /******************************************************************************/
 #include "bifrost/bifrost_vm.h"
 
+#include "bifrost_vm_bytecode.h"
 #include "bifrost_vm_debug.h"
 #include "bifrost_vm_gc.h"
 #include "bifrost_vm_lexer.h"
@@ -26,6 +27,9 @@ BifrostObjModule*     bfVM_findModule(BifrostVM* self, const char* name, size_t
 uint32_t              bfVM_getSymbol(BifrostVM* self, string_range name);
 static BifrostVMError bfVM_runModule(BifrostVM* self, BifrostObjModule* module);
 static BifrostVMError bfVM_compileIntoModule(BifrostVM* self, BifrostObjModule* module, const char* source, size_t source_len);
+static BifrostVMError bfVM__compileSource(BifrostVM* self, BifrostObjModule* module, const char* source, size_t source_len);
+static BifrostVMError bfVM__compileStream(BifrostVM* self, BifrostObjModule* module, bfSourceReadFn read_fn, void* user_data);
+BifrostVMError        bfVM_compileLazyFunction(BifrostVM* self, BifrostObjFn* fn);
 
 struct bfValueHandleImpl
 {
@@ -72,6 +76,11 @@ void bfVMParams_initDefault(BifrostVMParams* self)
   self->heap_size          = 5242880;               /* 5mb                                                                    */
   self->heap_growth_factor = 0.5f;                  /* Grow by x1.5                                                           */
   self->user_data          = NULL;                  /* User data for the memory allocator, and maybe other future things.     */
+  self->inline_threshold   = 0;                     /* Inlining of small functions is opt-in.                                 */
+  self->lazy_compile       = false;                 /* Every function body is compiled up front.                              */
+  self->strip_debug_info   = false;                 /* Functions keep a line table for errors and stack traces.               */
+  self->cache_lookup_fn    = NULL;                  /* Modules are always compiled from source.                               */
+  self->cache_store_fn     = NULL;                  /* Nothing is handed to a compile cache.                                  */
 }
 
 static inline void bfVM_assertStackIndex(const BifrostVM* const self, const size_t idx)
@@ -113,6 +122,7 @@ void bfVM_ctor(BifrostVM* self, const BifrostVMParams* params)
   self->gc_roots          = NULL;
   self->finalized         = NULL;
   self->current_native_fn = NULL;
+  self->class_version     = 0u;
 
   /*
     NOTE(Shareef):
@@ -212,6 +222,33 @@ static void bfVM_moduleLoadStdIOPrint(BifrostVM* vm, const int32_t num_args)
   }
 }
 
+/*
+  NOTE(SR):
+    'toNumber(str)' returns the number the whole string spells out
+    or nil when it is not a (complete) number.
+*/
+static void bfVM_moduleLoadStdStringToNumber(BifrostVM* vm, const int32_t num_args)
+{
+  const BifrostValue value = vm->stack_top[0];
+
+  if (num_args == 1 && bfVMValue_isPointer(value) && ((BifrostObj*)bfVMValue_asPointer(value))->type == BIFROST_VM_OBJ_STRING)
+  {
+    const BifrostObjStr* const str     = (const BifrostObjStr*)bfVMValue_asPointer(value);
+    const char* const          str_bgn = str->value;
+    const char* const          str_end = str_bgn + bfVMString_length(str->value);
+    const char*                num_end;
+    const double               number = bfVM_parseNumber(str_bgn, str_end, &num_end);
+
+    if (num_end != str_bgn && num_end == str_end)
+    {
+      vm->stack_top[0] = bfVMValue_fromNumber(number);
+      return;
+    }
+  }
+
+  vm->stack_top[0] = bfVMValue_fromNull();
+}
+
 void bfVM_moduleLoadStd(BifrostVM* self, size_t idx, uint32_t module_flags)
 {
   if (module_flags & BIFROST_VM_STD_MODULE_IO)
@@ -221,6 +258,14 @@ void bfVM_moduleLoadStd(BifrostVM* self, size_t idx, uint32_t module_flags)
       bfVM_stackStoreNativeFn(self, idx, "print", &bfVM_moduleLoadStdIOPrint, -1);
     }
   }
+
+  if (module_flags & BIFROST_VM_STD_MODULE_STRING)
+  {
+    if (bfVM_moduleMake(self, idx, "std:string") == BIFROST_VM_ERROR_NONE)
+    {
+      bfVM_stackStoreNativeFn(self, idx, "toNumber", &bfVM_moduleLoadStdStringToNumber, 1);
+    }
+  }
 }
 
 BifrostVMError bfVM_moduleLoad(BifrostVM* self, size_t idx, const char* module, const size_t module_name_len)
@@ -276,6 +321,310 @@ void bfVM_moduleUnloadAll(BifrostVM* self)
   bfHashMap_clear(&self->modules);
 }
 
+/* NOTE(SR): Maps an object from the freshly compiled module to the live object it was patched into. */
+static unsigned ReloadMap_hash(const void* key)
+{
+  return (unsigned)((uintptr_t)key >> 3u);
+}
+
+static int ReloadMap_cmp(const void* lhs, const void* rhs)
+{
+  return lhs == rhs;
+}
+
+static BifrostValue bfVM__reloadRemap(BifrostHashMap* remap, BifrostValue value)
+{
+  if (bfVMValue_isPointer(value))
+  {
+    BifrostObj** const patched = bfHashMap_get(remap, BIFROST_AS_OBJ(value));
+
+    if (patched)
+    {
+      return bfVMValue_fromPointer(*patched);
+    }
+  }
+
+  return value;
+}
+
+static void bfVM__reloadRemapValues(BifrostHashMap* remap, BifrostValue* values, size_t num_values)
+{
+  for (size_t i = 0; i < num_values; ++i)
+  {
+    values[i] = bfVM__reloadRemap(remap, values[i]);
+  }
+}
+
+static void bfVM__reloadRemapFn(BifrostHashMap* remap, BifrostObjFn* fn)
+{
+  /* NOTE(SR): The constants of an image function are read only, its objects live on the side. */
+  if (fn->image)
+  {
+    bfVM__reloadRemapValues(remap, fn->image_objects, bfVMArray_size(&fn->image_objects));
+  }
+  else if (!fn->lazy_source)
+  {
+    bfVM__reloadRemapValues(remap, fn->constants, fn->num_constants);
+  }
+}
+
+static bool bfVM__isObjOfType(BifrostValue value, BifrostObjType type)
+{
+  return bfVMValue_isPointer(value) && BIFROST_AS_OBJ(value)->type == type;
+}
+
+static bool bfVM__isFnOf(BifrostValue value, const BifrostObjModule* module)
+{
+  return bfVM__isObjOfType(value, BIFROST_VM_OBJ_FUNCTION) && ((const BifrostObjFn*)BIFROST_AS_OBJ(value))->module == module;
+}
+
+static bool bfVM__isClassOf(BifrostValue value, const BifrostObjModule* module)
+{
+  return bfVM__isObjOfType(value, BIFROST_VM_OBJ_CLASS) && ((const BifrostObjClass*)BIFROST_AS_OBJ(value))->module == module;
+}
+
+/*
+  NOTE(SR):
+    Everything but the object header and owning module is exchanged so that
+    every reference to [live] (other modules, instances, the host) runs the
+    new code and [fresh] takes the old code with it when it is collected.
+*/
+static void bfVM__reloadSwapFn(BifrostObjFn* live, BifrostObjFn* fresh)
+{
+  const BifrostObjFn old_live = *live;
+
+  *live        = *fresh;
+  live->super  = old_live.super;
+  live->module = old_live.module;
+
+  const BifrostObj              fresh_super  = fresh->super;
+  struct BifrostObjModule* const fresh_module = fresh->module;
+
+  *fresh        = old_live;
+  fresh->super  = fresh_super;
+  fresh->module = fresh_module;
+}
+
+/* [hint] is where the symbol usually is since module slots are seeded in the live order before compiling. */
+static size_t bfVM__reloadFindSymbol(const BifrostVMSymbol* symbols, ConstBifrostString name, size_t hint)
+{
+  const size_t num_symbols = bfVMArray_size(&symbols);
+
+  if (hint < num_symbols && symbols[hint].name == name)
+  {
+    return hint;
+  }
+
+  for (size_t i = 0; i < num_symbols; ++i)
+  {
+    if (symbols[i].name == name)
+    {
+      return i;
+    }
+  }
+
+  return BIFROST_ARRAY_INVALID_INDEX;
+}
+
+/*
+  NOTE(SR):
+    Merges [fresh_symbols] into [live_symbols] (a module's variables or a class' symbols) by name,
+    functions and classes of the live module are patched in place and any other
+    value that was already defined (module and static variables) keeps its state.
+*/
+static void bfVM__reloadMergeSymbols(BifrostVM* self, BifrostHashMap* remap, BifrostVMSymbol** live_symbols, BifrostVMSymbol* fresh_symbols, BifrostObjModule* live, BifrostObjModule* fresh)
+{
+  const size_t num_symbols = bfVMArray_size(&fresh_symbols);
+
+  for (size_t i = 0; i < num_symbols; ++i)
+  {
+    BifrostVMSymbol* const fresh_symbol = fresh_symbols + i;
+
+    if (!fresh_symbol->name)
+    {
+      continue;
+    }
+
+    const size_t     live_index  = bfVM__reloadFindSymbol(*live_symbols, fresh_symbol->name, i);
+    const bool       was_defined = live_index != BIFROST_ARRAY_INVALID_INDEX;
+    BifrostVMSymbol* live_symbol;
+
+    if (was_defined)
+    {
+      live_symbol = *live_symbols + live_index;
+    }
+    else
+    {
+      live_symbol        = bfVMArray_emplace(self, live_symbols);
+      live_symbol->name  = fresh_symbol->name;
+      live_symbol->value = bfVMValue_fromNull();
+      ++self->class_version;
+    }
+
+    const BifrostValue fresh_value = fresh_symbol->value;
+    const BifrostValue live_value  = live_symbol->value;
+
+    if (was_defined && bfVM__isFnOf(fresh_value, fresh) && bfVM__isFnOf(live_value, live))
+    {
+      BifrostObj* const live_obj = BIFROST_AS_OBJ(live_value);
+
+      bfVM__reloadSwapFn((BifrostObjFn*)live_obj, (BifrostObjFn*)BIFROST_AS_OBJ(fresh_value));
+      bfHashMap_set(remap, BIFROST_AS_OBJ(fresh_value), (void*)&live_obj);
+    }
+    else if (was_defined && bfVM__isClassOf(fresh_value, fresh) && bfVM__isClassOf(live_value, live))
+    {
+      BifrostObjClass* const live_clz  = (BifrostObjClass*)BIFROST_AS_OBJ(live_value);
+      BifrostObjClass* const fresh_clz = (BifrostObjClass*)BIFROST_AS_OBJ(fresh_value);
+      BifrostObj* const      live_obj  = &live_clz->super;
+
+      bfVM__reloadMergeSymbols(self, remap, &live_clz->symbols, fresh_clz->symbols, live, fresh);
+
+      BifrostVMSymbol* const old_initializers = live_clz->field_initializers;
+      live_clz->field_initializers            = fresh_clz->field_initializers;
+      fresh_clz->field_initializers           = old_initializers;
+      live_clz->base_clz                      = fresh_clz->base_clz;
+      ++self->class_version;
+
+      bfHashMap_set(remap, fresh_clz, (void*)&live_obj);
+    }
+    else if (!was_defined || bfVM__isObjOfType(fresh_value, BIFROST_VM_OBJ_FUNCTION) || bfVM__isObjOfType(fresh_value, BIFROST_VM_OBJ_CLASS) || bfVM__isObjOfType(fresh_value, BIFROST_VM_OBJ_NATIVE_FN))
+    {
+      live_symbol->value = fresh_value;
+    }
+  }
+}
+
+BifrostVMError bfVM_moduleReload(BifrostVM* self, const char* module, const char* source, size_t source_length)
+{
+  const string_range      name_range = MakeString(module);
+  BifrostObjModule* const live       = bfVM_findModule(self, module, name_range.str_len);
+
+  if (!live)
+  {
+    bfVM_SetLastError(BIFROST_VM_ERROR_MODULE_NOT_FOUND, self, -1, "Reload: '%s' was never loaded.", module);
+    return BIFROST_VM_ERROR_MODULE_NOT_FOUND;
+  }
+
+  /* NOTE(SR): A running frame points into the code that is about to be swapped out. */
+  const size_t num_frames = bfVMArray_size(&self->frames);
+
+  for (size_t i = 0; i < num_frames; ++i)
+  {
+    if (self->frames[i].fn && self->frames[i].fn->module == live)
+    {
+      bfVM_SetLastError(BIFROST_VM_ERROR_INVALID_ARGUMENT, self, -1, "Reload: '%s' cannot be reloaded while it is running.", module);
+      return BIFROST_VM_ERROR_INVALID_ARGUMENT;
+    }
+  }
+
+  BifrostObjModule* const fresh = bfObj_NewModule(self, name_range);
+
+  BifrostGCRoot fresh_gc_root;
+  bfGC_PushRoot(self, &fresh_gc_root, &fresh->super);
+
+  /* NOTE(SR): The new code must use the live module's variable slots since its functions are adopted as is. */
+  const size_t num_live_variables = bfVMArray_size(&live->variables);
+
+  for (size_t i = 0; i < num_live_variables; ++i)
+  {
+    bfObjModule_addSlot(self, fresh, live->variables[i].name);
+  }
+
+  /* NOTE(SR): On a compile error the live module is left untouched. */
+  const BifrostVMError err = bfVM_compileIntoModule(self, fresh, source, source_length);
+
+  if (!err)
+  {
+    BifrostHashMap       remap;
+    BifrostHashMapParams remap_params;
+    bfHashMapParams_init(&remap_params, self);
+    remap_params.hash       = ReloadMap_hash;
+    remap_params.cmp        = ReloadMap_cmp;
+    remap_params.value_size = sizeof(BifrostObj*);
+    bfHashMap_ctor(&remap, &remap_params);
+
+    bfVM__reloadMergeSymbols(self, &remap, &live->variables, fresh->variables, live, fresh);
+    bfObjModule_rebuildIndex(self, live);
+
+    /*
+      NOTE(SR):
+        A constant is part of the code rather than its state, the value the new
+        code inlined replaces the old one. The slots line up since [fresh] was
+        seeded with the live layout and new variables are appended in order.
+
+        Modules that import this one keep the values they inlined when they
+        were compiled, they have to be reloaded as well to see a changed constant.
+    */
+    const size_t num_consts = bfVMArray_size(&fresh->const_slots);
+
+    for (size_t i = 0; i < num_consts; ++i)
+    {
+      const uint32_t slot = fresh->const_slots[i];
+
+      live->variables[slot].value = fresh->variables[slot].value;
+    }
+
+    uint32_t* const live_consts = live->const_slots;
+    live->const_slots           = fresh->const_slots;
+    fresh->const_slots          = live_consts;
+
+    BifrostVMConstImport* const live_const_imports = live->const_imports;
+    live->const_imports                            = fresh->const_imports;
+    fresh->const_imports                           = live_const_imports;
+
+    /*
+      NOTE(SR):
+        The new top level code is not run, that would reset the very state being preserved.
+        It is only kept when the live module has not run yet so that saving its bytecode matches its source.
+    */
+    if (live->init_fn.name && fresh->init_fn.name)
+    {
+      bfVM__reloadSwapFn(&live->init_fn, &fresh->init_fn);
+      bfVM__reloadRemapFn(&remap, &live->init_fn);
+    }
+
+    bfObjModule_releaseInitFn(self, fresh);
+
+    /*
+      NOTE(SR):
+        Newly added functions and classes (including nested ones) are adopted by the
+        live module and anything still pointing at a patched object is redirected.
+    */
+    for (BifrostObj* obj = self->gc_object_list; obj; obj = obj->next)
+    {
+      if (obj->type == BIFROST_VM_OBJ_FUNCTION && (((BifrostObjFn*)obj)->module == fresh || ((BifrostObjFn*)obj)->module == live))
+      {
+        BifrostObjFn* const fn = (BifrostObjFn*)obj;
+
+        fn->module = live;
+        bfVM__reloadRemapFn(&remap, fn);
+      }
+      else if (obj->type == BIFROST_VM_OBJ_CLASS && (((BifrostObjClass*)obj)->module == fresh || ((BifrostObjClass*)obj)->module == live))
+      {
+        BifrostObjClass* const clz = (BifrostObjClass*)obj;
+
+        clz->module = live;
+
+        if (clz->base_clz)
+        {
+          clz->base_clz = (BifrostObjClass*)BIFROST_AS_OBJ(bfVM__reloadRemap(&remap, bfVMValue_fromPointer(clz->base_clz)));
+        }
+
+        for (size_t i = 0; i < bfVMArray_size(&clz->symbols); ++i)
+        {
+          clz->symbols[i].value = bfVM__reloadRemap(&remap, clz->symbols[i].value);
+        }
+      }
+    }
+
+    bfHashMap_dtor(&remap);
+  }
+
+  bfGC_PopRoot(self);
+
+  return err;
+}
+
 size_t bfVM_stackSize(const BifrostVM* self)
 {
   return bfVMArray_size(&self->stack) - (self->stack_top - self->stack);
@@ -306,11 +655,6 @@ BifrostValue bfVM_stackFindVariable(BifrostObjModule* module_obj, const char* va
   {
     BifrostVMSymbol* const var = module_obj->variables + i;
 
-    if (var->name == NULL)
-    {
-      continue;
-    }
-
     if (bfVMString_length(var->name) == variable_len && LibC_strncmp(variable, var->name, variable_len) == 0)
     {
       return var->value;
@@ -388,7 +732,8 @@ static BifrostObjModule* bfVM__findModule(BifrostValue obj)
   return NULL;
 }
 
-uint32_t bfVM_xSetVariable(BifrostVMSymbol** variables, BifrostVM* vm, string_range name, BifrostValue value);
+void     bfVM_xSetClassSymbol(BifrostObjClass* clz, BifrostVM* vm, string_range name, BifrostValue value);
+uint32_t bfVM_xSetModuleVariable(BifrostObjModule* module, BifrostVM* vm, string_range name, BifrostValue value);
 
 static BifrostObjClass* createClassBinding(BifrostVM* self, BifrostValue obj, const BifrostVMClassBind* clz_bind)
 {
@@ -420,7 +765,7 @@ static BifrostObjClass* createClassBinding(BifrostVM* self, BifrostValue obj, co
 
     BifrostGCRoot fn_gc_root;
     bfGC_PushRoot(self, &fn_gc_root, &fn->super);
-    bfVM_xSetVariable(&clz->symbols, self, MakeString(method->name), bfVMValue_fromPointer(fn));
+    bfVM_xSetClassSymbol(clz, self, MakeString(method->name), bfVMValue_fromPointer(fn));
     bfGC_PopRoot(self);
 
     ++method;
@@ -498,6 +843,7 @@ void bfVM_classSetBaseClass(BifrostVM* self, size_t idx, size_t clz_idx)
   if (bfVMGrabObjectsOfType(obj, clz, BIFROST_VM_OBJ_CLASS, BIFROST_VM_OBJ_CLASS, &obj_ptr, &clz_ptr))
   {
     ((BifrostObjClass*)obj_ptr)->base_clz = (BifrostObjClass*)clz_ptr;
+    ++self->class_version;
   }
 }
 
@@ -535,14 +881,7 @@ void bfVM_stackLoadVariable(BifrostVM* self, size_t dst_idx, size_t inst_or_clas
 
     /* TODO: Look through base classes? */
 
-    if (symbol < bfVMArray_size(&clz->symbols))
-    {
-      self->stack_top[dst_idx] = clz->symbols[symbol].value;
-    }
-    else
-    {
-      self->stack_top[dst_idx] = bfVMValue_fromNull();
-    }
+    self->stack_top[dst_idx] = bfObjClass_ownSymbol(self, clz, self->symbols[symbol]);
   }
   else if (obj->type == BIFROST_VM_OBJ_MODULE)
   {
@@ -576,13 +915,13 @@ static int bfVM__stackStoreVariable(BifrostVM* self, BifrostValue obj, string_ra
   {
     BifrostObjClass* clz = (BifrostObjClass*)obj_ptr;
 
-    bfVM_xSetVariable(&clz->symbols, self, field_symbol, value);
+    bfVM_xSetClassSymbol(clz, self, field_symbol, value);
   }
   else if (obj_ptr->type == BIFROST_VM_OBJ_MODULE)
   {
     BifrostObjModule* const module_obj = (BifrostObjModule*)obj_ptr;
 
-    bfVM_xSetVariable(&module_obj->variables, self, field_symbol, value);
+    bfVM_xSetModuleVariable(module_obj, self, field_symbol, value);
   }
   else
   {
@@ -1031,9 +1370,8 @@ static BifrostVMStackFrame* bfVM_pushCallFrame(BifrostVM* self, BifrostObjFn* fn
   return new_frame;
 }
 
-static void bfVM_popAllCallFrames(BifrostVM* self, const BifrostVMStackFrame* ref_frame)
+static void bfVM_popAllCallFrames(BifrostVM* self, const size_t num_frames)
 {
-  const size_t    num_frames   = ref_frame - self->frames;
   const size_t    total_frames = bfVMArray_size(&self->frames);
   const bfErrorFn error_fn     = self->params.error_fn;
 
@@ -1044,12 +1382,19 @@ static void bfVM_popAllCallFrames(BifrostVM* self, const BifrostVMStackFrame* re
 
     for (size_t i = num_frames; i < total_frames; ++i)
     {
-      const BifrostVMStackFrame* frame    = bfVMArray_at(&self->frames, i);
-      const BifrostObjFn* const  fn       = frame->fn;
-      const int                  line_num = fn ? fn->code_to_line[frame->ip - fn->instructions] : -1;
+      /*
+        NOTE(SR):
+          A frame that entered a script function has already stepped past the call
+          so the line is that of the instruction before, while calling a native
+          (or for the frame that raised the error) [ip] is still on the instruction.
+      */
+      const BifrostVMStackFrame* frame     = bfVMArray_at(&self->frames, i);
+      const BifrostObjFn* const  fn        = frame->fn;
+      const bool                 past_call = i + 1 < total_frames && self->frames[i + 1].fn != NULL;
+      const int                  line_num  = fn ? bfObjFn_lineOf(fn, frame->ip - past_call) : -1;
       const char* const          fn_name  = fn ? fn->name : "<native>";
 
-      bfVMString_sprintf(self, &self->last_error, "%*.s[%zu] Stack Frame Line(%u): %s\n", (int)i * 3, "", i, (unsigned)line_num, fn_name);
+      bfVMString_sprintf(self, &self->last_error, "%*.s[%zu] Stack Frame Line(%d): %s\n", (int)i * 3, "", i, line_num, fn_name);
 
       error_fn(self, BIFROST_VM_ERROR_STACK_TRACE, line_num, self->last_error);
     }
@@ -1057,7 +1402,7 @@ static void bfVM_popAllCallFrames(BifrostVM* self, const BifrostVMStackFrame* re
     error_fn(self, BIFROST_VM_ERROR_STACK_TRACE_END, -1, "");
   }
 
-  self->stack_top = self->stack + ref_frame->old_stack;
+  self->stack_top = self->stack + self->frames[num_frames].old_stack;
   bfVMArray_resize(self, &self->frames, num_frames);
 }
 
@@ -1067,12 +1412,40 @@ static void bfVM_popCallFrame(BifrostVM* self, BifrostVMStackFrame* frame)
   bfVMArray_pop(&self->frames);  // TODO(SR): Assert frame was at the top of the call stack.
 }
 
+/* NOTE(SR): Instructions of a function mapped from a bytecode image hold the image's symbol ids. */
+static uint32_t bfVM__instSymbol(const BifrostObjFn* fn, uint32_t symbol)
+{
+  return fn->image ? fn->image->symbols[symbol] : symbol;
+}
+
+/* NOTE(SR): The non number cases of '+', on failure the message is left in 'BifrostVM::last_error'. May allocate. */
+static bool bfVM__addSlow(BifrostVM* self, BifrostValue lhs, BifrostValue rhs, BifrostValue* result)
+{
+  if ((bfVMValue_isPointer(lhs) && BIFROST_AS_OBJ(lhs)->type == BIFROST_VM_OBJ_STRING) || (bfVMValue_isPointer(rhs) && BIFROST_AS_OBJ(rhs)->type == BIFROST_VM_OBJ_STRING))
+  {
+    char         string_buffer[512];
+    const size_t offset = bfDbg_ValueToString(lhs, string_buffer, sizeof(string_buffer));
+    bfDbg_ValueToString(rhs, string_buffer + offset, sizeof(string_buffer) - offset);
+
+    *result = bfVMValue_fromPointer(bfObj_NewString(self, MakeString(string_buffer)));
+    return true;
+  }
+
+  char         string_buffer[512];
+  const size_t offset = bfDbg_ValueTypeToString(lhs, string_buffer, sizeof(string_buffer));
+  bfDbg_ValueTypeToString(rhs, string_buffer + offset + 1, sizeof(string_buffer) - offset - 1);
+
+  bfVMString_sprintf(self, &self->last_error, "'+' operator of two incompatible types (%s + %s).", string_buffer, string_buffer + offset + 1);
+  return false;
+}
+
 static BifrostVMError bfVM_execTopFrame(BifrostVM* self, BifrostObjFn* fn_to_run, const size_t new_start)
 {
   bfVM_pushCallFrame(self, fn_to_run, new_start);
 
-  const BifrostVMStackFrame* const reference_frame = bfVMArray_back(&self->frames);
-  BifrostVMError                   err             = BIFROST_VM_ERROR_NONE;
+  /* NOTE(SR): An index since calls made from this frame may grow (move) [BifrostVM::frames]. */
+  const size_t   reference_frame = bfVMArray_size(&self->frames) - 1u;
+  BifrostVMError err             = BIFROST_VM_ERROR_NONE;
 
 #define BF_RUNTIME_ERROR(...)                               \
   bfVMString_sprintf(self, &self->last_error, __VA_ARGS__); \
@@ -1110,7 +1483,7 @@ frame_start:;
       case BIFROST_VM_OP_LOAD_SYMBOL:
       {
         const BifrostValue     obj_value  = locals[regs[REG_RB]];
-        const uint32_t      symbol     = regs[REG_RC];
+        const uint32_t      symbol     = bfVM__instSymbol(frame->fn, regs[REG_RC]);
         const BifrostString symbol_str = self->symbols[symbol];
 
         if (!bfVMValue_isPointer(obj_value))
@@ -1149,32 +1522,27 @@ frame_start:;
 
         if (obj->type == BIFROST_VM_OBJ_CLASS)
         {
-          BifrostObjClass* original_clz = (BifrostObjClass*)obj;
-          BifrostObjClass* clz          = original_clz;
-          bool             found_field  = false;
+          BifrostObjClass* const clz = (BifrostObjClass*)obj;
+          BifrostValue           value;
 
-          while (clz)
-          {
-            if (symbol < bfVMArray_size(&clz->symbols) && clz->symbols[symbol].value != bfVMValue_fromNull())
-            {
-              locals[regs[REG_RA]] = clz->symbols[symbol].value;
-              found_field          = true;
-              break;
-            }
+          /* NOTE(SR): Building a stale member table may collect which can run script destructors. */
+          const bool found_field = bfObjClass_loadSymbol(self, clz, symbol_str, &value);
 
-            clz = clz->base_clz;
-          }
+          BF_REFRESH_LOCALS();
 
           if (!found_field)
           {
-            BF_RUNTIME_ERROR("'%s::%s' is not defined (also not found in any base class).\n", original_clz->name, self->symbols[symbol]);
+            BF_RUNTIME_ERROR("'%s::%s' is not defined (also not found in any base class).\n", clz->name, symbol_str);
           }
+
+          locals[regs[REG_RA]] = value;
         }
         else if (obj->type == BIFROST_VM_OBJ_MODULE)
         {
           BifrostObjModule* module = (BifrostObjModule*)obj;
+          const size_t      slot   = bfObjModule_findSlot(module, symbol_str);
 
-          locals[regs[REG_RA]] = bfVM_stackFindVariable(module, symbol_str, bfVMString_length(symbol_str));
+          locals[regs[REG_RA]] = slot != BIFROST_ARRAY_INVALID_INDEX ? module->variables[slot].value : bfVMValue_fromNull();
         }
         else
         {
@@ -1184,7 +1552,7 @@ frame_start:;
       }
       case BIFROST_VM_OP_STORE_SYMBOL:
       {
-        const BifrostString sym_str   = self->symbols[regs[REG_RB]];
+        const BifrostString sym_str   = self->symbols[bfVM__instSymbol(frame->fn, regs[REG_RB])];
         const int           err_store = bfVM__stackStoreVariable(self, locals[regs[REG_RA]], (string_range){sym_str, bfVMString_length(sym_str)}, locals[regs[REG_RC]]);
 
         if (err_store)
@@ -1201,6 +1569,16 @@ frame_start:;
         }
         break;
       }
+      case BIFROST_VM_OP_LOAD_GLOBAL:
+      {
+        locals[regs[REG_RA]] = current_module->variables[regs[REG_RBx]].value;
+        break;
+      }
+      case BIFROST_VM_OP_STORE_GLOBAL:
+      {
+        current_module->variables[regs[REG_RBx]].value = locals[regs[REG_RA]];
+        break;
+      }
       case BIFROST_VM_OP_LOAD_BASIC:
       {
         const uint32_t action = regs[REG_RBx];
@@ -1222,7 +1600,15 @@ frame_start:;
         }
         else
         {
-          locals[regs[REG_RA]] = constants[regs[REG_RBx] - BIFROST_VM_OP_LOAD_BASIC_CONSTANT];
+          BifrostValue constant = constants[regs[REG_RBx] - BIFROST_VM_OP_LOAD_BASIC_CONSTANT];
+
+          if (bfBytecode_isObjectConstant(constant) && frame->fn->image)
+          {
+            constant = bfBytecode_materialize(self, frame->fn, constant);
+            BF_REFRESH_LOCALS();
+          }
+
+          locals[regs[REG_RA]] = constant;
         }
         break;
       }
@@ -1258,6 +1644,67 @@ frame_start:;
         }
         break;
       }
+      case BIFROST_VM_OP_NEW_CONSTRUCT:
+      {
+        const uint32_t     rb    = regs[REG_RB];
+        const BifrostValue value = locals[rb];
+
+        if (!bfVM__isObjOfType(value, BIFROST_VM_OBJ_CLASS))
+        {
+          char string_buffer[512];
+          bfDbg_ValueTypeToString(value, string_buffer, sizeof(string_buffer));
+
+          BF_RUNTIME_ERROR("Called new on a non Class type (%s).\n", string_buffer);
+        }
+
+        BifrostObjClass* const   clz  = (BifrostObjClass*)BIFROST_AS_OBJ(value);
+        BifrostVMCtorSite* const site = frame->fn->ctor_sites + regs[REG_RC];
+        void* const              inst = bfObj_NewInstance(self, clz);
+
+        BF_REFRESH_LOCALS();
+        locals[regs[REG_RA]] = bfVMValue_fromPointer(inst);
+        locals[rb + 1]       = bfVMValue_fromPointer(inst);
+
+        if (site->clz != clz || site->version != self->class_version || bfVMValue_isNull(site->owner->symbols[site->slot].value))
+        {
+          BifrostVMClassMember ctor;
+
+          if (!bfObjClass_resolveSymbol(self, clz, self->symbols[site->symbol], &ctor))
+          {
+            BF_RUNTIME_ERROR("'%s::%s' is not defined (also not found in any base class).\n", clz->name, self->symbols[site->symbol]);
+          }
+
+          BF_REFRESH_LOCALS();
+          site->version = self->class_version;
+          site->clz     = clz;
+          site->owner   = ctor.owner;
+          site->slot    = ctor.slot;
+        }
+
+        const BifrostValue ctor_value = site->owner->symbols[site->slot].value;
+
+        locals[rb] = ctor_value;
+
+        /*
+          NOTE(SR):
+            A script constructor is entered straight away when the 'CALL_FN'
+            directly follows (no arguments to evaluate first), it only runs for
+            anything else (natives, callable instances, lazy bodies and errors).
+        */
+        if (bfVM__isObjOfType(ctor_value, BIFROST_VM_OBJ_FUNCTION) && bfInst_getX(frame->ip[1], OP) == BIFROST_VM_OP_CALL_FN)
+        {
+          BifrostObjFn* const fn       = (BifrostObjFn*)BIFROST_AS_OBJ(ctor_value);
+          const int32_t       num_args = (int32_t)bfInst_getX(frame->ip[1], RC);
+
+          if (!fn->lazy_source && fn->arity == num_args)
+          {
+            frame->ip += 2;
+            bfVM_pushCallFrame(self, fn, frame->stack + rb);
+            goto frame_start;
+          }
+        }
+        break;
+      }
       case BIFROST_VM_OP_NOT:
       {
         locals[regs[REG_RA]] = bfVMValue_fromBool(bfVMValue_isThuthy(locals[regs[REG_RBx]]));
@@ -1288,44 +1735,39 @@ frame_start:;
 
           if (obj->type == BIFROST_VM_OBJ_CLASS)
           {
-            const BifrostObjClass* const clz      = (const BifrostObjClass*)obj;
-            const size_t                 call_sym = self->build_in_symbols[BIFROST_VM_SYMBOL_CALL];
+            const BifrostObjClass* const clz        = (const BifrostObjClass*)obj;
+            const size_t                 call_sym   = self->build_in_symbols[BIFROST_VM_SYMBOL_CALL];
+            const BifrostValue           call_value = bfObjClass_ownSymbol(self, clz, self->symbols[call_sym]);
 
-            if (call_sym < bfVMArray_size(&clz->symbols))
+            if (bfVMValue_isNull(call_value))
             {
-              const BifrostValue call_value = clz->symbols[call_sym].value;
-
-              if (bfVMValue_isPointer(call_value))
-              {
-                BifrostObj* const call_obj = BIFROST_AS_OBJ(call_value);
-
-                if (call_obj->type != BIFROST_VM_OBJ_FUNCTION && call_obj->type != BIFROST_VM_OBJ_NATIVE_FN)
-                {
-                  BF_RUNTIME_ERROR("'%s::call' must be defined as a function to use instance as function.\n", clz->name);
-                }
-
-                if (bfVM_ensureStackspace(self, num_args + (size_t)1, locals + ra))
-                {
-                  BF_REFRESH_LOCALS();
-                }
-
-                BifrostValue* new_top = locals + ra;
-
-                LibC_memmove(new_top + 1, new_top, sizeof(BifrostValue) * num_args);
-
-                new_top[0] = bfVMValue_fromPointer(instance);
-                obj        = call_obj;
-                ++num_args;
-              }
-              else
-              {
-                BF_RUNTIME_ERROR("'%s::call' must be defined as a function to use instance as function.\n", clz->name);
-              }
+              BF_RUNTIME_ERROR("%s does not define a 'call' function.\n", clz->name);
             }
-            else
+
+            if (!bfVMValue_isPointer(call_value))
             {
-              BF_RUNTIME_ERROR("%s does not define a 'call' function.\n", clz->name);
+              BF_RUNTIME_ERROR("'%s::call' must be defined as a function to use instance as function.\n", clz->name);
+            }
+
+            BifrostObj* const call_obj = BIFROST_AS_OBJ(call_value);
+
+            if (call_obj->type != BIFROST_VM_OBJ_FUNCTION && call_obj->type != BIFROST_VM_OBJ_NATIVE_FN)
+            {
+              BF_RUNTIME_ERROR("'%s::call' must be defined as a function to use instance as function.\n", clz->name);
             }
+
+            if (bfVM_ensureStackspace(self, num_args + (size_t)2, locals + ra))
+            {
+              BF_REFRESH_LOCALS();
+            }
+
+            BifrostValue* new_top = locals + ra + 1;
+
+            LibC_memmove(new_top + 1, new_top, sizeof(BifrostValue) * num_args);
+
+            new_top[0] = bfVMValue_fromPointer(instance);
+            obj        = call_obj;
+            ++num_args;
           }
 
           if (obj->type == BIFROST_VM_OBJ_FUNCTION)
@@ -1337,6 +1779,11 @@ frame_start:;
               BF_RUNTIME_ERROR("Function (%s) called with %i argument(s) but requires %i.\n", fn->name, (int)num_args, (int)fn->arity);
             }
 
+            if (fn->lazy_source && bfVM_compileLazyFunction(self, fn))
+            {
+              BF_RUNTIME_ERROR("Function (%s) failed to compile.\n", fn->name);
+            }
+
             ++frame->ip;
             bfVM_pushCallFrame(self, fn, new_stack);
             goto frame_start;
@@ -1350,13 +1797,15 @@ frame_start:;
               BF_RUNTIME_ERROR("Function<native> called with %i arguments but requires %i.\n", (int)num_args, (int)fn->arity);
             }
 
-            BifrostVMStackFrame* const native_frame = bfVM_pushCallFrame(self, NULL, new_stack);
+            /* NOTE(SR): Natives see only their arguments and return through the first one. */
+            BifrostVMStackFrame* const native_frame = bfVM_pushCallFrame(self, NULL, new_stack + 1);
             self->current_native_fn                 = fn;
             fn->value(self, (int32_t)num_args);
             self->current_native_fn = NULL;
             bfVM_popCallFrame(self, native_frame);
 
             BF_REFRESH_LOCALS();
+            locals[ra] = locals[ra + 1];
           }
           else
           {
@@ -1378,25 +1827,45 @@ frame_start:;
         {
           locals[regs[REG_RA]] = bfVMValue_fromNumber(bfVMValue_asNumber(lhs) + bfVMValue_asNumber(rhs));
         }
-        else if ((bfVMValue_isPointer(lhs) && BIFROST_AS_OBJ(lhs)->type == BIFROST_VM_OBJ_STRING) || (bfVMValue_isPointer(rhs) && BIFROST_AS_OBJ(rhs)->type == BIFROST_VM_OBJ_STRING))
+        else
         {
-          char         string_buffer[512];
-          const size_t offset = bfDbg_ValueToString(lhs, string_buffer, sizeof(string_buffer));
-          bfDbg_ValueToString(rhs, string_buffer + offset, sizeof(string_buffer) - offset);
+          BifrostValue result;
 
-          BifrostObjStr* const str_obj = bfObj_NewString(self, MakeString(string_buffer));
+          if (!bfVM__addSlow(self, lhs, rhs, &result))
+          {
+            goto runtime_error;
+          }
 
           BF_REFRESH_LOCALS();
 
-          locals[regs[REG_RA]] = bfVMValue_fromPointer(str_obj);
+          locals[regs[REG_RA]] = result;
+        }
+        break;
+      }
+      case BIFROST_VM_OP_MATH_INC:
+      {
+        const BifrostValue lhs = locals[regs[REG_RA]];
+
+        if (bfVMValue_isNumber(lhs))
+        {
+          locals[regs[REG_RA]] = bfVMValue_fromNumber(bfVMValue_asNumber(lhs) + (double)rsbx);
+        }
+        else if (rsbx < 0)
+        {
+          BF_RUNTIME_ERROR("Subtraction is not allowed on non number values.\n");
         }
         else
         {
-          char         string_buffer[512];
-          const size_t offset = bfDbg_ValueTypeToString(lhs, string_buffer, sizeof(string_buffer));
-          bfDbg_ValueTypeToString(rhs, string_buffer + offset + 1, sizeof(string_buffer) - offset - 1);
+          BifrostValue result;
+
+          if (!bfVM__addSlow(self, lhs, bfVMValue_fromNumber((double)rsbx), &result))
+          {
+            goto runtime_error;
+          }
 
-          BF_RUNTIME_ERROR("'+' operator of two incompatible types (%s + %s).", string_buffer, string_buffer + offset + 1);
+          BF_REFRESH_LOCALS();
+
+          locals[regs[REG_RA]] = result;
         }
         break;
       }
@@ -1481,6 +1950,66 @@ frame_start:;
         }
         break;
       }
+      case BIFROST_VM_OP_SWITCH:
+      {
+        /* NOTE(SR): See 'parserEmitSwitchTable' for the layout of the table. */
+        const BifrostValue        value     = locals[regs[REG_RA]];
+        const BifrostValue* const table     = constants + regs[REG_RBx];
+        const double              num_slots = bfVMValue_asNumber(table[0]);
+        int32_t                   jump_amt  = 0;
+
+        if (num_slots >= 0.0)
+        {
+          if (bfVMValue_isNumber(value))
+          {
+            const double index = bfVMValue_asNumber(value) - bfVMValue_asNumber(table[1]);
+
+            if (index >= 0.0 && index < num_slots && index == (double)(uint32_t)index)
+            {
+              jump_amt = (int32_t)bfVMValue_asNumber(table[2u + (uint32_t)index]);
+            }
+          }
+        }
+        else
+        {
+          const uint32_t mask = (uint32_t)-num_slots - 1u;
+          uint32_t       slot = bfVMValue_hash(value) & mask;
+
+          while (true)
+          {
+            const BifrostValue* const entry     = table + 1u + slot * 2u;
+            const int32_t             entry_amt = (int32_t)bfVMValue_asNumber(entry[1]);
+
+            if (entry_amt == 0)
+            {
+              break;
+            }
+
+            BifrostValue key = entry[0];
+
+            if (bfBytecode_isObjectConstant(key) && frame->fn->image)
+            {
+              key = bfBytecode_materialize(self, frame->fn, key);
+              BF_REFRESH_LOCALS();
+            }
+
+            if (bfVMValue_ee(key, value))
+            {
+              jump_amt = entry_amt;
+              break;
+            }
+
+            slot = (slot + 1u) & mask;
+          }
+        }
+
+        if (jump_amt)
+        {
+          frame->ip += jump_amt;
+          continue;
+        }
+        break;
+      }
       default:
       {
         BF_RUNTIME_ERROR("Invalid OP: %i\n", (int)op);
@@ -1501,7 +2030,7 @@ runtime_error:
 halt:
   bfVM_popCallFrame(self, frame);
 
-  if (reference_frame < frame)
+  if (reference_frame < bfVMArray_size(&self->frames))
   {
     goto frame_start;
   }
@@ -1527,8 +2056,27 @@ BifrostVMError bfVM_call(BifrostVM* self, size_t idx, size_t args_start, int32_t
   {
     BifrostObjFn* const fn = (BifrostObjFn*)obj;
 
-    if (fn->arity < 0 || fn->arity == num_args)
+    if (fn->lazy_source && bfVM_compileLazyFunction(self, fn))
     {
+      err = BIFROST_VM_ERROR_COMPILE;
+    }
+    else if (fn->arity < 0 || fn->arity == num_args)
+    {
+      /*
+        NOTE(SR):
+          Script functions expect their parameters to start at register 1,
+          register 0 is where the return value is written which
+          keeps the result in 'API_stack[args_start]'.
+      */
+      if (bfVM_ensureStackspace(self, args_start + (size_t)num_args + 1u, self->stack_top))
+      {
+        self->stack_top = self->stack + base_stack;
+      }
+
+      BifrostValue* const args = self->stack_top + args_start;
+
+      LibC_memmove(args + 1, args, sizeof(BifrostValue) * num_args);
+
       err = bfVM_execTopFrame(self, fn, new_stack_top);
     }
     else
@@ -1584,6 +2132,155 @@ BifrostVMError bfVM_execInModule(BifrostVM* self, const char* module, const char
   return err;
 }
 
+BifrostVMError bfVM_compileInModule(BifrostVM* self, const char* module, const char* source, size_t source_length)
+{
+  BifrostObjModule* module_obj;
+  BifrostVMError    err = bfVM__moduleMake(self, module, &module_obj);
+
+  if (!err)
+  {
+    BifrostGCRoot module_gc_root;
+    bfGC_PushRoot(self, &module_gc_root, &module_obj->super);
+
+    err = bfVM_compileIntoModule(self, module_obj, source, source_length);
+
+    bfVM_stackResize(self, 1);
+    self->stack_top[0] = bfVMValue_fromPointer(module_obj);
+    bfGC_PopRoot(self);
+  }
+
+  return err;
+}
+
+BifrostVMError bfVM_execInModuleStream(BifrostVM* self, const char* module, bfSourceReadFn read_fn, void* user_data)
+{
+  BifrostObjModule* module_obj;
+  BifrostVMError    err = bfVM__moduleMake(self, module, &module_obj);
+
+  if (!err)
+  {
+    BifrostGCRoot module_gc_root;
+    bfGC_PushRoot(self, &module_gc_root, &module_obj->super);
+
+    err = bfVM__compileStream(self, module_obj, read_fn, user_data);
+
+    if (!err)
+    {
+      err = bfVM_runModule(self, module_obj);
+    }
+
+    bfVM_stackResize(self, 1);
+    self->stack_top[0] = bfVMValue_fromPointer(module_obj);
+    bfGC_PopRoot(self);
+  }
+
+  return err;
+}
+
+BifrostVMError bfVM_compileInModuleStream(BifrostVM* self, const char* module, bfSourceReadFn read_fn, void* user_data)
+{
+  BifrostObjModule* module_obj;
+  BifrostVMError    err = bfVM__moduleMake(self, module, &module_obj);
+
+  if (!err)
+  {
+    BifrostGCRoot module_gc_root;
+    bfGC_PushRoot(self, &module_gc_root, &module_obj->super);
+
+    err = bfVM__compileStream(self, module_obj, read_fn, user_data);
+
+    bfVM_stackResize(self, 1);
+    self->stack_top[0] = bfVMValue_fromPointer(module_obj);
+    bfGC_PopRoot(self);
+  }
+
+  return err;
+}
+
+BifrostVMError bfVM_moduleSaveBytecode(BifrostVM* self, size_t idx, bfBytecodeWriteFn write_fn, void* user_data)
+{
+  bfVM_assertStackIndex(self, idx);
+
+  const BifrostValue value = self->stack_top[idx];
+
+  if (!bfVMValue_isPointer(value) || BIFROST_AS_OBJ(value)->type != BIFROST_VM_OBJ_MODULE)
+  {
+    return BIFROST_VM_ERROR_INVALID_OP_ON_TYPE;
+  }
+
+  return bfBytecode_save(self, (BifrostObjModule*)BIFROST_AS_OBJ(value), write_fn, user_data);
+}
+
+BifrostVMError bfVM_moduleLoadBytecode(BifrostVM* self, const char* module, const void* bytecode, size_t bytecode_size)
+{
+  if (!bfBytecode_isImage(bytecode, bytecode_size))
+  {
+    bfVM_SetLastError(BIFROST_VM_ERROR_INVALID_ARGUMENT, self, -1, "Bytecode: not a bytecode image.");
+    return BIFROST_VM_ERROR_INVALID_ARGUMENT;
+  }
+
+  return bfVM_execInModule(self, module, bytecode, bytecode_size);
+}
+
+BifrostVMError bfVM_moduleMapBytecode(BifrostVM* self, const char* module, const void* bytecode, size_t bytecode_size)
+{
+  BifrostObjModule* module_obj;
+  BifrostVMError    err = bfVM__moduleMake(self, module, &module_obj);
+
+  if (!err)
+  {
+    BifrostGCRoot module_gc_root;
+    bfGC_PushRoot(self, &module_gc_root, &module_obj->super);
+
+    err = bfBytecode_load(self, module_obj, bytecode, bytecode_size, true);
+
+    if (!err)
+    {
+      err = bfVM_runModule(self, module_obj);
+    }
+
+    bfVM_stackResize(self, 1);
+    self->stack_top[0] = bfVMValue_fromPointer(module_obj);
+    bfGC_PopRoot(self);
+  }
+
+  return err;
+}
+
+BifrostVMError bfVM_compileDetached(const BifrostVMParams* params, const char* module, const char* source, size_t source_length, bfBytecodeWriteFn write_fn, void* user_data)
+{
+  /*
+    NOTE(SR):
+      The host's callbacks are not expected to be called from another thread,
+      a compile cache would even be written to by every thread compiling the same module.
+      Lazy compilation would only be undone by saving the image.
+  */
+  BifrostVMParams detached_params = *params;
+  detached_params.error_fn        = NULL;
+  detached_params.print_fn        = NULL;
+  detached_params.module_fn       = NULL;
+  detached_params.cache_lookup_fn = NULL;
+  detached_params.cache_store_fn  = NULL;
+  detached_params.lazy_compile    = false;
+
+  BifrostVM vm;
+  bfVM_ctor(&vm, &detached_params);
+
+  bfVM_stackResize(&vm, 1);
+  bfVM_moduleLoadStd(&vm, 0, BIFROST_VM_STD_MODULE_ALL);
+
+  BifrostVMError err = bfVM_compileInModule(&vm, module, source, source_length);
+
+  if (!err)
+  {
+    err = bfVM_moduleSaveBytecode(&vm, 0, write_fn, user_data);
+  }
+
+  bfVM_dtor(&vm);
+
+  return err;
+}
+
 void bfVM_gc(BifrostVM* self)
 {
   bfGC_Collect(self);
@@ -1698,15 +2395,141 @@ uint32_t bfVM_getSymbol(BifrostVM* self, string_range name)
   return num_symbols;
 }
 
+/* NOTE(SR): Top level code only ever runs once so it is released right after, even on an error. */
 static BifrostVMError bfVM_runModule(BifrostVM* self, BifrostObjModule* module)
 {
-  const size_t old_top = self->stack_top - self->stack;
+  const size_t         old_top = self->stack_top - self->stack;
+  const BifrostVMError err     = bfVM_execTopFrame(self, &module->init_fn, old_top);
+
+  bfObjModule_releaseInitFn(self, module);
+
+  return err;
+}
+
+typedef struct bfVMCacheBuffer
+{
+  BifrostVM* vm;
+  char*      bytes;
+
+} bfVMCacheBuffer;
+
+/*
+  NOTE(SR):
+    64bit FNV-1a of the source, seeded with everything else that changes the
+    compiled output so a stale image is just a cache miss. The values of
+    imported constants are recorded in the image itself, see 'bfBytecode_isStale'.
+*/
+static uint64_t bfVM__sourceHash(const BifrostVM* self, const char* source, size_t source_len)
+{
+  uint64_t hash = 0xCBF29CE484222325ull;
+
+  hash = (hash ^ BIFROST_VM_BYTECODE_VERSION) * 0x100000001B3ull;
+  hash = (hash ^ self->params.inline_threshold) * 0x100000001B3ull;
+  hash = (hash ^ self->params.strip_debug_info) * 0x100000001B3ull;
+
+  for (size_t i = 0; i < source_len; ++i)
+  {
+    hash = (hash ^ (uint8_t)source[i]) * 0x100000001B3ull;
+  }
+
+  return hash;
+}
+
+static void bfVM__cacheWrite(void* user_data, const void* data, size_t data_size)
+{
+  bfVMCacheBuffer* const buffer = (bfVMCacheBuffer*)user_data;
+
+  LibC_memcpy(bfVMArray_emplaceN(buffer->vm, &buffer->bytes, data_size), data, data_size);
+}
 
-  return bfVM_execTopFrame(self, &module->init_fn, old_top);
+static void bfVM__cacheStore(BifrostVM* self, BifrostObjModule* module, uint64_t source_hash)
+{
+  bfVMCacheBuffer buffer;
+  buffer.vm    = self;
+  buffer.bytes = bfVMArray_newA(self, buffer.bytes, 4096);
+
+  if (bfBytecode_save(self, module, &bfVM__cacheWrite, &buffer) == BIFROST_VM_ERROR_NONE)
+  {
+    self->params.cache_store_fn(self, module->name, source_hash, buffer.bytes, bfVMArray_size(&buffer.bytes));
+  }
+
+  bfVMArray_delete(self, &buffer.bytes);
 }
 
 static BifrostVMError bfVM_compileIntoModule(BifrostVM* self, BifrostObjModule* module, const char* source, size_t source_len)
 {
+  if (bfBytecode_isImage(source, source_len))
+  {
+    return bfBytecode_load(self, module, source, source_len, false);
+  }
+
+  const bfCacheLookUpFn cache_lookup = self->params.cache_lookup_fn;
+  const bool            cache_store  = self->params.cache_store_fn && !self->params.lazy_compile;
+  const uint64_t        source_hash  = (cache_lookup || cache_store) ? bfVM__sourceHash(self, source, source_len) : 0u;
+
+  if (cache_lookup)
+  {
+    BifrostVMModuleLookUp cached =
+     {
+      .source     = NULL,
+      .source_len = 0u,
+     };
+
+    cache_lookup(self, module->name, source_hash, &cached);
+
+    /*
+      NOTE(SR):
+        The source hash can not know what the imported constants are, an image
+        that inlined old values is a miss too. So is one that fails to load
+        (corrupt, truncated), the loader leaves the module as it was and the
+        error is not reported since the source is compiled instead.
+    */
+    if (cached.source && cached.source_len)
+    {
+      const bfErrorFn error_fn = self->params.error_fn;
+
+      self->params.error_fn = NULL;
+
+      const bool is_hit = !bfBytecode_isStale(self, module, cached.source, cached.source_len) &&
+                          bfBytecode_load(self, module, cached.source, cached.source_len, false) == BIFROST_VM_ERROR_NONE;
+
+      self->params.error_fn = error_fn;
+
+      bfGC_AllocMemory(self, (void*)cached.source, cached.source_len, 0u);
+
+      if (is_hit)
+      {
+        return BIFROST_VM_ERROR_NONE;
+      }
+    }
+  }
+
+  const BifrostVMError err = bfVM__compileSource(self, module, source, source_len);
+
+  if (!err && cache_store)
+  {
+    bfVM__cacheStore(self, module, source_hash);
+  }
+
+  return err;
+}
+
+static BifrostVMError bfVM__compileSource(BifrostVM* self, BifrostObjModule* module, const char* source, size_t source_len)
+{
+  BifrostObjStr* lazy_source = NULL;
+  BifrostGCRoot  lazy_source_gc_root;
+
+  /* NOTE(SR): The host owns [source] so a copy is made for the function bodies that are compiled later. */
+  if (self->params.lazy_compile)
+  {
+    const string_range source_range = {.str_bgn = source, .str_len = source_len};
+
+    lazy_source = bfObj_NewStringVerbatim(self, source_range);
+    source      = lazy_source->value;
+
+    bfGC_PushRoot(self, &lazy_source_gc_root, &lazy_source->super);
+  }
+
   const BifrostLexerParams lex_params =
    {
     .source = source,
@@ -1718,9 +2541,64 @@ static BifrostVMError bfVM_compileIntoModule(BifrostVM* self, BifrostObjModule*
 
   BifrostParser parser;
   bfParser_ctor(&parser, self, &lexer, module);
+  parser.lazy_source   = lazy_source;
   const bool has_error = bfParser_compile(&parser);
   bfParser_dtor(&parser);
 
+  if (lazy_source)
+  {
+    bfGC_PopRoot(self);
+  }
+
+  return has_error ? BIFROST_VM_ERROR_COMPILE : BIFROST_VM_ERROR_NONE;
+}
+
+/*
+  NOTE(SR):
+    The whole source is never in memory at once so there is nothing to
+    hash for the cache and nothing to keep around for lazy function bodies,
+    both are skipped.
+*/
+static BifrostVMError bfVM__compileStream(BifrostVM* self, BifrostObjModule* module, bfSourceReadFn read_fn, void* user_data)
+{
+  const BifrostLexerParams lex_params =
+   {
+    .source         = NULL,
+    .length         = 0u,
+    .vm             = self,
+    .read_fn        = read_fn,
+    .read_user_data = user_data,
+   };
+
+  BifrostLexer lexer = bfLexer_make(&lex_params);
+
+  BifrostParser parser;
+  bfParser_ctor(&parser, self, &lexer, module);
+  const bool has_error = bfParser_compile(&parser);
+  bfParser_dtor(&parser);
+  bfLexer_dtor(&lexer);
+
+  return has_error ? BIFROST_VM_ERROR_COMPILE : BIFROST_VM_ERROR_NONE;
+}
+
+BifrostVMError bfVM_compileLazyFunction(BifrostVM* self, BifrostObjFn* fn)
+{
+  const BifrostString      source     = fn->lazy_source->value;
+  const BifrostLexerParams lex_params =
+   {
+    .source = source + fn->lazy_offset,
+    .length = bfVMString_length(source) - fn->lazy_offset,
+    .vm     = self,
+   };
+
+  BifrostLexer lexer    = bfLexer_make(&lex_params);
+  lexer.current_line_no = fn->lazy_line_no;
+
+  BifrostParser parser;
+  bfParser_ctor(&parser, self, &lexer, fn->module);
+  const bool has_error = bfParser_compileFunction(&parser, fn);
+  bfParser_dtor(&parser);
+
   return has_error ? BIFROST_VM_ERROR_COMPILE : BIFROST_VM_ERROR_NONE;
 }
 
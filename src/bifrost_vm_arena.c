@@ -0,0 +1,133 @@
+/******************************************************************************/
+/*!
+ * @file   bifrost_vm_arena.c
+ * @author Shareef Abdoul-Raheem (http://blufedora.github.io/)
+ * @brief
+ *   Bump allocator for data that only lives as long as a single compile.
+ *
+ * @copyright Copyright (c) 2020-2025 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#include "bifrost_vm_arena.h"
+
+#include "bifrost/bifrost_vm.h" /* BifrostVM */
+#include "bifrost_vm_gc.h"      /* bfGC_AllocMemory */
+
+#define BF_ARENA_ALIGNMENT        16u
+#define BF_ARENA_ALIGN(size)      (((size) + (BF_ARENA_ALIGNMENT - 1u)) & ~(size_t)(BF_ARENA_ALIGNMENT - 1u))
+#define BF_ARENA_MIN_BLOCK_SIZE   (16u * 1024u)
+#define BF_ARENA_BLOCK_DATA(b)    ((unsigned char*)(b) + BF_ARENA_ALIGN(sizeof(BifrostVMArenaBlock)))
+
+struct BifrostVMArenaBlock
+{
+  BifrostVMArenaBlock* prev;
+  size_t               capacity; /*!< Number of bytes of data after the header. */
+  size_t               used;
+};
+
+static void* bfVMArena__systemAlloc(BifrostVM* vm, void* ptr, size_t old_size, size_t new_size)
+{
+  /* NOTE(SR): Compiling should never be what kicks off a collection. */
+  const bool gc_was_running = vm->gc_is_running;
+
+  vm->gc_is_running  = true;
+  void* const result = bfGC_AllocMemory(vm, ptr, old_size, new_size);
+  vm->gc_is_running  = gc_was_running;
+
+  return result;
+}
+
+void bfVMArena_ctor(BifrostVMArena* self, BifrostVM* vm)
+{
+  self->vm              = vm;
+  self->current_block   = NULL;
+  self->last_allocation = NULL;
+}
+
+void* bfVMArena_alloc(BifrostVMArena* self, size_t size)
+{
+  BifrostVMArenaBlock* block = self->current_block;
+
+  size = BF_ARENA_ALIGN(size);
+
+  if (!block || block->capacity - block->used < size)
+  {
+    const size_t capacity = size > BF_ARENA_MIN_BLOCK_SIZE ? size : BF_ARENA_MIN_BLOCK_SIZE;
+
+    block = bfVMArena__systemAlloc(self->vm, NULL, 0u, BF_ARENA_ALIGN(sizeof(BifrostVMArenaBlock)) + capacity);
+
+    if (!block)
+    {
+      return NULL;
+    }
+
+    block->prev         = self->current_block;
+    block->capacity     = capacity;
+    block->used         = 0u;
+    self->current_block = block;
+  }
+
+  void* const result = BF_ARENA_BLOCK_DATA(block) + block->used;
+
+  block->used += size;
+  self->last_allocation = result;
+
+  return result;
+}
+
+void* bfVMArena_realloc(BifrostVMArena* self, void* ptr, size_t old_size, size_t new_size)
+{
+  BifrostVMArenaBlock* const block = self->current_block;
+
+  if (!ptr)
+  {
+    return bfVMArena_alloc(self, new_size);
+  }
+
+  /* The most recent allocation just moves the bump pointer. */
+  if (ptr == self->last_allocation)
+  {
+    const size_t offset = (unsigned char*)ptr - BF_ARENA_BLOCK_DATA(block);
+
+    if (offset + BF_ARENA_ALIGN(new_size) <= block->capacity)
+    {
+      block->used = offset + BF_ARENA_ALIGN(new_size);
+      return ptr;
+    }
+  }
+
+  if (new_size <= old_size)
+  {
+    return ptr;
+  }
+
+  void* const result = bfVMArena_alloc(self, new_size);
+
+  if (result)
+  {
+    LibC_memcpy(result, ptr, old_size);
+  }
+
+  return result;
+}
+
+void bfVMArena_dtor(BifrostVMArena* self)
+{
+  BifrostVMArenaBlock* block = self->current_block;
+
+  while (block)
+  {
+    BifrostVMArenaBlock* const prev = block->prev;
+
+    bfVMArena__systemAlloc(self->vm, block, BF_ARENA_ALIGN(sizeof(BifrostVMArenaBlock)) + block->capacity, 0u);
+    block = prev;
+  }
+
+  self->current_block   = NULL;
+  self->last_allocation = NULL;
+}
+
+#undef BF_ARENA_ALIGNMENT
+#undef BF_ARENA_ALIGN
+#undef BF_ARENA_MIN_BLOCK_SIZE
+#undef BF_ARENA_BLOCK_DATA
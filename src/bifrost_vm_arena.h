@@ -0,0 +1,43 @@
+/******************************************************************************/
+/*!
+ * @file   bifrost_vm_arena.h
+ * @author Shareef Abdoul-Raheem (http://blufedora.github.io/)
+ * @brief
+ *   Bump allocator for data that only lives as long as a single compile.
+ *
+ *   Allocations are never freed individually, all of the memory is
+ *   released at once in 'bfVMArena_dtor'.
+ *
+ * @copyright Copyright (c) 2020-2025 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef BIFROST_VM_ARENA_H
+#define BIFROST_VM_ARENA_H
+
+#include "bifrost_libc.h" /* size_t */
+
+#if __cplusplus
+extern "C" {
+#endif
+
+typedef struct BifrostVM           BifrostVM;
+typedef struct BifrostVMArenaBlock BifrostVMArenaBlock;
+
+typedef struct BifrostVMArena
+{
+  BifrostVM*           vm;
+  BifrostVMArenaBlock* current_block;
+  void*                last_allocation; /*!< Only the most recent allocation can be grown in place. */
+
+} BifrostVMArena;
+
+void  bfVMArena_ctor(BifrostVMArena* self, BifrostVM* vm);
+void* bfVMArena_alloc(BifrostVMArena* self, size_t size);
+void* bfVMArena_realloc(BifrostVMArena* self, void* ptr, size_t old_size, size_t new_size);
+void  bfVMArena_dtor(BifrostVMArena* self);
+
+#if __cplusplus
+}
+#endif
+
+#endif /* BIFROST_VM_ARENA_H */
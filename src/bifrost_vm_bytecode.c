@@ -0,0 +1,2002 @@
+/******************************************************************************/
+/*!
+ * @file   bifrost_vm_bytecode.c
+ * @author Shareef Abdoul-Raheem (http://blufedora.github.io/)
+ * @brief
+ *   Serializes a compiled module into a self contained binary image so
+ *   that loading it later skips the lexer and parser entirely.
+ *
+ * @copyright Copyright (c) 2020-2025 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#include "bifrost_vm_bytecode.h"
+
+#include "bifrost_vm_arena.h"          /* BifrostVMArena  */
+#include "bifrost_vm_gc.h"             /* BifrostGCRoot   */
+#include "bifrost_vm_instruction_op.h" /* bfInstruction   */
+#include "bifrost_vm_obj.h"            /* BifrostObj*     */
+#include "bifrost_vm_value.h"          /* bfVMValue_*     */
+
+extern uint32_t          bfVM_getSymbol(BifrostVM* self, string_range name);
+extern BifrostObjModule* bfVM_importModule(BifrostVM* self, const char* from, const char* name, size_t name_len);
+extern BifrostVMError    bfVM_compileLazyFunction(BifrostVM* self, BifrostObjFn* fn);
+
+#define BF_BYTECODE_MAGIC       "BFSC"
+#define BF_BYTECODE_MAGIC_SIZE  4u
+#define BF_BYTECODE_HEADER_SIZE 16u
+#define BF_BYTECODE_NO_SYMBOL   0xFFFFFFFFu
+#define BF_BYTECODE_BUFFER_SIZE 4096u
+#define BF_BYTECODE_OBJECT_SIZE 8u
+#define BF_BYTECODE_NUM_OPS     (BIFROST_VM_OP_RETURN + 1)
+
+typedef enum bfBytecodeValueTag
+{
+  BF_BYTECODE_VALUE_NULL,
+  BF_BYTECODE_VALUE_TRUE,
+  BF_BYTECODE_VALUE_FALSE,
+  BF_BYTECODE_VALUE_NUMBER,         /*!< u64 bit pattern of the double.            */
+  BF_BYTECODE_VALUE_STRING,         /*!< str, in the object table a data offset.     */
+  BF_BYTECODE_VALUE_FUNCTION,       /*!< u32 index into the prototypes.             */
+  BF_BYTECODE_VALUE_CLASS,          /*!< u32 index into the prototypes.             */
+  BF_BYTECODE_VALUE_EXTERNAL,       /*!< u32 index into the externals.              */
+  BF_BYTECODE_VALUE_CURRENT_MODULE, /*!< The module the image is being loaded into. */
+
+} bfBytecodeValueTag;
+
+typedef struct bfBytecodeObjRef
+{
+  uint32_t tag;
+  uint32_t index;
+
+} bfBytecodeObjRef;
+
+typedef struct bfBytecodeExternal
+{
+  BifrostObjModule* module;
+  uint32_t          symbol; /*!< The vm symbol of a variable of [module] or 'BF_BYTECODE_NO_SYMBOL' for the module itself. */
+
+} bfBytecodeExternal;
+
+typedef struct bfBytecodeWriter
+{
+  BifrostVM*          vm;
+  BifrostObjModule*   module;
+  BifrostVMArena      arena;
+  BifrostHashMap      obj_to_ref; /*!< Every object in the module that is not written inline to its 'bfBytecodeObjRef'. */
+  BifrostObjFn**      fns;
+  BifrostObjClass**   classes;
+  bfBytecodeExternal* externals;
+  uint32_t*           symbols;      /*!< Image symbol to vm symbol.               */
+  uint32_t*           symbol_remap; /*!< vm symbol to 'image symbol + 1', 0 if unused. */
+  uint8_t*            data;         /*!< The data section, built before anything is written since the stream refers into it. */
+  bfBytecodeObjRef*   objects;      /*!< Object table of the function currently being added to [data]. */
+  bfBytecodeWriteFn   write_fn;
+  void*               user_data;
+  size_t              buffer_size;
+  uint8_t             buffer[BF_BYTECODE_BUFFER_SIZE];
+
+} bfBytecodeWriter;
+
+typedef struct bfBytecodeReader
+{
+  BifrostVM*        vm;
+  BifrostObjModule* module;
+  const uint8_t*    image;
+  uint32_t          data_end; /*!< The data section is [BF_BYTECODE_HEADER_SIZE, data_end). */
+  const uint8_t*    cursor;
+  const uint8_t*    end;
+  bool              has_error;
+  bool              is_stale; /*!< A module whose constants were inlined has changed them since the image was saved. */
+  BifrostVMImage*   mapped;   /*!< Non NULL when the functions execute straight out of [image]. */
+  uint32_t*         symbols;  /*!< Image symbol to vm symbol. */
+  uint32_t          num_symbols;
+  uint32_t*         globals;  /*!< Image module slot to the slot in [module]. */
+  uint32_t          num_globals;
+  BifrostValue*     externals;
+  uint32_t          num_externals;
+  BifrostObjFn**    fns;
+  BifrostVMImageFn* records;
+  uint32_t          num_fns;
+  BifrostObjClass** classes;
+  uint32_t          num_classes;
+
+} bfBytecodeReader;
+
+static unsigned bfBytecode__hashPtr(const void* key)
+{
+  const uintptr_t bits = (uintptr_t)key;
+
+  return (unsigned)(bits >> 4u) ^ (unsigned)(bits >> 16u);
+}
+
+static int bfBytecode__cmpPtr(const void* lhs, const void* rhs)
+{
+  return lhs == rhs;
+}
+
+static uint64_t bfBytecode__numberBits(double value)
+{
+  uint64_t bits;
+  LibC_memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static double bfBytecode__bitsNumber(uint64_t bits)
+{
+  double value;
+  LibC_memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+static void bfBytecode__storeU32(uint8_t* dst, uint32_t value)
+{
+  dst[0] = (uint8_t)value;
+  dst[1] = (uint8_t)(value >> 8u);
+  dst[2] = (uint8_t)(value >> 16u);
+  dst[3] = (uint8_t)(value >> 24u);
+}
+
+static void bfBytecode__storeU64(uint8_t* dst, uint64_t value)
+{
+  bfBytecode__storeU32(dst, (uint32_t)value);
+  bfBytecode__storeU32(dst + 4u, (uint32_t)(value >> 32u));
+}
+
+static uint32_t bfBytecode__loadU32(const uint8_t* src)
+{
+  return (uint32_t)src[0] | ((uint32_t)src[1] << 8u) | ((uint32_t)src[2] << 16u) | ((uint32_t)src[3] << 24u);
+}
+
+static uint64_t bfBytecode__loadU64(const uint8_t* src)
+{
+  return (uint64_t)bfBytecode__loadU32(src) | ((uint64_t)bfBytecode__loadU32(src + 4u) << 32u);
+}
+
+static bool bfBytecode__isLittleEndian(void)
+{
+  const uint16_t probe = 1u;
+  uint8_t        first_byte;
+
+  LibC_memcpy(&first_byte, &probe, sizeof(first_byte));
+
+  return first_byte == 1u;
+}
+
+/* NOTE(SR): Functions running out of a mapped image may have string constants that were never materialized. */
+static BifrostValue bfBytecode__fnConstant(BifrostVM* vm, BifrostObjFn* fn, size_t index)
+{
+  const BifrostValue value = fn->constants[index];
+
+  return bfBytecode_isObjectConstant(value) ? bfBytecode_materialize(vm, fn, value) : value;
+}
+
+static uint32_t bfBytecode__fnSymbol(const BifrostObjFn* fn, uint32_t symbol)
+{
+  return fn->image ? fn->image->symbols[symbol] : symbol;
+}
+
+bool bfBytecode_isImage(const char* data, size_t data_size)
+{
+  return data_size >= BF_BYTECODE_MAGIC_SIZE && LibC_memcmp(data, BF_BYTECODE_MAGIC, BF_BYTECODE_MAGIC_SIZE) == 0;
+}
+
+/* Writer */
+
+static void bfBytecode__flush(bfBytecodeWriter* self)
+{
+  if (self->buffer_size)
+  {
+    self->write_fn(self->user_data, self->buffer, self->buffer_size);
+    self->buffer_size = 0u;
+  }
+}
+
+static void bfBytecode__writeBytes(bfBytecodeWriter* self, const void* data, size_t size)
+{
+  if (self->buffer_size + size > BF_BYTECODE_BUFFER_SIZE)
+  {
+    bfBytecode__flush(self);
+
+    if (size > BF_BYTECODE_BUFFER_SIZE)
+    {
+      self->write_fn(self->user_data, data, size);
+      return;
+    }
+  }
+
+  LibC_memcpy(self->buffer + self->buffer_size, data, size);
+  self->buffer_size += size;
+}
+
+static void bfBytecode__writeU8(bfBytecodeWriter* self, uint8_t value)
+{
+  bfBytecode__writeBytes(self, &value, sizeof(value));
+}
+
+static void bfBytecode__writeU32(bfBytecodeWriter* self, uint32_t value)
+{
+  uint8_t bytes[sizeof(value)];
+
+  bfBytecode__storeU32(bytes, value);
+  bfBytecode__writeBytes(self, bytes, sizeof(bytes));
+}
+
+static void bfBytecode__writeU64(bfBytecodeWriter* self, uint64_t value)
+{
+  bfBytecode__writeU32(self, (uint32_t)value);
+  bfBytecode__writeU32(self, (uint32_t)(value >> 32u));
+}
+
+static void bfBytecode__writeStr(bfBytecodeWriter* self, ConstBifrostString str)
+{
+  const size_t length = bfVMString_length(str);
+
+  bfBytecode__writeU32(self, (uint32_t)length);
+  bfBytecode__writeBytes(self, str, length);
+}
+
+static uint32_t bfBytecode__imageSymbol(bfBytecodeWriter* self, uint32_t vm_symbol)
+{
+  uint32_t* const remap = self->symbol_remap + vm_symbol;
+
+  if (!*remap)
+  {
+    bfVMArray_push(self->vm, &self->symbols, &vm_symbol);
+    *remap = (uint32_t)bfVMArray_size(&self->symbols);
+  }
+
+  return *remap - 1u;
+}
+
+static uint32_t bfBytecode__fieldSymbol(bfBytecodeWriter* self, ConstBifrostString name)
+{
+  return bfBytecode__imageSymbol(self, bfVM_getSymbol(self->vm, MakeStringLen(name, bfVMString_length(name))));
+}
+
+static void bfBytecode__addRef(bfBytecodeWriter* self, const BifrostObj* obj, uint32_t tag, uint32_t index)
+{
+  bfBytecodeObjRef ref;
+  ref.tag   = tag;
+  ref.index = index;
+
+  bfHashMap_set(&self->obj_to_ref, obj, &ref);
+}
+
+static bool bfBytecode__addExternal(bfBytecodeWriter* self, const BifrostObj* obj)
+{
+  bfHashMapFor(it, &self->vm->modules)
+  {
+    BifrostObjModule* const module = *(BifrostObjModule**)it.value;
+
+    if (module == self->module)
+    {
+      continue;
+    }
+
+    uint32_t symbol = BF_BYTECODE_NO_SYMBOL;
+
+    if (obj != &module->super)
+    {
+      const size_t num_variables = bfVMArray_size(&module->variables);
+
+      for (size_t i = 0; i < num_variables; ++i)
+      {
+        const BifrostVMSymbol* const variable = module->variables + i;
+
+        if (bfVMValue_isPointer(variable->value) && BIFROST_AS_OBJ(variable->value) == obj)
+        {
+          symbol = bfVM_getSymbol(self->vm, MakeStringLen(variable->name, bfVMString_length(variable->name)));
+          break;
+        }
+      }
+
+      if (symbol == BF_BYTECODE_NO_SYMBOL)
+      {
+        continue;
+      }
+    }
+
+    bfBytecodeExternal* const external = bfVMArray_emplace(self->vm, &self->externals);
+    external->module                   = module;
+    external->symbol                   = symbol;
+
+    bfBytecode__addRef(self, obj, BF_BYTECODE_VALUE_EXTERNAL, (uint32_t)bfVMArray_size(&self->externals) - 1u);
+    return true;
+  }
+
+  switch (obj->type & BifrostVMObjType_mask)
+  {
+    /* NOTE(SR): Runtime state is recreated by the module's init function when the image is loaded. */
+    case BIFROST_VM_OBJ_INSTANCE:
+    case BIFROST_VM_OBJ_REFERENCE:
+    case BIFROST_VM_OBJ_WEAK_REF:
+    {
+      bfBytecode__addRef(self, obj, BF_BYTECODE_VALUE_NULL, 0u);
+      return true;
+    }
+    default:
+    {
+      bfVM_SetLastError(BIFROST_VM_ERROR_INVALID_ARGUMENT, self->vm, -1, "Bytecode: a value in module '%s' is neither declared in it nor in any other loaded module.", self->module->name);
+      return false;
+    }
+  }
+}
+
+static bool bfBytecode__visitValue(bfBytecodeWriter* self, BifrostValue value)
+{
+  if (!bfVMValue_isPointer(value))
+  {
+    return true;
+  }
+
+  BifrostObj* const obj = BIFROST_AS_OBJ(value);
+
+  if (bfHashMap_get(&self->obj_to_ref, obj))
+  {
+    return true;
+  }
+
+  switch (obj->type & BifrostVMObjType_mask)
+  {
+    case BIFROST_VM_OBJ_STRING:
+    {
+      return true;
+    }
+    case BIFROST_VM_OBJ_MODULE:
+    {
+      if (obj == &self->module->super)
+      {
+        return true;
+      }
+      break;
+    }
+    case BIFROST_VM_OBJ_FUNCTION:
+    {
+      BifrostObjFn* const fn = (BifrostObjFn*)obj;
+
+      if (fn->module == self->module)
+      {
+        bfVMArray_push(self->vm, &self->fns, &fn);
+        bfBytecode__addRef(self, obj, BF_BYTECODE_VALUE_FUNCTION, (uint32_t)bfVMArray_size(&self->fns) - 1u);
+        return true;
+      }
+      break;
+    }
+    case BIFROST_VM_OBJ_CLASS:
+    {
+      BifrostObjClass* const clz = (BifrostObjClass*)obj;
+
+      if (clz->module == self->module)
+      {
+        bfVMArray_push(self->vm, &self->classes, &clz);
+        bfBytecode__addRef(self, obj, BF_BYTECODE_VALUE_CLASS, (uint32_t)bfVMArray_size(&self->classes) - 1u);
+        return true;
+      }
+      break;
+    }
+      InvalidDefaultCase;
+  }
+
+  return bfBytecode__addExternal(self, obj);
+}
+
+static bool bfBytecode__visitSymbols(bfBytecodeWriter* self, const BifrostVMSymbol* symbols)
+{
+  const size_t num_symbols = bfVMArray_size(&symbols);
+
+  for (size_t i = 0; i < num_symbols; ++i)
+  {
+    if (symbols[i].name && !bfBytecode__visitValue(self, symbols[i].value))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+  NOTE(SR):
+    Walks everything reachable from the module to assign each object an index,
+    function bodies that are still lazy get compiled along the way since their
+    constants are only known afterwards.
+*/
+static BifrostVMError bfBytecode__gatherObjects(bfBytecodeWriter* self)
+{
+  BifrostObjFn* const init_fn = &self->module->init_fn;
+
+  bfVMArray_push(self->vm, &self->fns, &init_fn);
+
+  if (!bfBytecode__visitSymbols(self, self->module->variables))
+  {
+    return BIFROST_VM_ERROR_INVALID_ARGUMENT;
+  }
+
+  size_t fn_index  = 0;
+  size_t clz_index = 0;
+
+  while (fn_index < bfVMArray_size(&self->fns) || clz_index < bfVMArray_size(&self->classes))
+  {
+    for (; fn_index < bfVMArray_size(&self->fns); ++fn_index)
+    {
+      BifrostObjFn* const fn = self->fns[fn_index];
+
+      if (fn->lazy_source && bfVM_compileLazyFunction(self->vm, fn))
+      {
+        return BIFROST_VM_ERROR_COMPILE;
+      }
+
+      const size_t num_constants = bfObjFn_numConstants(fn);
+
+      for (size_t i = 0; i < num_constants; ++i)
+      {
+        if (!bfBytecode__visitValue(self, bfBytecode__fnConstant(self->vm, fn, i)))
+        {
+          return BIFROST_VM_ERROR_INVALID_ARGUMENT;
+        }
+      }
+    }
+
+    for (; clz_index < bfVMArray_size(&self->classes); ++clz_index)
+    {
+      const BifrostObjClass* const clz = self->classes[clz_index];
+
+      if ((clz->base_clz && !bfBytecode__visitValue(self, bfVMValue_fromPointer(clz->base_clz))) ||
+          !bfBytecode__visitSymbols(self, clz->symbols) ||
+          !bfBytecode__visitSymbols(self, clz->field_initializers))
+      {
+        return BIFROST_VM_ERROR_INVALID_ARGUMENT;
+      }
+    }
+  }
+
+  return BIFROST_VM_ERROR_NONE;
+}
+
+static void bfBytecode__gatherSymbols(bfBytecodeWriter* self)
+{
+  const size_t num_vm_symbols = bfVMArray_size(&self->vm->symbols);
+
+  self->symbol_remap = bfVMArena_alloc(&self->arena, sizeof(uint32_t) * (num_vm_symbols + 1u));
+  LibC_memset(self->symbol_remap, 0x0, sizeof(uint32_t) * (num_vm_symbols + 1u));
+
+  /*
+    NOTE(SR):
+      Symbols used by instructions go first, they were 9 bit vm ids so
+      there are few enough of them to still fit in the instruction.
+  */
+  const size_t num_fns = bfVMArray_size(&self->fns);
+
+  for (size_t i = 0; i < num_fns; ++i)
+  {
+    const BifrostObjFn* const fn        = self->fns[i];
+    const size_t              num_insts = bfObjFn_numInstructions(fn);
+
+    for (size_t j = 0; j < num_insts; ++j)
+    {
+      const bfInstruction inst = fn->instructions[j];
+
+      switch (bfInst_getX(inst, OP))
+      {
+        case BIFROST_VM_OP_LOAD_SYMBOL:
+          bfBytecode__imageSymbol(self, bfBytecode__fnSymbol(fn, bfInst_getX(inst, RC)));
+          break;
+        case BIFROST_VM_OP_STORE_SYMBOL:
+          bfBytecode__imageSymbol(self, bfBytecode__fnSymbol(fn, bfInst_getX(inst, RB)));
+          break;
+          InvalidDefaultCase;
+      }
+    }
+  }
+
+  const size_t num_externals = bfVMArray_size(&self->externals);
+
+  for (size_t i = 0; i < num_externals; ++i)
+  {
+    if (self->externals[i].symbol != BF_BYTECODE_NO_SYMBOL)
+    {
+      bfBytecode__imageSymbol(self, self->externals[i].symbol);
+    }
+  }
+
+  const size_t num_classes = bfVMArray_size(&self->classes);
+
+  for (size_t i = 0; i < num_classes; ++i)
+  {
+    const BifrostObjClass* const clz         = self->classes[i];
+    const size_t                 num_symbols = bfVMArray_size(&clz->symbols);
+    const size_t                 num_fields  = bfVMArray_size(&clz->field_initializers);
+
+    for (size_t j = 0; j < num_symbols; ++j)
+    {
+      bfBytecode__fieldSymbol(self, clz->symbols[j].name);
+    }
+
+    for (size_t j = 0; j < num_fields; ++j)
+    {
+      bfBytecode__fieldSymbol(self, clz->field_initializers[j].name);
+    }
+  }
+
+  const size_t num_variables = bfVMArray_size(&self->module->variables);
+
+  for (size_t i = 0; i < num_variables; ++i)
+  {
+    bfBytecode__fieldSymbol(self, self->module->variables[i].name);
+  }
+}
+
+static bfBytecodeObjRef bfBytecode__objRef(bfBytecodeWriter* self, const BifrostObj* obj)
+{
+  bfBytecodeObjRef ref;
+  ref.index = 0u;
+
+  if ((obj->type & BifrostVMObjType_mask) == BIFROST_VM_OBJ_STRING)
+  {
+    ref.tag = BF_BYTECODE_VALUE_STRING;
+  }
+  else if (obj == &self->module->super)
+  {
+    ref.tag = BF_BYTECODE_VALUE_CURRENT_MODULE;
+  }
+  else
+  {
+    ref = *(const bfBytecodeObjRef*)bfHashMap_get(&self->obj_to_ref, obj);
+  }
+
+  return ref;
+}
+
+static void bfBytecode__writeValue(bfBytecodeWriter* self, BifrostValue value)
+{
+  if (bfVMValue_isNumber(value))
+  {
+    bfBytecode__writeU8(self, BF_BYTECODE_VALUE_NUMBER);
+    bfBytecode__writeU64(self, bfBytecode__numberBits(bfVMValue_asNumber(value)));
+  }
+  else if (bfVMValue_isBool(value))
+  {
+    bfBytecode__writeU8(self, bfVMValue_isTrue(value) ? BF_BYTECODE_VALUE_TRUE : BF_BYTECODE_VALUE_FALSE);
+  }
+  else if (bfVMValue_isPointer(value))
+  {
+    const BifrostObj* const obj = BIFROST_AS_OBJ(value);
+    const bfBytecodeObjRef  ref = bfBytecode__objRef(self, obj);
+
+    bfBytecode__writeU8(self, (uint8_t)ref.tag);
+
+    switch (ref.tag)
+    {
+      case BF_BYTECODE_VALUE_STRING:
+        bfBytecode__writeStr(self, ((const BifrostObjStr*)obj)->value);
+        break;
+      case BF_BYTECODE_VALUE_FUNCTION:
+      case BF_BYTECODE_VALUE_CLASS:
+      case BF_BYTECODE_VALUE_EXTERNAL:
+        bfBytecode__writeU32(self, ref.index);
+        break;
+        InvalidDefaultCase;
+    }
+  }
+  else
+  {
+    bfBytecode__writeU8(self, BF_BYTECODE_VALUE_NULL);
+  }
+}
+
+static void bfBytecode__writeSymbols(bfBytecodeWriter* self, const BifrostVMSymbol* symbols)
+{
+  const size_t num_symbols = bfVMArray_size(&symbols);
+
+  bfBytecode__writeU32(self, (uint32_t)num_symbols);
+
+  for (size_t i = 0; i < num_symbols; ++i)
+  {
+    bfBytecode__writeU32(self, bfBytecode__fieldSymbol(self, symbols[i].name));
+    bfBytecode__writeValue(self, symbols[i].value);
+  }
+}
+
+/* Returns the offset from the start of the image of [size] zeroed bytes in the data section. */
+static uint32_t bfBytecode__dataAlloc(bfBytecodeWriter* self, size_t size, size_t alignment)
+{
+  const size_t old_size = bfVMArray_size(&self->data);
+  const size_t offset   = (old_size + alignment - 1u) & ~(alignment - 1u);
+
+  bfVMArray_resize(self->vm, &self->data, offset + size);
+  LibC_memset(self->data + old_size, 0x0, offset + size - old_size);
+
+  return (uint32_t)(BF_BYTECODE_HEADER_SIZE + offset);
+}
+
+/* NOTE(SR): Any 'bfBytecode__dataAlloc' may move the data section, so pointers are fetched again after one. */
+static uint8_t* bfBytecode__dataAt(bfBytecodeWriter* self, uint32_t offset)
+{
+  return self->data + (offset - BF_BYTECODE_HEADER_SIZE);
+}
+
+static uint32_t bfBytecode__writeDataStr(bfBytecodeWriter* self, ConstBifrostString str)
+{
+  const size_t   length = bfVMString_length(str);
+  const uint32_t offset = bfBytecode__dataAlloc(self, sizeof(uint32_t) + length, sizeof(uint32_t));
+  uint8_t* const dst    = bfBytecode__dataAt(self, offset);
+
+  bfBytecode__storeU32(dst, (uint32_t)length);
+  LibC_memcpy(dst + sizeof(uint32_t), str, length);
+
+  return offset;
+}
+
+static uint32_t bfBytecode__writeFunctionData(bfBytecodeWriter* self, BifrostObjFn* fn)
+{
+  BifrostVMImageFn record;
+
+  record.num_instructions = (uint32_t)bfObjFn_numInstructions(fn);
+  record.num_constants    = (uint32_t)bfObjFn_numConstants(fn);
+  record.line_table_size  = self->vm->params.strip_debug_info ? 0u : fn->line_table_size;
+  record.num_objects      = 0u;
+  record.num_ctor_sites   = fn->ctor_sites ? (uint32_t)bfVMArray_size(&fn->ctor_sites) : 0u;
+
+  const uint32_t record_offset = bfBytecode__dataAlloc(self, sizeof(BifrostVMImageFn), sizeof(uint32_t));
+
+  record.instructions = bfBytecode__dataAlloc(self, sizeof(bfInstruction) * record.num_instructions, sizeof(bfInstruction));
+
+  for (uint32_t i = 0; i < record.num_instructions; ++i)
+  {
+    bfInstruction inst = fn->instructions[i];
+
+    switch (bfInst_getX(inst, OP))
+    {
+      case BIFROST_VM_OP_LOAD_SYMBOL:
+        bfInst_patchX(&inst, RC, bfBytecode__imageSymbol(self, bfBytecode__fnSymbol(fn, bfInst_getX(inst, RC))));
+        break;
+      case BIFROST_VM_OP_STORE_SYMBOL:
+        bfInst_patchX(&inst, RB, bfBytecode__imageSymbol(self, bfBytecode__fnSymbol(fn, bfInst_getX(inst, RB))));
+        break;
+        InvalidDefaultCase;
+    }
+
+    bfBytecode__storeU32(bfBytecode__dataAt(self, record.instructions) + sizeof(bfInstruction) * i, inst);
+  }
+
+  record.line_table = bfBytecode__dataAlloc(self, record.line_table_size, sizeof(uint8_t));
+
+  if (record.line_table_size)
+  {
+    LibC_memcpy(bfBytecode__dataAt(self, record.line_table), fn->line_table, record.line_table_size);
+  }
+
+  record.constants = bfBytecode__dataAlloc(self, sizeof(BifrostValue) * record.num_constants, sizeof(BifrostValue));
+  bfVMArray_clear(&self->objects);
+
+  for (uint32_t i = 0; i < record.num_constants; ++i)
+  {
+    BifrostValue value = bfBytecode__fnConstant(self->vm, fn, i);
+
+    /* NOTE(SR): Immediates are stored as is so they can be loaded from a mapped image directly. */
+    if (bfVMValue_isPointer(value))
+    {
+      const BifrostObj* const obj = BIFROST_AS_OBJ(value);
+      bfBytecodeObjRef        ref = bfBytecode__objRef(self, obj);
+
+      if (ref.tag == BF_BYTECODE_VALUE_NULL)
+      {
+        value = bfVMValue_fromNull();
+      }
+      else
+      {
+        if (ref.tag == BF_BYTECODE_VALUE_STRING)
+        {
+          ref.index = bfBytecode__writeDataStr(self, ((const BifrostObjStr*)obj)->value);
+        }
+
+        bfVMArray_push(self->vm, &self->objects, &ref);
+        value = bfBytecode_makeObjectConstant(record.num_objects++);
+      }
+    }
+
+    bfBytecode__storeU64(bfBytecode__dataAt(self, record.constants) + sizeof(BifrostValue) * i, value);
+  }
+
+  record.objects = bfBytecode__dataAlloc(self, BF_BYTECODE_OBJECT_SIZE * record.num_objects, sizeof(uint32_t));
+
+  for (uint32_t i = 0; i < record.num_objects; ++i)
+  {
+    uint8_t* const dst = bfBytecode__dataAt(self, record.objects) + BF_BYTECODE_OBJECT_SIZE * i;
+
+    bfBytecode__storeU32(dst, self->objects[i].tag);
+    bfBytecode__storeU32(dst + sizeof(uint32_t), self->objects[i].index);
+  }
+
+  record.ctor_sites = bfBytecode__dataAlloc(self, sizeof(uint32_t) * record.num_ctor_sites, sizeof(uint32_t));
+
+  for (uint32_t i = 0; i < record.num_ctor_sites; ++i)
+  {
+    bfBytecode__storeU32(bfBytecode__dataAt(self, record.ctor_sites) + sizeof(uint32_t) * i, bfBytecode__imageSymbol(self, fn->ctor_sites[i].symbol));
+  }
+
+  const uint32_t fields[] =
+   {
+    record.num_instructions,
+    record.num_constants,
+    record.line_table_size,
+    record.num_objects,
+    record.num_ctor_sites,
+    record.instructions,
+    record.constants,
+    record.line_table,
+    record.objects,
+    record.ctor_sites,
+   };
+
+  for (uint32_t i = 0; i < sizeof(fields) / sizeof(fields[0]); ++i)
+  {
+    bfBytecode__storeU32(bfBytecode__dataAt(self, record_offset) + sizeof(uint32_t) * i, fields[i]);
+  }
+
+  return record_offset;
+}
+
+static void bfBytecode__writeImage(bfBytecodeWriter* self)
+{
+  const size_t    num_fns    = bfVMArray_size(&self->fns);
+  uint32_t* const fn_records = bfVMArena_alloc(&self->arena, sizeof(uint32_t) * num_fns);
+
+  for (size_t i = 0; i < num_fns; ++i)
+  {
+    fn_records[i] = bfBytecode__writeFunctionData(self, self->fns[i]);
+  }
+
+  const size_t data_size = bfVMArray_size(&self->data);
+
+  bfBytecode__writeBytes(self, BF_BYTECODE_MAGIC, BF_BYTECODE_MAGIC_SIZE);
+  bfBytecode__writeU32(self, BIFROST_VM_BYTECODE_VERSION);
+  bfBytecode__writeU32(self, self->vm->params.strip_debug_info ? BIFROST_VM_BYTECODE_FLAG_STRIPPED : 0u);
+  bfBytecode__writeU32(self, (uint32_t)(BF_BYTECODE_HEADER_SIZE + data_size));
+  bfBytecode__writeBytes(self, self->data, data_size);
+
+  const size_t num_const_imports = bfVMArray_size(&self->module->const_imports);
+
+  bfBytecode__writeU32(self, (uint32_t)num_const_imports);
+
+  for (size_t i = 0; i < num_const_imports; ++i)
+  {
+    bfBytecode__writeStr(self, self->vm->symbols[self->module->const_imports[i].module_symbol]);
+    bfBytecode__writeU64(self, self->module->const_imports[i].const_hash);
+  }
+
+  const size_t num_symbols = bfVMArray_size(&self->symbols);
+
+  bfBytecode__writeU32(self, (uint32_t)num_symbols);
+
+  for (size_t i = 0; i < num_symbols; ++i)
+  {
+    bfBytecode__writeStr(self, self->vm->symbols[self->symbols[i]]);
+  }
+
+  const size_t num_variables = bfVMArray_size(&self->module->variables);
+
+  bfBytecode__writeU32(self, (uint32_t)num_variables);
+
+  for (size_t i = 0; i < num_variables; ++i)
+  {
+    bfBytecode__writeU32(self, bfBytecode__fieldSymbol(self, self->module->variables[i].name));
+  }
+
+  const size_t num_externals = bfVMArray_size(&self->externals);
+
+  bfBytecode__writeU32(self, (uint32_t)num_externals);
+
+  for (size_t i = 0; i < num_externals; ++i)
+  {
+    const bfBytecodeExternal* const external = self->externals + i;
+
+    bfBytecode__writeStr(self, external->module->name);
+    bfBytecode__writeU32(self, external->symbol == BF_BYTECODE_NO_SYMBOL ? BF_BYTECODE_NO_SYMBOL : bfBytecode__imageSymbol(self, external->symbol));
+  }
+
+  const size_t num_classes = bfVMArray_size(&self->classes);
+
+  bfBytecode__writeU32(self, (uint32_t)num_fns);
+
+  for (size_t i = 0; i < num_fns; ++i)
+  {
+    const BifrostObjFn* const fn = self->fns[i];
+
+    bfBytecode__writeStr(self, fn->name);
+    bfBytecode__writeU32(self, (uint32_t)fn->arity);
+    bfBytecode__writeU32(self, (uint32_t)fn->needed_stack_space);
+    bfBytecode__writeU32(self, fn_records[i]);
+  }
+
+  bfBytecode__writeU32(self, (uint32_t)num_classes);
+
+  for (size_t i = 0; i < num_classes; ++i)
+  {
+    const BifrostObjClass* const clz = self->classes[i];
+
+    bfBytecode__writeStr(self, clz->name);
+    bfBytecode__writeU32(self, (uint32_t)clz->extra_data);
+  }
+
+  for (size_t i = 0; i < num_classes; ++i)
+  {
+    const BifrostObjClass* const clz        = self->classes[i];
+    const size_t                 num_fields = bfVMArray_size(&clz->field_initializers);
+
+    bfBytecode__writeValue(self, clz->base_clz ? bfVMValue_fromPointer(clz->base_clz) : bfVMValue_fromNull());
+    bfBytecode__writeSymbols(self, clz->symbols);
+    bfBytecode__writeU32(self, (uint32_t)num_fields);
+
+    for (size_t j = 0; j < num_fields; ++j)
+    {
+      bfBytecode__writeU32(self, bfBytecode__fieldSymbol(self, clz->field_initializers[j].name));
+      bfBytecode__writeValue(self, clz->field_initializers[j].value);
+    }
+  }
+
+  for (size_t i = 0; i < num_variables; ++i)
+  {
+    bfBytecode__writeValue(self, self->module->variables[i].value);
+  }
+
+  const size_t num_consts = bfVMArray_size(&self->module->const_slots);
+
+  bfBytecode__writeU32(self, (uint32_t)num_consts);
+
+  for (size_t i = 0; i < num_consts; ++i)
+  {
+    bfBytecode__writeU32(self, self->module->const_slots[i]);
+  }
+
+  bfBytecode__flush(self);
+}
+
+BifrostVMError bfBytecode_save(BifrostVM* vm, BifrostObjModule* module, bfBytecodeWriteFn write_fn, void* user_data)
+{
+  if (!module->init_fn.name)
+  {
+    bfVM_SetLastError(BIFROST_VM_ERROR_INVALID_ARGUMENT, vm, -1, "Bytecode: module '%s' has not been compiled or has already run.", module->name);
+    return BIFROST_VM_ERROR_INVALID_ARGUMENT;
+  }
+
+  BifrostHashMapParams hash_params;
+  bfHashMapParams_init(&hash_params, vm);
+  hash_params.hash       = bfBytecode__hashPtr;
+  hash_params.cmp        = bfBytecode__cmpPtr;
+  hash_params.value_size = sizeof(bfBytecodeObjRef);
+
+  bfBytecodeWriter writer;
+  bfBytecodeWriter* const self = &writer;
+
+  self->vm     = vm;
+  self->module = module;
+  bfVMArena_ctor(&self->arena, vm);
+  bfHashMap_ctor(&self->obj_to_ref, &hash_params);
+  self->fns          = bfVMArray_newArena(&self->arena, BifrostObjFn*, 16);
+  self->classes      = bfVMArray_newArena(&self->arena, BifrostObjClass*, 8);
+  self->externals    = bfVMArray_newArena(&self->arena, bfBytecodeExternal, 8);
+  self->symbols      = bfVMArray_newArena(&self->arena, uint32_t, 64);
+  self->symbol_remap = NULL;
+  self->data         = bfVMArray_newArena(&self->arena, uint8_t, BF_BYTECODE_BUFFER_SIZE);
+  self->objects      = bfVMArray_newArena(&self->arena, bfBytecodeObjRef, 16);
+  self->write_fn     = write_fn;
+  self->user_data    = user_data;
+  self->buffer_size  = 0u;
+
+  const BifrostVMError err = bfBytecode__gatherObjects(self);
+
+  if (!err)
+  {
+    bfBytecode__gatherSymbols(self);
+    bfBytecode__writeImage(self);
+  }
+
+  bfHashMap_dtor(&self->obj_to_ref);
+  bfVMArena_dtor(&self->arena);
+
+  return err;
+}
+
+/* Reader */
+
+static void bfBytecode__readError(bfBytecodeReader* self, const char* message)
+{
+  if (!self->has_error)
+  {
+    bfVM_SetLastError(BIFROST_VM_ERROR_INVALID_ARGUMENT, self->vm, -1, "Bytecode: %s", message);
+  }
+
+  self->has_error = true;
+}
+
+static const uint8_t* bfBytecode__readBytes(bfBytecodeReader* self, size_t size)
+{
+  if ((size_t)(self->end - self->cursor) < size)
+  {
+    bfBytecode__readError(self, "unexpected end of image.");
+    self->cursor = self->end;
+    return NULL;
+  }
+
+  const uint8_t* const result = self->cursor;
+
+  self->cursor += size;
+
+  return result;
+}
+
+static uint8_t bfBytecode__readU8(bfBytecodeReader* self)
+{
+  const uint8_t* const bytes = bfBytecode__readBytes(self, 1u);
+
+  return bytes ? bytes[0] : 0u;
+}
+
+static uint32_t bfBytecode__readU32(bfBytecodeReader* self)
+{
+  const uint8_t* const bytes = bfBytecode__readBytes(self, 4u);
+
+  return bytes ? bfBytecode__loadU32(bytes) : 0u;
+}
+
+static uint64_t bfBytecode__readU64(bfBytecodeReader* self)
+{
+  const uint8_t* const bytes = bfBytecode__readBytes(self, 8u);
+
+  return bytes ? bfBytecode__loadU64(bytes) : 0u;
+}
+
+static string_range bfBytecode__readStr(bfBytecodeReader* self)
+{
+  const uint32_t       length = bfBytecode__readU32(self);
+  const uint8_t* const bytes  = bfBytecode__readBytes(self, length);
+
+  return MakeStringLen(bytes ? (const char*)bytes : "", bytes ? length : 0u);
+}
+
+/* NOTE(SR): Every element of a count prefixed list takes at least a byte so this rejects absurd counts before allocating. */
+static uint32_t bfBytecode__readCount(bfBytecodeReader* self)
+{
+  const uint32_t count = bfBytecode__readU32(self);
+
+  if (count > (size_t)(self->end - self->cursor))
+  {
+    bfBytecode__readError(self, "corrupt element count.");
+    return 0u;
+  }
+
+  return count;
+}
+
+/* [count] elements of the data section at [offset], NULL if that is not entirely inside of it. */
+static const uint8_t* bfBytecode__readSection(bfBytecodeReader* self, uint32_t offset, uint32_t count, size_t element_size, size_t alignment)
+{
+  if (offset < BF_BYTECODE_HEADER_SIZE || offset > self->data_end || offset % alignment != 0u || count > (self->data_end - offset) / element_size)
+  {
+    bfBytecode__readError(self, "data section reference out of range.");
+    return NULL;
+  }
+
+  return self->image + offset;
+}
+
+/* Image symbol index to the vm's symbol id. */
+static uint32_t bfBytecode__remapSymbol(bfBytecodeReader* self, uint32_t symbol)
+{
+  if (symbol >= self->num_symbols)
+  {
+    bfBytecode__readError(self, "symbol index out of range.");
+    return 0u;
+  }
+
+  return self->symbols[symbol];
+}
+
+/* NOTE(SR): Symbols are encoded in 9 bits of an instruction once patched. */
+static uint32_t bfBytecode__remapInstSymbol(bfBytecodeReader* self, uint32_t symbol)
+{
+  const uint32_t vm_symbol = bfBytecode__remapSymbol(self, symbol);
+
+  if (vm_symbol > BIFROST_INST_RC_MASK)
+  {
+    bfBytecode__readError(self, "too many symbols in the vm for this image.");
+  }
+
+  return vm_symbol;
+}
+
+static uint32_t bfBytecode__readSymbol(bfBytecodeReader* self)
+{
+  return bfBytecode__remapSymbol(self, bfBytecode__readU32(self));
+}
+
+static bool bfBytecode__checkIndex(bfBytecodeReader* self, uint32_t index, uint32_t first, uint32_t count)
+{
+  if (index < first || index >= count)
+  {
+    bfBytecode__readError(self, "object index out of range.");
+    return false;
+  }
+
+  return true;
+}
+
+static BifrostValue bfBytecode__resolveObject(bfBytecodeReader* self, uint32_t tag, uint32_t index)
+{
+  switch (tag)
+  {
+    case BF_BYTECODE_VALUE_FUNCTION:
+    {
+      /* NOTE(SR): The init function is not a value any script can refer to. */
+      return bfBytecode__checkIndex(self, index, 1u, self->num_fns) ? bfVMValue_fromPointer(self->fns[index]) : bfVMValue_fromNull();
+    }
+    case BF_BYTECODE_VALUE_CLASS:
+    {
+      return bfBytecode__checkIndex(self, index, 0u, self->num_classes) ? bfVMValue_fromPointer(self->classes[index]) : bfVMValue_fromNull();
+    }
+    case BF_BYTECODE_VALUE_EXTERNAL:
+    {
+      return bfBytecode__checkIndex(self, index, 0u, self->num_externals) ? self->externals[index] : bfVMValue_fromNull();
+    }
+    case BF_BYTECODE_VALUE_CURRENT_MODULE:
+    {
+      return bfVMValue_fromPointer(self->module);
+    }
+    default:
+    {
+      bfBytecode__readError(self, "unknown value tag.");
+      return bfVMValue_fromNull();
+    }
+  }
+}
+
+static BifrostValue bfBytecode__readValue(bfBytecodeReader* self)
+{
+  const uint8_t tag = bfBytecode__readU8(self);
+
+  switch (tag)
+  {
+    case BF_BYTECODE_VALUE_NULL:
+      return bfVMValue_fromNull();
+    case BF_BYTECODE_VALUE_TRUE:
+      return bfVMValue_fromBool(true);
+    case BF_BYTECODE_VALUE_FALSE:
+      return bfVMValue_fromBool(false);
+    case BF_BYTECODE_VALUE_NUMBER:
+      return bfVMValue_fromNumber(bfBytecode__bitsNumber(bfBytecode__readU64(self)));
+    case BF_BYTECODE_VALUE_STRING:
+    {
+      const string_range str = bfBytecode__readStr(self);
+
+      return self->has_error ? bfVMValue_fromNull() : bfVMValue_fromPointer(bfObj_NewStringVerbatim(self->vm, str));
+    }
+    case BF_BYTECODE_VALUE_FUNCTION:
+    case BF_BYTECODE_VALUE_CLASS:
+    case BF_BYTECODE_VALUE_EXTERNAL:
+    {
+      const uint32_t index = bfBytecode__readU32(self);
+
+      return self->has_error ? bfVMValue_fromNull() : bfBytecode__resolveObject(self, tag, index);
+    }
+    default:
+      return bfBytecode__resolveObject(self, tag, 0u);
+  }
+}
+
+/* Entry [index] of a function's object table, strings are left as placeholders when the image is mapped. */
+static BifrostValue bfBytecode__readObject(bfBytecodeReader* self, const BifrostVMImageFn* record, uint32_t index)
+{
+  const uint8_t* const entry   = self->image + record->objects + BF_BYTECODE_OBJECT_SIZE * index;
+  const uint32_t       tag     = bfBytecode__loadU32(entry);
+  const uint32_t       payload = bfBytecode__loadU32(entry + sizeof(uint32_t));
+
+  if (tag != BF_BYTECODE_VALUE_STRING)
+  {
+    return bfBytecode__resolveObject(self, tag, payload);
+  }
+
+  const uint8_t* const length = bfBytecode__readSection(self, payload, 1u, sizeof(uint32_t), sizeof(uint32_t));
+  const uint8_t* const str    = length ? bfBytecode__readSection(self, payload + (uint32_t)sizeof(uint32_t), bfBytecode__loadU32(length), 1u, 1u) : NULL;
+
+  if (!str)
+  {
+    return bfVMValue_fromNull();
+  }
+
+  if (self->mapped)
+  {
+    return bfBytecode_makeObjectConstant(index);
+  }
+
+  return bfVMValue_fromPointer(bfObj_NewStringVerbatim(self->vm, MakeStringLen((const char*)str, bfBytecode__loadU32(length))));
+}
+
+static void bfBytecode__readRecord(bfBytecodeReader* self, uint32_t offset, BifrostVMImageFn* out)
+{
+  const uint8_t* const record = bfBytecode__readSection(self, offset, 1u, sizeof(BifrostVMImageFn), sizeof(uint32_t));
+
+  if (!record)
+  {
+    return;
+  }
+
+  out->num_instructions = bfBytecode__loadU32(record + 0u);
+  out->num_constants    = bfBytecode__loadU32(record + 4u);
+  out->line_table_size  = bfBytecode__loadU32(record + 8u);
+  out->num_objects      = bfBytecode__loadU32(record + 12u);
+  out->num_ctor_sites   = bfBytecode__loadU32(record + 16u);
+  out->instructions     = bfBytecode__loadU32(record + 20u);
+  out->constants        = bfBytecode__loadU32(record + 24u);
+  out->line_table       = bfBytecode__loadU32(record + 28u);
+  out->objects          = bfBytecode__loadU32(record + 32u);
+  out->ctor_sites       = bfBytecode__loadU32(record + 36u);
+
+  if (out->num_instructions == 0u)
+  {
+    bfBytecode__readError(self, "function has no instructions.");
+    return;
+  }
+
+  bfBytecode__readSection(self, out->instructions, out->num_instructions, sizeof(bfInstruction), sizeof(bfInstruction));
+  bfBytecode__readSection(self, out->constants, out->num_constants, sizeof(BifrostValue), sizeof(BifrostValue));
+  const uint8_t* const line_table = bfBytecode__readSection(self, out->line_table, out->line_table_size, sizeof(uint8_t), sizeof(uint8_t));
+
+  if (line_table && out->line_table_size && !bfVMLineTable_isValid(line_table, out->line_table_size, out->num_instructions))
+  {
+    bfBytecode__readError(self, "function has a corrupt line table.");
+  }
+  bfBytecode__readSection(self, out->objects, out->num_objects, BF_BYTECODE_OBJECT_SIZE, sizeof(uint32_t));
+  bfBytecode__readSection(self, out->ctor_sites, out->num_ctor_sites, sizeof(uint32_t), sizeof(uint32_t));
+
+  if (out->num_ctor_sites > BIFROST_INST_RC_MASK + 1u)
+  {
+    bfBytecode__readError(self, "function has too many constructor sites.");
+  }
+}
+
+static void bfBytecode__readSymbols(bfBytecodeReader* self, BifrostObjClass* clz)
+{
+  const uint32_t count = bfBytecode__readCount(self);
+
+  for (uint32_t i = 0; i < count && !self->has_error; ++i)
+  {
+    const uint32_t     symbol = bfBytecode__readSymbol(self);
+    const BifrostValue value  = bfBytecode__readValue(self);
+
+    if (!self->has_error)
+    {
+      bfObjClass_setSymbol(self->vm, clz, self->vm->symbols[symbol], value);
+    }
+  }
+}
+
+/*
+  NOTE(SR):
+    The module may already have variables (a reload seeds it with the live module's
+    layout) so the image's slots are remapped, a mapped image cannot be patched
+    and needs them to line up.
+*/
+static void bfBytecode__readGlobals(bfBytecodeReader* self, BifrostVMArena* arena)
+{
+  self->num_globals = bfBytecode__readCount(self);
+  self->globals     = bfVMArena_alloc(arena, sizeof(uint32_t) * (self->num_globals + 1u));
+
+  for (uint32_t i = 0; i < self->num_globals && !self->has_error; ++i)
+  {
+    const uint32_t symbol = bfBytecode__readSymbol(self);
+
+    if (self->has_error)
+    {
+      break;
+    }
+
+    const size_t slot = bfObjModule_addSlot(self->vm, self->module, self->vm->symbols[symbol]);
+
+    if (self->mapped && slot != i)
+    {
+      bfBytecode__readError(self, "a mapped image must be loaded into an empty module.");
+      break;
+    }
+
+    self->globals[i] = (uint32_t)slot;
+  }
+}
+
+static uint32_t bfBytecode__remapGlobal(bfBytecodeReader* self, uint32_t slot)
+{
+  if (slot >= self->num_globals)
+  {
+    bfBytecode__readError(self, "module variable index out of range.");
+    return 0u;
+  }
+
+  return self->globals[slot];
+}
+
+static void bfBytecode__readExternals(bfBytecodeReader* self, BifrostVMArena* arena)
+{
+  self->num_externals = bfBytecode__readCount(self);
+  self->externals     = bfVMArena_alloc(arena, sizeof(BifrostValue) * (self->num_externals + 1u));
+
+  for (uint32_t i = 0; i < self->num_externals && !self->has_error; ++i)
+  {
+    const string_range module_name = bfBytecode__readStr(self);
+    const uint32_t     symbol      = bfBytecode__readU32(self);
+
+    if (self->has_error)
+    {
+      break;
+    }
+
+    if (symbol != BF_BYTECODE_NO_SYMBOL && symbol >= self->num_symbols)
+    {
+      bfBytecode__readError(self, "symbol index out of range.");
+      break;
+    }
+
+    BifrostObjModule* const module = bfVM_importModule(self->vm, self->module->name, module_name.str_bgn, module_name.str_len);
+
+    if (!module)
+    {
+      self->has_error = true;
+      break;
+    }
+
+    if (symbol == BF_BYTECODE_NO_SYMBOL)
+    {
+      self->externals[i] = bfVMValue_fromPointer(module);
+    }
+    else
+    {
+      const uint32_t vm_symbol = self->symbols[symbol];
+      const size_t   slot      = bfObjModule_findSlot(module, self->vm->symbols[vm_symbol]);
+
+      if (slot == BIFROST_ARRAY_INVALID_INDEX)
+      {
+        bfVM_SetLastError(BIFROST_VM_ERROR_MODULE_NOT_FOUND, self->vm, -1, "Bytecode: '%s' is no longer declared in module '%s'.", self->vm->symbols[vm_symbol], module->name);
+        self->has_error = true;
+        break;
+      }
+
+      self->externals[i] = module->variables[slot].value;
+    }
+  }
+}
+
+static bool bfBytecode__isJumpTarget(const BifrostVMImageFn* record, uint32_t index, int32_t offset)
+{
+  const int64_t target = (int64_t)index + offset;
+
+  return target >= 0 && target < (int64_t)record->num_instructions;
+}
+
+/* NOTE(SR): See 'parserEmitSwitchTable' for the layout, every jump must land inside the function and a hashed table needs an empty slot to stop probing. */
+static bool bfBytecode__isSwitchTable(const BifrostVMImageFn* record, const uint8_t* constants, uint32_t index, uint32_t table)
+{
+  const uint32_t num_constants = record->num_constants;
+
+  if (table >= num_constants || !bfVMValue_isNumber(bfBytecode__loadU64(constants + sizeof(BifrostValue) * table)))
+  {
+    return false;
+  }
+
+  const double   num_slots = bfVMValue_asNumber(bfBytecode__loadU64(constants + sizeof(BifrostValue) * table));
+  const double   num_jumps = num_slots < 0.0 ? -num_slots : num_slots;
+  const uint32_t stride    = num_slots < 0.0 ? 2u : 1u;
+
+  /* NOTE(SR): A dense table is '[num slots, min key, jump...]' and a hashed one is '[-num slots, (key, jump)...]'. */
+  if (!(num_jumps <= (double)num_constants) || num_jumps != (double)(uint32_t)num_jumps)
+  {
+    return false;
+  }
+
+  const uint32_t table_size = stride == 1u ? 2u + (uint32_t)num_jumps : 1u + 2u * (uint32_t)num_jumps;
+
+  if ((stride == 2u && (num_jumps == 0.0 || ((uint32_t)num_jumps & ((uint32_t)num_jumps - 1u)))) || table_size > num_constants - table)
+  {
+    return false;
+  }
+
+  const uint32_t first_jump     = table + 2u;
+  bool           has_empty_slot = false;
+
+  for (uint32_t i = 0; i < (uint32_t)num_jumps; ++i)
+  {
+    const BifrostValue jump = bfBytecode__loadU64(constants + sizeof(BifrostValue) * (first_jump + i * stride));
+
+    if (!bfVMValue_isNumber(jump))
+    {
+      return false;
+    }
+
+    const double jump_amt = bfVMValue_asNumber(jump);
+
+    if (!(jump_amt >= -(double)record->num_instructions && jump_amt <= (double)record->num_instructions) ||
+        jump_amt != (double)(int32_t)jump_amt || !bfBytecode__isJumpTarget(record, index, (int32_t)jump_amt))
+    {
+      return false;
+    }
+
+    has_empty_slot |= jump_amt == 0.0;
+  }
+
+  return stride == 1u || has_empty_slot;
+}
+
+/*
+  NOTE(SR):
+    Run before any of the function's code is used, from the raw image so mapped
+    and copied images are checked the same. Every operand the interpreter indexes
+    with must be in range of what the function (or module) has and control can not
+    run off the end, a corrupt image is then just a load error instead of a crash.
+*/
+static void bfBytecode__verifyFunction(bfBytecodeReader* self, const BifrostVMImageFn* record, int32_t arity, uint32_t needed_stack_space)
+{
+  const uint8_t* const instructions = self->image + record->instructions;
+  const uint8_t* const constants    = self->image + record->constants;
+  const uint32_t       num_regs     = needed_stack_space;
+
+  if (num_regs == 0u || num_regs > BIFROST_INST_RBx_MASK + 1u || (arity >= 0 && (uint32_t)arity > num_regs))
+  {
+    bfBytecode__readError(self, "function has an invalid stack size.");
+    return;
+  }
+
+  for (uint32_t i = 0; i < record->num_constants; ++i)
+  {
+    const BifrostValue value = bfBytecode__loadU64(constants + sizeof(BifrostValue) * i);
+
+    if (bfVMValue_isPointer(value) || (bfBytecode_isObjectConstant(value) && bfBytecode_objectConstantIndex(value) >= record->num_objects))
+    {
+      bfBytecode__readError(self, "function has an invalid constant.");
+      return;
+    }
+  }
+
+  for (uint32_t i = 0; i < record->num_instructions; ++i)
+  {
+    const bfInstruction inst = bfBytecode__loadU32(instructions + sizeof(bfInstruction) * i);
+    const uint32_t      ra   = bfInst_getX(inst, RA);
+    const uint32_t      rb   = bfInst_getX(inst, RB);
+    const uint32_t      rc   = bfInst_getX(inst, RC);
+    const uint32_t      rbx  = bfInst_getX(inst, RBx);
+    const int32_t       rsbx = (int32_t)rbx - (int32_t)BIFROST_INST_RsBx_MAX;
+    bool                ok;
+
+    switch (bfInst_getX(inst, OP))
+    {
+      case BIFROST_VM_OP_LOAD_SYMBOL:
+        ok = ra < num_regs && rb < num_regs && rc < self->num_symbols;
+        break;
+      case BIFROST_VM_OP_STORE_SYMBOL:
+        ok = ra < num_regs && rb < self->num_symbols && rc < num_regs;
+        break;
+      case BIFROST_VM_OP_LOAD_BASIC:
+        ok = ra < num_regs && (rbx < BIFROST_VM_OP_LOAD_BASIC_CONSTANT || rbx - BIFROST_VM_OP_LOAD_BASIC_CONSTANT < record->num_constants);
+        break;
+      case BIFROST_VM_OP_LOAD_GLOBAL:
+      case BIFROST_VM_OP_STORE_GLOBAL:
+        ok = ra < num_regs && rbx < self->num_globals;
+        break;
+      case BIFROST_VM_OP_STORE_MOVE:
+      case BIFROST_VM_OP_NEW_CLZ:
+      case BIFROST_VM_OP_NOT:
+        ok = ra < num_regs && rbx < num_regs;
+        break;
+      case BIFROST_VM_OP_NEW_CONSTRUCT:
+        /* NOTE(SR): The interpreter looks at the next instruction to see if it is the constructor's 'CALL_FN'. */
+        ok = ra < num_regs && rb + 1u < num_regs && rc < record->num_ctor_sites && i + 1u < record->num_instructions;
+        break;
+      case BIFROST_VM_OP_MATH_ADD:
+      case BIFROST_VM_OP_MATH_SUB:
+      case BIFROST_VM_OP_MATH_MUL:
+      case BIFROST_VM_OP_MATH_DIV:
+      case BIFROST_VM_OP_MATH_MOD:
+      case BIFROST_VM_OP_MATH_POW:
+      case BIFROST_VM_OP_CMP_EE:
+      case BIFROST_VM_OP_CMP_NE:
+      case BIFROST_VM_OP_CMP_LT:
+      case BIFROST_VM_OP_CMP_LE:
+      case BIFROST_VM_OP_CMP_GT:
+      case BIFROST_VM_OP_CMP_GE:
+      case BIFROST_VM_OP_CMP_AND:
+      case BIFROST_VM_OP_CMP_OR:
+        ok = ra < num_regs && rb < num_regs && rc < num_regs;
+        break;
+      case BIFROST_VM_OP_MATH_INV:
+        ok = ra < num_regs && rb < num_regs;
+        break;
+      case BIFROST_VM_OP_MATH_INC:
+        ok = ra < num_regs;
+        break;
+      case BIFROST_VM_OP_CALL_FN:
+        ok = rb < num_regs && ra + rc < num_regs;
+        break;
+      case BIFROST_VM_OP_JUMP:
+        ok = bfBytecode__isJumpTarget(record, i, rsbx);
+        break;
+      case BIFROST_VM_OP_JUMP_IF:
+      case BIFROST_VM_OP_JUMP_IF_NOT:
+        ok = ra < num_regs && bfBytecode__isJumpTarget(record, i, rsbx);
+        break;
+      case BIFROST_VM_OP_SWITCH:
+        ok = ra < num_regs && bfBytecode__isSwitchTable(record, constants, i, rbx);
+        break;
+      case BIFROST_VM_OP_RETURN:
+        ok = rbx < num_regs;
+        break;
+      default:
+        ok = false;
+        break;
+    }
+
+    if (!ok)
+    {
+      bfBytecode__readError(self, "function has an invalid instruction.");
+      return;
+    }
+  }
+
+  /* NOTE(SR): Only a 'RETURN' or a 'JUMP' does not continue on to the next instruction. */
+  const uint32_t last_op = bfInst_getX(bfBytecode__loadU32(instructions + sizeof(bfInstruction) * (record->num_instructions - 1u)), OP);
+
+  if (last_op != BIFROST_VM_OP_RETURN && last_op != BIFROST_VM_OP_JUMP)
+  {
+    bfBytecode__readError(self, "function does not end with a return.");
+  }
+}
+
+/* A copy of the function's arrays with the symbols patched in, for images that are not mapped. */
+static void bfBytecode__readFunction(bfBytecodeReader* self, BifrostObjFn* fn, const BifrostVMImageFn* record)
+{
+  const uint8_t* const instructions = self->image + record->instructions;
+  const uint8_t* const constants    = self->image + record->constants;
+
+  for (uint32_t i = 0; i < record->num_instructions && !self->has_error; ++i)
+  {
+    bfInstruction inst = bfBytecode__loadU32(instructions + sizeof(bfInstruction) * i);
+
+    switch (bfInst_getX(inst, OP))
+    {
+      case BIFROST_VM_OP_LOAD_SYMBOL:
+        bfInst_patchX(&inst, RC, bfBytecode__remapInstSymbol(self, bfInst_getX(inst, RC)));
+        break;
+      case BIFROST_VM_OP_STORE_SYMBOL:
+        bfInst_patchX(&inst, RB, bfBytecode__remapInstSymbol(self, bfInst_getX(inst, RB)));
+        break;
+      case BIFROST_VM_OP_LOAD_GLOBAL:
+      case BIFROST_VM_OP_STORE_GLOBAL:
+        bfInst_patchX(&inst, RBx, bfBytecode__remapGlobal(self, bfInst_getX(inst, RBx)));
+        break;
+      default:
+      {
+        if (bfInst_getX(inst, OP) >= BF_BYTECODE_NUM_OPS)
+        {
+          bfBytecode__readError(self, "unknown instruction.");
+        }
+        break;
+      }
+    }
+
+    fn->instructions[i] = inst;
+  }
+
+  for (uint32_t i = 0; i < record->num_constants && !self->has_error; ++i)
+  {
+    BifrostValue value = bfBytecode__loadU64(constants + sizeof(BifrostValue) * i);
+
+    if (bfBytecode_isObjectConstant(value))
+    {
+      const uint32_t index = bfBytecode_objectConstantIndex(value);
+
+      value = bfBytecode__checkIndex(self, index, 0u, record->num_objects) ? bfBytecode__readObject(self, record, index) : bfVMValue_fromNull();
+    }
+
+    fn->constants[i] = value;
+  }
+
+  if (record->line_table_size)
+  {
+    LibC_memcpy(fn->line_table, self->image + record->line_table, record->line_table_size);
+  }
+}
+
+static void bfBytecode__readClass(bfBytecodeReader* self, BifrostObjClass* clz)
+{
+  const BifrostValue base_clz = bfBytecode__readValue(self);
+
+  if (bfVMValue_isPointer(base_clz))
+  {
+    BifrostObj* const base_obj = BIFROST_AS_OBJ(base_clz);
+
+    if ((base_obj->type & BifrostVMObjType_mask) != BIFROST_VM_OBJ_CLASS)
+    {
+      bfBytecode__readError(self, "base class is not a class.");
+      return;
+    }
+
+    clz->base_clz = (BifrostObjClass*)base_obj;
+  }
+
+  bfBytecode__readSymbols(self, clz);
+
+  const uint32_t num_fields = bfBytecode__readCount(self);
+
+  for (uint32_t i = 0; i < num_fields && !self->has_error; ++i)
+  {
+    const uint32_t     symbol = bfBytecode__readSymbol(self);
+    const BifrostValue value  = bfBytecode__readValue(self);
+
+    if (!self->has_error)
+    {
+      bfObjClass_addField(self->vm, clz, self->vm->symbols[symbol], value);
+    }
+  }
+}
+
+/* The function's code is either an empty block to be filled by 'bfBytecode__readFunction' or points into the mapped image. */
+static void bfBytecode__readPrototype(bfBytecodeReader* self, BifrostObjFn* prototype, const BifrostVMImageFn* record, uint32_t record_offset, string_range name)
+{
+  BifrostVM* const vm = self->vm;
+
+  prototype->image         = self->mapped;
+  prototype->image_fn      = NULL;
+  prototype->image_objects = NULL;
+  prototype->ctor_sites    = NULL;
+
+  if (self->mapped)
+  {
+    prototype->name             = bfVMString_newLen(vm, name.str_bgn, name.str_len);
+    prototype->num_instructions = record->num_instructions;
+    prototype->num_constants    = record->num_constants;
+    prototype->line_table_size  = record->line_table_size;
+    prototype->image_fn         = (const BifrostVMImageFn*)(self->image + record_offset);
+    prototype->line_table       = record->line_table_size ? (uint8_t*)(self->image + record->line_table) : NULL;
+    prototype->constants        = (BifrostValue*)(self->image + record->constants);
+    prototype->instructions     = (bfInstruction*)(self->image + record->instructions);
+    prototype->image_objects    = bfVMArray_newA(vm, prototype->image_objects, record->num_objects + 1u);
+
+    bfVMArray_resize(vm, &prototype->image_objects, record->num_objects);
+
+    for (uint32_t i = 0; i < record->num_objects; ++i)
+    {
+      prototype->image_objects[i] = bfVMValue_fromNull();
+    }
+
+    ++self->mapped->ref_count;
+  }
+  else
+  {
+    bfObjFn_allocCode(vm, prototype, record->num_instructions, record->num_constants, record->line_table_size, name.str_bgn, name.str_len);
+
+    for (uint32_t i = 0; i < record->num_constants; ++i)
+    {
+      prototype->constants[i] = bfVMValue_fromNull();
+    }
+  }
+
+  if (record->num_ctor_sites)
+  {
+    const uint8_t* const sites = self->image + record->ctor_sites;
+
+    prototype->ctor_sites = bfVMArray_new(vm, BifrostVMCtorSite, record->num_ctor_sites);
+    bfVMArray_resize(vm, &prototype->ctor_sites, record->num_ctor_sites);
+
+    for (uint32_t i = 0; i < record->num_ctor_sites; ++i)
+    {
+      bfObjFn_initCtorSite(prototype->ctor_sites + i, bfBytecode__remapSymbol(self, bfBytecode__loadU32(sites + sizeof(uint32_t) * i)));
+    }
+  }
+}
+
+static void bfBytecode__readHeader(bfBytecodeReader* self, const char* data, size_t data_size)
+{
+  if (!bfBytecode_isImage(data, data_size) || data_size < BF_BYTECODE_HEADER_SIZE || data_size > 0xFFFFFFFFu)
+  {
+    bfBytecode__readError(self, "not a bytecode image.");
+  }
+  else
+  {
+    self->cursor += BF_BYTECODE_MAGIC_SIZE;
+
+    const uint32_t version = bfBytecode__readU32(self);
+
+    const uint32_t flags = bfBytecode__readU32(self);
+
+    self->data_end = bfBytecode__readU32(self);
+
+    if (version != BIFROST_VM_BYTECODE_VERSION)
+    {
+      bfVM_SetLastError(BIFROST_VM_ERROR_INVALID_ARGUMENT, self->vm, -1, "Bytecode: image version %u does not match the vm's version %u.", (unsigned)version, (unsigned)BIFROST_VM_BYTECODE_VERSION);
+      self->has_error = true;
+    }
+    else if (flags & ~(uint32_t)BIFROST_VM_BYTECODE_FLAG_ALL)
+    {
+      bfBytecode__readError(self, "unknown header flags.");
+    }
+    else if (self->data_end < BF_BYTECODE_HEADER_SIZE || self->data_end > data_size)
+    {
+      bfBytecode__readError(self, "corrupt header.");
+    }
+    else
+    {
+      self->cursor = self->image + self->data_end;
+    }
+  }
+}
+
+/* NOTE(SR): Imports the modules whose constants the image inlined, they would have been imported by its code anyway. */
+static void bfBytecode__readConstImports(bfBytecodeReader* self)
+{
+  const uint32_t num_const_imports = bfBytecode__readCount(self);
+
+  for (uint32_t i = 0; i < num_const_imports && !self->has_error; ++i)
+  {
+    const string_range module_name = bfBytecode__readStr(self);
+    const uint64_t     const_hash  = bfBytecode__readU64(self);
+
+    if (self->has_error)
+    {
+      break;
+    }
+
+    BifrostObjModule* const module = bfVM_importModule(self->vm, self->module->name, module_name.str_bgn, module_name.str_len);
+
+    if (!module)
+    {
+      self->has_error = true;
+      break;
+    }
+
+    if (bfObjModule_constHash(module) != const_hash)
+    {
+      self->is_stale  = true;
+      self->has_error = true;
+      break;
+    }
+
+    bfObjModule_addConstImport(self->vm, self->module, bfVM_getSymbol(self->vm, module_name), const_hash);
+  }
+}
+
+bool bfBytecode_isStale(BifrostVM* vm, BifrostObjModule* module, const char* data, size_t data_size)
+{
+  bfBytecodeReader self;
+
+  LibC_memset(&self, 0x0, sizeof(self));
+  self.vm     = vm;
+  self.module = module;
+  self.image  = (const uint8_t*)data;
+  self.cursor = self.image;
+  self.end    = self.image + data_size;
+
+  bfBytecode__readHeader(&self, data, data_size);
+
+  if (!self.has_error)
+  {
+    bfBytecode__readConstImports(&self);
+  }
+
+  return self.is_stale;
+}
+
+/*
+  NOTE(SR):
+    Takes back what a failed load added to the module so its source can be
+    compiled into it instead (see 'bfVM_compileIntoModule'). Variables that
+    were already declared keep any value the image gave them.
+*/
+static void bfBytecode__undoLoad(bfBytecodeReader* self, size_t num_variables, size_t num_consts, size_t num_const_imports, bool loaded_init_fn)
+{
+  BifrostVM* const        vm     = self->vm;
+  BifrostObjModule* const module = self->module;
+
+  if (bfVMArray_size(&module->variables) != num_variables)
+  {
+    bfVMArray_resize(vm, &module->variables, num_variables);
+    bfObjModule_rebuildIndex(vm, module);
+  }
+
+  bfVMArray_resize(vm, &module->const_slots, num_consts);
+  bfVMArray_resize(vm, &module->const_imports, num_const_imports);
+
+  if (loaded_init_fn)
+  {
+    bfObjModule_releaseInitFn(vm, module);
+  }
+}
+
+/*
+  NOTE(SR):
+    Nothing in the image is trusted, the structure is validated as it is read
+    and every function is verified (see 'bfBytecode__verifyFunction') before
+    it is created. On an error the module is put back the way it was.
+*/
+BifrostVMError bfBytecode_load(BifrostVM* vm, BifrostObjModule* module, const char* data, size_t data_size, bool zero_copy)
+{
+  bfBytecodeReader self;
+  BifrostVMArena   arena;
+  BifrostGCRoot*   roots     = NULL;
+  uint32_t         num_roots = 0u;
+
+  const size_t num_old_variables = bfVMArray_size(&module->variables);
+  const size_t num_old_consts    = bfVMArray_size(&module->const_slots);
+  const size_t num_old_imports   = bfVMArray_size(&module->const_imports);
+  bool         loaded_init_fn    = false;
+
+  LibC_memset(&self, 0x0, sizeof(self));
+  self.vm     = vm;
+  self.module = module;
+  self.image  = (const uint8_t*)data;
+  self.cursor = self.image;
+  self.end    = self.image + data_size;
+
+  bfVMArena_ctor(&arena, vm);
+
+  bfBytecode__readHeader(&self, data, data_size);
+
+  /* NOTE(SR): The data section is stored little endian and aligned relative to the start of the image. */
+  if (!self.has_error && zero_copy && bfBytecode__isLittleEndian() && ((uintptr_t)data % sizeof(BifrostValue)) == 0u)
+  {
+    self.mapped = bfGC_AllocMemory(vm, NULL, 0u, sizeof(BifrostVMImage));
+    LibC_memset(self.mapped, 0x0, sizeof(BifrostVMImage));
+    self.mapped->data      = self.image;
+    self.mapped->data_size = data_size;
+    self.mapped->ref_count = 1u;
+  }
+
+  if (!self.has_error)
+  {
+    bfBytecode__readConstImports(&self);
+
+    if (self.is_stale)
+    {
+      bfVM_SetLastError(BIFROST_VM_ERROR_INVALID_ARGUMENT, vm, -1, "Bytecode: '%s' was saved before a constant it imports changed, compile it from source again.", module->name);
+    }
+  }
+
+  if (!self.has_error)
+  {
+    self.num_symbols = bfBytecode__readCount(&self);
+    self.symbols     = bfVMArena_alloc(&arena, sizeof(uint32_t) * (self.num_symbols + 1u));
+
+    for (uint32_t i = 0; i < self.num_symbols && !self.has_error; ++i)
+    {
+      const string_range name = bfBytecode__readStr(&self);
+
+      self.symbols[i] = self.has_error ? 0u : bfVM_getSymbol(vm, name);
+
+      /* NOTE(SR): Instructions only refer to the first symbols of an image, see 'bfBytecode__gatherSymbols'. */
+      if (self.mapped && i <= BIFROST_INST_RC_MASK)
+      {
+        self.mapped->symbols[i] = self.symbols[i];
+      }
+    }
+  }
+
+  if (!self.has_error)
+  {
+    bfBytecode__readGlobals(&self, &arena);
+  }
+
+  if (!self.has_error)
+  {
+    bfBytecode__readExternals(&self, &arena);
+  }
+
+  if (!self.has_error)
+  {
+    self.num_fns = bfBytecode__readCount(&self);
+
+    if (self.num_fns == 0u)
+    {
+      bfBytecode__readError(&self, "missing the module's init function.");
+    }
+  }
+
+  if (!self.has_error)
+  {
+    self.fns     = bfVMArena_alloc(&arena, sizeof(BifrostObjFn*) * self.num_fns);
+    self.records = bfVMArena_alloc(&arena, sizeof(BifrostVMImageFn) * self.num_fns);
+    roots        = bfVMArena_alloc(&arena, sizeof(BifrostGCRoot) * self.num_fns);
+
+    /*
+      NOTE(SR):
+        Every function is fully valid (with null constants) before it is
+        created so that a collection at any point is safe.
+    */
+    for (uint32_t i = 0; i < self.num_fns && !self.has_error; ++i)
+    {
+      const string_range name               = bfBytecode__readStr(&self);
+      const int32_t      arity              = (int32_t)bfBytecode__readU32(&self);
+      const uint32_t     needed_stack_space = bfBytecode__readU32(&self);
+      const uint32_t     record_offset      = bfBytecode__readU32(&self);
+
+      if (!self.has_error)
+      {
+        bfBytecode__readRecord(&self, record_offset, self.records + i);
+      }
+
+      if (!self.has_error)
+      {
+        bfBytecode__verifyFunction(&self, self.records + i, arity, needed_stack_space);
+      }
+
+      if (self.has_error)
+      {
+        break;
+      }
+
+      BifrostObjFn  prototype;
+      BifrostObjFn* fn;
+
+      prototype.arity              = arity;
+      prototype.needed_stack_space = needed_stack_space;
+      bfBytecode__readPrototype(&self, &prototype, self.records + i, record_offset, name);
+
+      if (i == 0u)
+      {
+        fn             = &module->init_fn;
+        loaded_init_fn = true;
+
+        if (fn->name)
+        {
+          bfObj_Destruct(vm, &fn->super);
+        }
+      }
+      else
+      {
+        fn = bfObj_NewFunction(vm, module);
+        bfGC_PushRoot(vm, roots + num_roots++, &fn->super);
+      }
+
+      fn->name               = prototype.name;
+      fn->arity              = prototype.arity;
+      fn->instructions       = prototype.instructions;
+      fn->constants          = prototype.constants;
+      fn->num_instructions   = prototype.num_instructions;
+      fn->num_constants      = prototype.num_constants;
+      fn->line_table         = prototype.line_table;
+      fn->line_table_size    = prototype.line_table_size;
+      fn->needed_stack_space = prototype.needed_stack_space;
+      fn->lazy_source        = NULL;
+      fn->image              = prototype.image;
+      fn->image_fn           = prototype.image_fn;
+      fn->image_objects      = prototype.image_objects;
+      fn->ctor_sites         = prototype.ctor_sites;
+      self.fns[i]            = fn;
+    }
+  }
+
+  if (!self.has_error)
+  {
+    self.num_classes = bfBytecode__readCount(&self);
+    self.classes     = bfVMArena_alloc(&arena, sizeof(BifrostObjClass*) * (self.num_classes + 1u));
+
+    BifrostGCRoot* const class_roots = bfVMArena_alloc(&arena, sizeof(BifrostGCRoot) * (self.num_classes + 1u));
+
+    for (uint32_t i = 0; i < self.num_classes && !self.has_error; ++i)
+    {
+      const string_range name       = bfBytecode__readStr(&self);
+      const uint32_t     extra_data = bfBytecode__readU32(&self);
+
+      if (!self.has_error)
+      {
+        self.classes[i] = bfObj_NewClass(vm, module, name, NULL, extra_data);
+        bfGC_PushRoot(vm, class_roots + i, &self.classes[i]->super);
+        ++num_roots;
+      }
+    }
+  }
+
+  for (uint32_t i = 0; i < self.num_fns && !self.has_error; ++i)
+  {
+    BifrostObjFn* const           fn     = self.fns[i];
+    const BifrostVMImageFn* const record = self.records + i;
+
+    if (self.mapped)
+    {
+      for (uint32_t j = 0; j < record->num_objects && !self.has_error; ++j)
+      {
+        const BifrostValue value = bfBytecode__readObject(&self, record, j);
+
+        fn->image_objects[j] = value;
+      }
+    }
+    else
+    {
+      bfBytecode__readFunction(&self, fn, record);
+    }
+  }
+
+  for (uint32_t i = 0; i < self.num_classes && !self.has_error; ++i)
+  {
+    bfBytecode__readClass(&self, self.classes[i]);
+  }
+
+  for (uint32_t i = 0; i < self.num_globals && !self.has_error; ++i)
+  {
+    const BifrostValue value = bfBytecode__readValue(&self);
+
+    if (!self.has_error)
+    {
+      module->variables[self.globals[i]].value = value;
+    }
+  }
+
+  /* NOTE(SR): Only matters to modules compiled from source that import this one, the image's own code already has the values inlined. */
+  const uint32_t num_consts = self.has_error ? 0u : bfBytecode__readCount(&self);
+
+  for (uint32_t i = 0; i < num_consts && !self.has_error; ++i)
+  {
+    const uint32_t slot = bfBytecode__remapGlobal(&self, bfBytecode__readU32(&self));
+
+    if (!self.has_error)
+    {
+      bfObjModule_markConst(vm, module, slot);
+    }
+  }
+
+  if (!self.has_error && self.cursor != self.end)
+  {
+    bfBytecode__readError(&self, "trailing data after the image.");
+  }
+
+  if (self.has_error)
+  {
+    bfBytecode__undoLoad(&self, num_old_variables, num_old_consts, num_old_imports, loaded_init_fn);
+  }
+
+  while (num_roots--)
+  {
+    bfGC_PopRoot(vm);
+  }
+
+  if (self.mapped)
+  {
+    bfBytecode_releaseImage(vm, self.mapped);
+  }
+
+  bfVMArena_dtor(&arena);
+
+  return self.has_error ? BIFROST_VM_ERROR_INVALID_ARGUMENT : BIFROST_VM_ERROR_NONE;
+}
+
+BifrostValue bfBytecode_materialize(BifrostVM* vm, BifrostObjFn* fn, BifrostValue constant)
+{
+  const uint32_t index = bfBytecode_objectConstantIndex(constant);
+
+  if (!fn->image || index >= bfVMArray_size(&fn->image_objects))
+  {
+    return bfVMValue_fromNull();
+  }
+
+  if (bfBytecode_isObjectConstant(fn->image_objects[index]))
+  {
+    /* NOTE(SR): Only strings are left for later by the loader and it already checked their bounds. */
+    const uint8_t* const entry  = fn->image->data + fn->image_fn->objects + BF_BYTECODE_OBJECT_SIZE * index;
+    const uint8_t* const length = fn->image->data + bfBytecode__loadU32(entry + sizeof(uint32_t));
+    BifrostObjStr* const str    = bfObj_NewStringVerbatim(vm, MakeStringLen((const char*)length + sizeof(uint32_t), bfBytecode__loadU32(length)));
+
+    fn->image_objects[index] = bfVMValue_fromPointer(str);
+  }
+
+  return fn->image_objects[index];
+}
+
+void bfBytecode_releaseImage(BifrostVM* vm, BifrostVMImage* image)
+{
+  if (--image->ref_count == 0u)
+  {
+    bfGC_AllocMemory(vm, image, sizeof(BifrostVMImage), 0u);
+  }
+}
+
+#undef BF_BYTECODE_MAGIC
+#undef BF_BYTECODE_MAGIC_SIZE
+#undef BF_BYTECODE_HEADER_SIZE
+#undef BF_BYTECODE_NO_SYMBOL
+#undef BF_BYTECODE_BUFFER_SIZE
+#undef BF_BYTECODE_OBJECT_SIZE
+#undef BF_BYTECODE_NUM_OPS
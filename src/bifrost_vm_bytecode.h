@@ -0,0 +1,121 @@
+/******************************************************************************/
+/*!
+ * @file   bifrost_vm_bytecode.h
+ * @author Shareef Abdoul-Raheem (http://blufedora.github.io/)
+ * @brief
+ *   Serializes a compiled module into a self contained binary image so
+ *   that loading it later skips the lexer and parser entirely.
+ *
+ *   Layout (every integer is little endian):
+ *     Header     : "BFSC" | u32 version | u32 flags ('BifrostVMBytecodeFlags') | u32 stream offset
+ *     Data       : read only sections, every offset below is from the start of the image.
+ *     Stream     :
+ *       Imports    : u32 count | (str module | u64 const hash)...
+ *       Symbols    : u32 count | (str name)...
+ *       Globals    : u32 count | (u32 symbol)...
+ *       Externals  : u32 count | (str module | u32 symbol)...
+ *       Prototypes : u32 count | (str name | i32 arity | u32 stack space | u32 'BifrostVMImageFn' offset)...
+ *                    u32 count | (str name | u32 extra data)...
+ *       Classes    : (value base | u32 count | (u32 symbol | value)... | u32 count | (u32 symbol | value)...)...
+ *       Variables  : (value)...
+ *       Constants  : u32 count | (u32 global)...
+ *
+ *   'str' is a u32 length followed by that many bytes and 'value' is a u8
+ *   tag followed by its payload. Function 0 is always the module's init
+ *   function. Symbols in instructions are indices into the image's own symbol
+ *   table and are remapped to the loading vm's symbol ids. Module variable
+ *   slots index the globals, the variables section has one value per global
+ *   and the constants section lists the globals declared 'const'. The imports
+ *   section has the 'bfObjModule_constHash' of every module whose constants
+ *   were inlined, the image is stale once one of them no longer matches.
+ *
+ *   The data section holds each function's instructions (u32), constants
+ *   (u64 'BifrostValue' bits), line table (bytes, see 'bfVMLineTable') and object table
+ *   (u32 value tag | u32 index or string offset), aligned to their size so a mapped image can be
+ *   executed in place. It also holds the symbol of each constructor site (u32), the mutable
+ *   site caches themselves are always allocated when loading. Constants that are objects are stored as
+ *   'bfBytecode_makeObjectConstant' placeholders into the object table.
+ *
+ * @copyright Copyright (c) 2020-2025 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef BIFROST_VM_BYTECODE_H
+#define BIFROST_VM_BYTECODE_H
+
+#include "bifrost/bifrost_vm.h"        /* BifrostVM, BifrostVMError, bfBytecodeWriteFn */
+#include "bifrost_vm_instruction_op.h" /* BIFROST_INST_RC_MASK                         */
+#include "bifrost_vm_value.h"          /* BifrostValue, k_QuietNan                     */
+
+#include <stddef.h> /* size_t */
+
+#if __cplusplus
+extern "C" {
+#endif
+
+typedef struct BifrostObjFn BifrostObjFn;
+
+#define BIFROST_VM_BYTECODE_VERSION 9u /*!< Bump whenever the layout or the instruction encoding changes. */
+
+typedef enum BifrostVMBytecodeFlags
+{
+  BIFROST_VM_BYTECODE_FLAG_STRIPPED = (1u << 0), /*!< Saved with 'BifrostVMParams::strip_debug_info', no function has a line table. */
+  BIFROST_VM_BYTECODE_FLAG_ALL      = BIFROST_VM_BYTECODE_FLAG_STRIPPED,
+
+} BifrostVMBytecodeFlags;
+
+/*
+  NOTE(SR):
+    Object constant placeholders use the otherwise unused third tag bit of a
+    non pointer nan, the index into the function's object table sits above it.
+*/
+#define k_VMValueTagImageObject                ((uint64_t)0x4)
+#define bfBytecode_isObjectConstant(value)     (((value) & (k_VMValuePointerMask | (uint64_t)0x7)) == (k_QuietNan | k_VMValueTagImageObject))
+#define bfBytecode_objectConstantIndex(value)  ((uint32_t)(((value) & ~k_VMValuePointerMask) >> 3u))
+#define bfBytecode_makeObjectConstant(index)   ((BifrostValue)(k_QuietNan | ((uint64_t)(index) << 3u) | k_VMValueTagImageObject))
+
+/*!
+ * @brief
+ *   Per function record in the data section of an image, the offsets are
+ *   from the start of the image.
+ */
+typedef struct BifrostVMImageFn
+{
+  uint32_t num_instructions;
+  uint32_t num_constants;
+  uint32_t line_table_size; /*!< In bytes, 0 when stripped. */
+  uint32_t num_objects;
+  uint32_t num_ctor_sites;
+  uint32_t instructions;
+  uint32_t constants;
+  uint32_t line_table;
+  uint32_t objects;
+  uint32_t ctor_sites;
+
+} BifrostVMImageFn;
+
+/*!
+ * @brief
+ *   Shared by every function executing straight out of a mapped image,
+ *   freed once the last of them is destroyed.
+ */
+typedef struct BifrostVMImage
+{
+  const uint8_t* data;
+  size_t         data_size;
+  uint32_t       ref_count;
+  uint32_t       symbols[BIFROST_INST_RC_MASK + 1u]; /*!< Image symbol to vm symbol, instructions are not patched since the memory is read only. */
+
+} BifrostVMImage;
+
+bool           bfBytecode_isImage(const char* data, size_t data_size);
+BifrostVMError bfBytecode_save(BifrostVM* vm, BifrostObjModule* module, bfBytecodeWriteFn write_fn, void* user_data);
+bool           bfBytecode_isStale(BifrostVM* vm, BifrostObjModule* module, const char* data, size_t data_size);
+BifrostVMError bfBytecode_load(BifrostVM* vm, BifrostObjModule* module, const char* data, size_t data_size, bool zero_copy);
+BifrostValue   bfBytecode_materialize(BifrostVM* vm, BifrostObjFn* fn, BifrostValue constant);
+void           bfBytecode_releaseImage(BifrostVM* vm, BifrostVMImage* image);
+
+#if __cplusplus
+}
+#endif
+
+#endif /* BIFROST_VM_BYTECODE_H */
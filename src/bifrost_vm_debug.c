@@ -11,6 +11,7 @@
 /******************************************************************************/
 #include "bifrost_vm_debug.h"
 
+#include "bifrost_vm_bytecode.h"
 #include "bifrost_vm_instruction_op.h"
 #include "bifrost_vm_obj.h"
 
@@ -28,7 +29,7 @@ size_t bfDbg_ValueToString(BifrostValue value, char* buffer, size_t buffer_size)
 {
   if (bfVMValue_isNumber(value))
   {
-    return (size_t)snprintf(buffer, buffer_size, "%g", bfVMValue_asNumber(value));
+    return bfVM_numberToString(bfVMValue_asNumber(value), buffer, buffer_size);
   }
   else if (bfVMValue_isBool(value))
   {
@@ -180,7 +181,7 @@ static const char* bfDbg_InstOpComment(const bfInstructionOp op)
 
 extern void bfInst_decode(const bfInstruction inst, uint8_t* op_out, uint32_t* ra_out, uint32_t* rb_out, uint32_t* rc_out, uint32_t* rbx_out, int32_t* rsbx_out);
 
-void bfDbg_DisassembleInstructions(int indent, const bfInstruction* code, size_t code_length, uint16_t* code_to_line)
+void bfDbg_DisassembleInstructions(int indent, const bfInstruction* code, size_t code_length, const uint8_t* line_table, size_t line_table_size)
 {
   bfDbgIndentPrint(indent);
 
@@ -189,9 +190,9 @@ void bfDbg_DisassembleInstructions(int indent, const bfInstruction* code, size_t
   {
     bfDbgIndentPrint(indent);
 
-    if (code_to_line)
+    if (line_table)
     {
-      printf("Line[%3i]: ", (int)code_to_line[i]);
+      printf("Line[%3i]: ", bfVMLineTable_lineOf(line_table, line_table_size, i));
     }
 
     uint8_t  op;
@@ -211,8 +212,8 @@ void bfDbg_DisassembleInstructions(int indent, const bfInstruction* code, size_t
 
 void bfDbg_DisassembleFunction(int indent, const BifrostObjFn* function)
 {
-  const size_t num_constants      = bfVMArray_size(&function->constants);
-  const size_t num_instructions   = bfVMArray_size(&function->instructions);
+  const size_t num_constants      = bfObjFn_numConstants(function);
+  const size_t num_instructions   = bfObjFn_numInstructions(function);
   const size_t needed_stack_space = function->needed_stack_space;
 
   bfDbgIndentPrint(indent + 0);
@@ -225,7 +226,16 @@ void bfDbg_DisassembleFunction(int indent, const BifrostObjFn* function)
   {
     char temp_buffer[128];
 
-    bfDbg_ValueToString(function->constants[i], temp_buffer, sizeof(temp_buffer));
+    const BifrostValue constant = function->constants[i];
+
+    if (bfBytecode_isObjectConstant(constant))
+    {
+      snprintf(temp_buffer, sizeof(temp_buffer), "<image object %u>", (unsigned)bfBytecode_objectConstantIndex(constant));
+    }
+    else
+    {
+      bfDbg_ValueToString(constant, temp_buffer, sizeof(temp_buffer));
+    }
 
     bfDbgIndentPrint(indent + 2);
     printf("[%i] = %s\n", (int)i, temp_buffer);
@@ -233,7 +243,7 @@ void bfDbg_DisassembleFunction(int indent, const BifrostObjFn* function)
 
   bfDbgIndentPrint(indent + 1);
   printf("Instructions(%i):\n", (int)num_instructions);
-  bfDbg_DisassembleInstructions(indent + 2, function->instructions, num_instructions, function->code_to_line);
+  bfDbg_DisassembleInstructions(indent + 2, function->instructions, num_instructions, function->line_table, function->line_table_size);
 
   bfDbgIndentPrint(indent + 1);
 }
@@ -25,7 +25,7 @@ typedef struct BifrostObjFn BifrostObjFn;
 size_t      bfDbg_ValueToString(BifrostValue value, char* buffer, size_t buffer_size);
 size_t      bfDbg_ValueTypeToString(BifrostValue value, char* buffer, size_t buffer_size);
 const char* bfDbg_InstOpToString(const bfInstructionOp op);
-void        bfDbg_DisassembleInstructions(int indent, const bfInstruction* code, size_t code_length, uint16_t* code_to_line);
+void        bfDbg_DisassembleInstructions(int indent, const bfInstruction* code, size_t code_length, const uint8_t* line_table, size_t line_table_size);
 void        bfDbg_DisassembleFunction(int indent, const BifrostObjFn* function);
 const char* bfDbg_TokenTypeToString(bfTokenType t);
 void        bfDbg_PrintToken(const bfToken* token);
@@ -13,20 +13,26 @@
 
 #include "bifrost_vm_obj.h"
 
-static const size_t k_DefaultArraySize = 8;
+static const size_t k_DefaultArraySize     = 8;
+static const size_t k_DefaultConstantSlots = 16;
 
-void bfFuncBuilder_ctor(BifrostVMFunctionBuilder* self, BifrostLexer* lexer)
+void bfFuncBuilder_ctor(BifrostVMFunctionBuilder* self, BifrostLexer* lexer, BifrostVMArena* arena)
 {
   self->name                 = NULL;
   self->name_len             = 0;
   self->constants            = NULL;
+  self->constant_slots       = bfVMArray_newArena(arena, uint32_t, k_DefaultConstantSlots);
   self->instructions         = NULL;
   self->code_to_line         = NULL;
-  self->local_vars           = bfVMArray_new(lexer->vm, string_range, k_DefaultArraySize);
-  self->local_var_scope_size = bfVMArray_new(lexer->vm, int, k_DefaultArraySize);
-  self->max_local_idx        = 0;
+  self->ctor_sites           = NULL;
+  self->local_vars           = bfVMArray_newArena(arena, string_range, k_DefaultArraySize);
+  self->local_var_chain      = bfVMArray_newArena(arena, uint32_t, k_DefaultArraySize);
+  self->local_var_scope_size = bfVMArray_newArena(arena, int, k_DefaultArraySize);
   self->vm                   = lexer->vm;
+  self->arena                = arena;
   self->current_line_no      = &lexer->current_line_no;
+
+  LibC_memset(self->local_var_buckets, 0x0, sizeof(self->local_var_buckets));
 }
 
 void bfFuncBuilder_begin(BifrostVMFunctionBuilder* self, const char* name, size_t length)
@@ -35,53 +41,171 @@ void bfFuncBuilder_begin(BifrostVMFunctionBuilder* self, const char* name, size_
 
   self->name         = name;
   self->name_len     = length;
-  self->constants    = bfVMArray_new(self->vm, BifrostValue, k_DefaultArraySize);
-  self->instructions = bfVMArray_new(self->vm, uint32_t, k_DefaultArraySize);
-  self->code_to_line = bfVMArray_newA(self->vm, self->code_to_line, k_DefaultArraySize);
+  self->constants    = bfVMArray_newArena(self->arena, BifrostValue, k_DefaultArraySize);
+  self->instructions = bfVMArray_newArena(self->arena, uint32_t, k_DefaultArraySize);
+  self->code_to_line = bfVMArray_newArena(self->arena, uint32_t, k_DefaultArraySize);
+  self->ctor_sites   = bfVMArray_newArena(self->arena, uint32_t, k_DefaultArraySize);
+  bfVMArray_resize(self->vm, &self->constant_slots, k_DefaultConstantSlots);
+  LibC_memset(self->constant_slots, 0x0, sizeof(*self->constant_slots) * k_DefaultConstantSlots);
   bfVMArray_clear(&self->local_vars);
+  bfVMArray_clear(&self->local_var_chain);
   bfVMArray_clear(&self->local_var_scope_size);
+  LibC_memset(self->local_var_buckets, 0x0, sizeof(self->local_var_buckets));
 
   bfFuncBuilder_pushScope(self);
+
+  /*
+    NOTE(SR):
+      Register 0 is the callee slot of the calling convention and
+      receives the return value, parameters start at register 1.
+  */
+  bfFuncBuilder_pushTemp(self, 1);
+}
+
+static uint32_t bfFuncBuilder__hashValue(BifrostValue value)
+{
+  /* NOTE(SR): Finalizer from MurmurHash3, constants are compared bitwise so the raw bits are hashed. */
+  value ^= value >> 33;
+  value *= 0xFF51AFD7ED558CCDull;
+  value ^= value >> 33;
+
+  return (uint32_t)value;
+}
+
+static uint32_t* bfFuncBuilder__findConstantSlot(uint32_t* slots, size_t num_slots, const BifrostValue* constants, BifrostValue value)
+{
+  const size_t mask = num_slots - 1;
+  size_t       i    = bfFuncBuilder__hashValue(value) & mask;
+
+  while (slots[i] && constants[slots[i] - 1] != value)
+  {
+    i = (i + 1) & mask;
+  }
+
+  return slots + i;
 }
 
 uint32_t bfFuncBuilder_addConstant(BifrostVMFunctionBuilder* self, const BifrostValue value)
 {
   const size_t num_constants = bfVMArray_size(&self->constants);
+  size_t       num_slots     = bfVMArray_size(&self->constant_slots);
+  uint32_t*    slot          = bfFuncBuilder__findConstantSlot(self->constant_slots, num_slots, self->constants, value);
 
-  for (uint32_t index = 0; index < num_constants; ++index)
+  if (*slot)
   {
-    if (self->constants[index] == value)
+    return *slot - 1;
+  }
+
+  bfVMArray_push(self->vm, &self->constants, &value);
+
+  /* Keep the load factor at or below one half. */
+  if ((num_constants + 1) * 2 > num_slots)
+  {
+    num_slots *= 2;
+
+    bfVMArray_resize(self->vm, &self->constant_slots, num_slots);
+    LibC_memset(self->constant_slots, 0x0, sizeof(*self->constant_slots) * num_slots);
+
+    for (size_t i = 0; i < num_constants; ++i)
     {
-      return index;
+      *bfFuncBuilder__findConstantSlot(self->constant_slots, num_slots, self->constants, self->constants[i]) = (uint32_t)i + 1;
     }
+
+    slot = bfFuncBuilder__findConstantSlot(self->constant_slots, num_slots, self->constants, value);
   }
 
-  bfVMArray_push(self->vm, &self->constants, &value);
+  *slot = (uint32_t)num_constants + 1;
 
   return (uint32_t)num_constants;
 }
 
+uint32_t bfFuncBuilder_addConstantTable(BifrostVMFunctionBuilder* self, const BifrostValue* values, size_t num_values)
+{
+  const size_t index = bfVMArray_size(&self->constants);
+
+  /* NOTE(SR): A table is only ever addressed as a whole so its entries are not de-duplicated. */
+  bfVMArray_resize(self->vm, &self->constants, index + num_values);
+  LibC_memcpy(self->constants + index, values, sizeof(*values) * num_values);
+
+  return (uint32_t)index;
+}
+
+uint32_t bfFuncBuilder_addCtorSite(BifrostVMFunctionBuilder* self, uint32_t symbol)
+{
+  const size_t index = bfVMArray_size(&self->ctor_sites);
+
+  if (index > BIFROST_INST_RC_MASK)
+  {
+    return BIFROST_INST_RC_MASK + 1u;
+  }
+
+  bfVMArray_push(self->vm, &self->ctor_sites, &symbol);
+
+  return (uint32_t)index;
+}
+
 void bfFuncBuilder_pushScope(BifrostVMFunctionBuilder* self)
 {
   bfScopeVarCount* count = bfVMArray_emplace(self->vm, &self->local_var_scope_size);
   *count                 = 0;
 }
 
+/*
+  NOTE(SR):
+    Named locals are chained per bucket from the most recently declared
+    so the first match is the innermost (shadowing) declaration.
+    Since [local_vars] only ever grows and shrinks at the end whatever is being
+    removed is always the head of its bucket.
+*/
+static uint32_t* bfFuncBuilder__localVarBucket(BifrostVMFunctionBuilder* self, const char* name, size_t length)
+{
+  return self->local_var_buckets + (bfVMString_hashN(name, length) & (BIFROST_VM_LOCAL_VAR_NUM_BUCKETS - 1));
+}
+
+static void bfFuncBuilder__truncateLocalVars(BifrostVMFunctionBuilder* self, size_t new_size)
+{
+  size_t i = bfVMArray_size(&self->local_vars);
+
+  if (new_size > i)
+  {
+    bfFuncBuilder_pushTemp(self, (uint16_t)(new_size - i));
+    return;
+  }
+
+  while (i-- > new_size)
+  {
+    const string_range* const var = self->local_vars + i;
+
+    if (var->str_len)
+    {
+      *bfFuncBuilder__localVarBucket(self, var->str_bgn, var->str_len) = self->local_var_chain[i];
+    }
+  }
+
+  bfVMArray_resize(self->vm, &self->local_vars, new_size);
+  bfVMArray_resize(self->vm, &self->local_var_chain, new_size);
+}
+
 static inline size_t bfFuncBuilder__getVariable(BifrostVMFunctionBuilder* self, const char* name, size_t length, bool in_current_scope)
 {
   const int* count = (const int*)bfVMArray_back(&self->local_var_scope_size);
-  const int  end   = in_current_scope ? *count : (int)bfVMArray_size(&self->local_vars);
+  const int  end   = (int)bfVMArray_size(&self->local_vars);
+  const int  begin = in_current_scope ? end - *count : 0;
+  uint32_t   index = *bfFuncBuilder__localVarBucket(self, name, length);
 
-  for (int i = end - 1; i >= 0; --i)
+  while (index)
   {
+    const int                 i   = (int)index - 1;
     const string_range* const var = self->local_vars + i;
 
     LibC_assert((int)bfVMArray_size(&self->local_vars) > i, "Invalid indexing.");
 
-    if (length == var->str_len && bfVMString_ccmpn(name, var->str_bgn, length) == 0)
+    if (length == var->str_len && LibC_strncmp(name, var->str_bgn, length) == 0)
     {
-      return i;
+      return i >= begin ? (size_t)i : BIFROST_ARRAY_INVALID_INDEX;
     }
+
+    index = self->local_var_chain[i];
   }
 
   return BIFROST_ARRAY_INVALID_INDEX;
@@ -97,36 +221,31 @@ uint32_t bfFuncBuilder_declVariable(BifrostVMFunctionBuilder* self, const char*
     return (uint32_t)prev_decl;
   }
 
-  const size_t  var_loc = bfVMArray_size(&self->local_vars);
-  string_range* var     = bfVMArray_emplace(self->vm, &self->local_vars);
+  const size_t    var_loc = bfVMArray_size(&self->local_vars);
+  string_range*   var     = bfVMArray_emplace(self->vm, &self->local_vars);
+  uint32_t* const chain   = bfVMArray_emplace(self->vm, &self->local_var_chain);
+  uint32_t* const bucket  = bfFuncBuilder__localVarBucket(self, name, length);
 
-  *var = MakeStringLen(name, length);
+  *var    = MakeStringLen(name, length);
+  *chain  = *bucket;
+  *bucket = (uint32_t)var_loc + 1;
 
   int* count = (int*)bfVMArray_back(&self->local_var_scope_size);
   ++(*count);
 
-  if (self->max_local_idx < var_loc)
-  {
-    self->max_local_idx = var_loc;
-  }
-
   return (uint32_t)var_loc;
 }
 
 uint16_t bfFuncBuilder_pushTemp(BifrostVMFunctionBuilder* self, uint16_t num_temps)
 {
-  const size_t  var_loc     = bfVMArray_size(&self->local_vars);
-  const size_t  var_loc_end = var_loc + num_temps;
-  string_range* vars        = bfVMArray_emplaceN(self->vm, &self->local_vars, num_temps);
+  const size_t  var_loc = bfVMArray_size(&self->local_vars);
+  string_range* vars    = bfVMArray_emplaceN(self->vm, &self->local_vars, num_temps);
+  uint32_t*     chain   = bfVMArray_emplaceN(self->vm, &self->local_var_chain, num_temps);
 
   for (size_t i = 0; i < num_temps; ++i)
   {
-    vars[i] = MakeStringLen(NULL, 0);
-  }
-
-  if (self->max_local_idx < var_loc_end)
-  {
-    self->max_local_idx = var_loc_end;
+    vars[i]  = MakeStringLen(NULL, 0);
+    chain[i] = 0;
   }
 
   return (uint16_t)var_loc;
@@ -134,7 +253,7 @@ uint16_t bfFuncBuilder_pushTemp(BifrostVMFunctionBuilder* self, uint16_t num_tem
 
 void bfFuncBuilder_popTemp(BifrostVMFunctionBuilder* self, uint16_t start)
 {
-  bfVMArray_resize(self->vm, &self->local_vars, start);
+  bfFuncBuilder__truncateLocalVars(self, start);
 }
 
 size_t bfFuncBuilder_getVariable(BifrostVMFunctionBuilder* self, const char* name, size_t length)
@@ -148,13 +267,13 @@ void bfFuncBuilder_popScope(BifrostVMFunctionBuilder* self)
   const size_t num_vars = bfVMArray_size(&self->local_vars);
   const size_t new_size = num_vars - *count;
 
-  bfVMArray_resize(self->vm, &self->local_vars, new_size);
+  bfFuncBuilder__truncateLocalVars(self, new_size);
   bfVMArray_pop(&self->local_var_scope_size);
 }
 
 static inline bfInstruction* bfFuncBuilder_addInst(BifrostVMFunctionBuilder* self)
 {
-  *(uint16_t*)bfVMArray_emplace(self->vm, &self->code_to_line) = (uint16_t)*self->current_line_no;
+  *(uint32_t*)bfVMArray_emplace(self->vm, &self->code_to_line) = (uint32_t)*self->current_line_no;
   return bfVMArray_emplace(self->vm, &self->instructions);
 }
 
@@ -179,25 +298,387 @@ void bfFuncBuilder_addInstBreak(BifrostVMFunctionBuilder* self)
   *bfFuncBuilder_addInst(self) = BIFROST_INST_INVALID;
 }
 
+void bfFuncBuilder_insertInstABx(BifrostVMFunctionBuilder* self, size_t index, bfInstructionOp op, uint16_t a, uint32_t bx)
+{
+  const size_t num_insts = bfVMArray_size(&self->instructions);
+
+  LibC_assert(index <= num_insts, "Instruction insert out of bounds.");
+
+  bfFuncBuilder_addInstABx(self, op, a, bx);
+
+  LibC_memmove(self->instructions + index + 1, self->instructions + index, sizeof(*self->instructions) * (num_insts - index));
+  LibC_memmove(self->code_to_line + index + 1, self->code_to_line + index, sizeof(*self->code_to_line) * (num_insts - index));
+
+  self->instructions[index] = BIFROST_MAKE_INST_OP_ABx(op, a, bx);
+  self->code_to_line[index] = (uint32_t)*self->current_line_no;
+}
+
+void bfFuncBuilder_removeInst(BifrostVMFunctionBuilder* self, size_t index)
+{
+  const size_t num_insts = bfVMArray_size(&self->instructions);
+
+  LibC_assert(index < num_insts, "Instruction remove out of bounds.");
+
+  LibC_memmove(self->instructions + index, self->instructions + index + 1, sizeof(*self->instructions) * (num_insts - index - 1));
+  LibC_memmove(self->code_to_line + index, self->code_to_line + index + 1, sizeof(*self->code_to_line) * (num_insts - index - 1));
+
+  bfVMArray_pop(&self->instructions);
+  bfVMArray_pop(&self->code_to_line);
+}
+
+/*
+  NOTE(SR):
+    Only ops that fully compute rA from their operands are listed here,
+    CMP_AND / CMP_OR are excluded since their short circuit jump lands
+    just past them and expects the result to already be in rA.
+*/
+static bool bfFuncBuilder__isPureWriteToRA(const bfInstruction inst)
+{
+  switch (bfInst_getX(inst, OP))
+  {
+    case BIFROST_VM_OP_LOAD_SYMBOL:
+    case BIFROST_VM_OP_LOAD_BASIC:
+    case BIFROST_VM_OP_LOAD_GLOBAL:
+    case BIFROST_VM_OP_STORE_MOVE:
+    case BIFROST_VM_OP_NEW_CLZ:
+    case BIFROST_VM_OP_MATH_ADD:
+    case BIFROST_VM_OP_MATH_SUB:
+    case BIFROST_VM_OP_MATH_MUL:
+    case BIFROST_VM_OP_MATH_DIV:
+    case BIFROST_VM_OP_MATH_MOD:
+    case BIFROST_VM_OP_MATH_POW:
+    case BIFROST_VM_OP_MATH_INV:
+    case BIFROST_VM_OP_CMP_EE:
+    case BIFROST_VM_OP_CMP_NE:
+    case BIFROST_VM_OP_CMP_LT:
+    case BIFROST_VM_OP_CMP_LE:
+    case BIFROST_VM_OP_CMP_GT:
+    case BIFROST_VM_OP_CMP_GE:
+    case BIFROST_VM_OP_NOT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool bfFuncBuilder_retargetLastInst(BifrostVMFunctionBuilder* self, size_t first_inst, uint16_t old_dst, uint16_t new_dst)
+{
+  const size_t num_insts = bfVMArray_size(&self->instructions);
+
+  if (num_insts > first_inst)
+  {
+    bfInstruction* const last_inst = self->instructions + (num_insts - 1);
+
+    if (bfFuncBuilder__isPureWriteToRA(*last_inst) && bfInst_getX(*last_inst, RA) == old_dst)
+    {
+      bfInst_patchX(last_inst, RA, new_dst);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool bfFuncBuilder_writesRegister(const BifrostVMFunctionBuilder* self, size_t first_inst, uint16_t reg)
+{
+  const size_t num_insts = bfVMArray_size(&self->instructions);
+
+  for (size_t i = first_inst; i < num_insts; ++i)
+  {
+    const bfInstruction inst = self->instructions[i];
+
+    if (inst == BIFROST_INST_INVALID || bfInst_getX(inst, RA) != reg)
+    {
+      continue;
+    }
+
+    if (bfFuncBuilder__isPureWriteToRA(inst) || bfInst_getX(inst, OP) == BIFROST_VM_OP_CMP_AND || bfInst_getX(inst, OP) == BIFROST_VM_OP_CMP_OR || bfInst_getX(inst, OP) == BIFROST_VM_OP_NEW_CONSTRUCT || bfInst_getX(inst, OP) == BIFROST_VM_OP_MATH_INC)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool bfFuncBuilder_canInline(const BifrostVMFunctionBuilder* self, const BifrostObjFn* fn, size_t max_insts, uint16_t base)
+{
+  /* NOTE(SR): Instructions of an image function use the image's symbol ids. */
+  if (fn->image)
+  {
+    return false;
+  }
+
+  const size_t num_insts     = bfObjFn_numInstructions(fn);
+  const size_t num_constants = bfVMArray_size(&self->constants) + bfObjFn_numConstants(fn);
+
+  if (max_insts > BIFROST_VM_MAX_INLINE_SIZE)
+  {
+    max_insts = BIFROST_VM_MAX_INLINE_SIZE;
+  }
+
+  if (num_insts > max_insts ||
+      (size_t)base + fn->needed_stack_space > (size_t)BIFROST_INST_RA_MASK + 1u ||
+      num_constants + BIFROST_VM_OP_LOAD_BASIC_CONSTANT > BIFROST_INST_RBx_MASK)
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < num_insts; ++i)
+  {
+    const uint32_t op = bfInst_getX(fn->instructions[i], OP);
+
+    /*
+      NOTE(SR):
+        Only leaf functions are inlined, this rules out recursion. 'NEW_CONSTRUCT' calls the constructor
+        and its rC indexes the callee's own sites. A switch table can not be re-based onto the caller's constants.
+    */
+    if (op == BIFROST_VM_OP_CALL_FN || op == BIFROST_VM_OP_NEW_CONSTRUCT || op == BIFROST_VM_OP_SWITCH)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+  NOTE(SR):
+    The callee's registers are renamed by [base] which is exactly where its
+    frame would have started for a real call, so the arguments are already
+    in place. A 'return' becomes a move into [base] and a jump to the end of
+    the spliced body, every other jump is re-pointed since a 'return'
+    expands to two instructions.
+*/
+void bfFuncBuilder_inlineFunction(BifrostVMFunctionBuilder* self, const BifrostObjFn* fn, uint16_t base)
+{
+  const size_t num_insts = bfObjFn_numInstructions(fn);
+  size_t       new_index[BIFROST_VM_MAX_INLINE_SIZE + 1];
+
+  LibC_assert(num_insts <= BIFROST_VM_MAX_INLINE_SIZE, "Function is too big to inline, 'bfFuncBuilder_canInline' should have been checked.");
+
+  for (size_t i = 0; i < num_insts; ++i)
+  {
+    const bfInstruction   inst = fn->instructions[i];
+    const bfInstructionOp op   = (bfInstructionOp)bfInst_getX(inst, OP);
+    const uint16_t        ra   = (uint16_t)(bfInst_getX(inst, RA) + base);
+    const uint16_t        rb   = (uint16_t)bfInst_getX(inst, RB);
+    const uint16_t        rc   = (uint16_t)bfInst_getX(inst, RC);
+    const uint32_t        rbx  = (uint32_t)bfInst_getX(inst, RBx);
+
+    new_index[i] = bfVMArray_size(&self->instructions);
+
+    switch (op)
+    {
+      case BIFROST_VM_OP_LOAD_BASIC:
+      {
+        uint32_t basic = rbx;
+
+        if (basic >= BIFROST_VM_OP_LOAD_BASIC_CONSTANT)
+        {
+          basic = bfFuncBuilder_addConstant(self, fn->constants[basic - BIFROST_VM_OP_LOAD_BASIC_CONSTANT]) + BIFROST_VM_OP_LOAD_BASIC_CONSTANT;
+        }
+
+        bfFuncBuilder_addInstABx(self, op, ra, basic);
+        break;
+      }
+      case BIFROST_VM_OP_LOAD_SYMBOL:
+        bfFuncBuilder_addInstABC(self, op, ra, rb + base, rc);
+        break;
+      case BIFROST_VM_OP_STORE_SYMBOL:
+        bfFuncBuilder_addInstABC(self, op, ra, rb, rc + base);
+        break;
+      case BIFROST_VM_OP_LOAD_GLOBAL:
+      case BIFROST_VM_OP_STORE_GLOBAL:
+        bfFuncBuilder_addInstABx(self, op, ra, rbx);
+        break;
+      case BIFROST_VM_OP_MATH_INC:
+        bfFuncBuilder_addInstAsBx(self, op, ra, (int32_t)rbx - (int32_t)BIFROST_INST_RsBx_MAX);
+        break;
+      case BIFROST_VM_OP_STORE_MOVE:
+      case BIFROST_VM_OP_NEW_CLZ:
+      case BIFROST_VM_OP_NOT:
+        bfFuncBuilder_addInstABx(self, op, ra, rbx + base);
+        break;
+      case BIFROST_VM_OP_JUMP:
+      case BIFROST_VM_OP_JUMP_IF:
+      case BIFROST_VM_OP_JUMP_IF_NOT:
+        /* NOTE(SR): Patched below once every instruction has a new index. */
+        *bfFuncBuilder_addInst(self) = inst;
+        break;
+      case BIFROST_VM_OP_RETURN:
+      {
+        if (rbx != 0)
+        {
+          bfFuncBuilder_addInstABx(self, BIFROST_VM_OP_STORE_MOVE, base, rbx + base);
+        }
+
+        if (i + 1 != num_insts)
+        {
+          bfFuncBuilder_addInstAsBx(self, BIFROST_VM_OP_JUMP, 0, 0);
+        }
+        break;
+      }
+      default: /* rA = rB <op> rC */
+        bfFuncBuilder_addInstABC(self, op, ra, rb + base, rc + base);
+        break;
+    }
+  }
+
+  new_index[num_insts] = bfVMArray_size(&self->instructions);
+
+  for (size_t i = 0; i < num_insts; ++i)
+  {
+    const bfInstruction   inst = fn->instructions[i];
+    const bfInstructionOp op   = (bfInstructionOp)bfInst_getX(inst, OP);
+
+    if (op == BIFROST_VM_OP_JUMP || op == BIFROST_VM_OP_JUMP_IF || op == BIFROST_VM_OP_JUMP_IF_NOT)
+    {
+      const int    old_offset = (int)bfInst_getX(inst, RsBx) - (int)BIFROST_INST_RsBx_MAX;
+      const size_t target     = new_index[(size_t)((int)i + old_offset)];
+      const int    new_offset = (int)target - (int)new_index[i];
+      const int    cond_reg   = op == BIFROST_VM_OP_JUMP ? 0 : (int)bfInst_getX(inst, RA) + base;
+
+      self->instructions[new_index[i]] = BIFROST_MAKE_INST_OP_AsBx(op, cond_reg, new_offset);
+    }
+    else if (op == BIFROST_VM_OP_RETURN && i + 1 != num_insts)
+    {
+      const size_t jump_idx = new_index[i + 1] - 1;
+
+      self->instructions[jump_idx] = BIFROST_MAKE_INST_OP_AsBx(BIFROST_VM_OP_JUMP, 0, (int)new_index[num_insts] - (int)jump_idx);
+    }
+  }
+}
+
+/*
+  NOTE(SR):
+    Rather than trusting the high water mark of [local_vars], which counts temps
+    that were reserved but never touched, the frame size is taken from the
+    registers the emitted code actually references.
+*/
+static size_t bfFuncBuilder__neededStackSpace(const BifrostVMFunctionBuilder* self, int arity)
+{
+  const size_t num_insts = bfVMArray_size(&self->instructions);
+  size_t       result    = (size_t)(arity > 0 ? arity : 0) + 1u;
+
+  for (size_t i = 0; i < num_insts; ++i)
+  {
+    const bfInstruction inst    = self->instructions[i];
+    size_t              max_reg = 0;
+
+    if (inst == BIFROST_INST_INVALID)
+    {
+      continue;
+    }
+
+    const size_t ra  = bfInst_getX(inst, RA);
+    const size_t rb  = bfInst_getX(inst, RB);
+    const size_t rc  = bfInst_getX(inst, RC);
+    const size_t rbx = bfInst_getX(inst, RBx);
+
+    switch (bfInst_getX(inst, OP))
+    {
+      case BIFROST_VM_OP_LOAD_BASIC:
+      case BIFROST_VM_OP_LOAD_GLOBAL:
+      case BIFROST_VM_OP_STORE_GLOBAL:
+      case BIFROST_VM_OP_MATH_INC:
+      case BIFROST_VM_OP_JUMP_IF:
+      case BIFROST_VM_OP_JUMP_IF_NOT:
+      case BIFROST_VM_OP_SWITCH:
+        max_reg = ra;
+        break;
+      case BIFROST_VM_OP_LOAD_SYMBOL:
+        max_reg = ra > rb ? ra : rb;
+        break;
+      case BIFROST_VM_OP_STORE_SYMBOL:
+        max_reg = ra > rc ? ra : rc;
+        break;
+      case BIFROST_VM_OP_NEW_CONSTRUCT:
+        max_reg = ra > rb + 1u ? ra : rb + 1u;
+        break;
+      case BIFROST_VM_OP_STORE_MOVE:
+      case BIFROST_VM_OP_NEW_CLZ:
+      case BIFROST_VM_OP_NOT:
+        max_reg = ra > rbx ? ra : rbx;
+        break;
+      case BIFROST_VM_OP_CALL_FN:
+        max_reg = ra + (rc ? rc : 1u); /* Natives write their return value to the first argument slot. */
+        max_reg = max_reg > rb ? max_reg : rb;
+        break;
+      case BIFROST_VM_OP_JUMP:
+        break;
+      case BIFROST_VM_OP_RETURN:
+        max_reg = rbx;
+        break;
+      default: /* rA = rB <op> rC */
+        max_reg = ra > rb ? ra : rb;
+        max_reg = max_reg > rc ? max_reg : rc;
+        break;
+    }
+
+    if (result < max_reg + 1)
+    {
+      result = max_reg + 1;
+    }
+  }
+
+  return result;
+}
+
 void bfFuncBuilder_end(BifrostVMFunctionBuilder* self, BifrostObjFn* out, int arity)
 {
+  bfFuncBuilder_addInstABx(self, BIFROST_VM_OP_LOAD_BASIC, 0, BIFROST_VM_OP_LOAD_BASIC_NULL);
   bfFuncBuilder_addInstABx(self, BIFROST_VM_OP_RETURN, 0, 0);
   bfFuncBuilder_popScope(self);
 
-  out->super.type         = BIFROST_VM_OBJ_FUNCTION;
-  out->name               = bfVMString_newLen(self->vm, self->name, self->name_len);
+  const size_t         num_instructions = bfVMArray_size(&self->instructions);
+  const size_t         num_constants    = bfVMArray_size(&self->constants);
+  const uint8_t* const line_table       = self->vm->params.strip_debug_info ? NULL : bfVMLineTable_encode(self->vm, self->arena, self->code_to_line, bfVMArray_size(&self->code_to_line));
+  const size_t         line_table_size  = line_table ? bfVMArray_size(&line_table) : 0u;
+
+  out->super.type = BIFROST_VM_OBJ_FUNCTION;
+  bfObjFn_allocCode(self->vm, out, num_instructions, num_constants, line_table_size, self->name, self->name_len);
+  LibC_memcpy(out->instructions, self->instructions, sizeof(bfInstruction) * num_instructions);
+  LibC_memcpy(out->constants, self->constants, sizeof(BifrostValue) * num_constants);
+
+  if (line_table_size)
+  {
+    LibC_memcpy(out->line_table, line_table, line_table_size);
+  }
+
   out->arity              = arity;
-  out->code_to_line       = self->code_to_line;
-  out->constants          = self->constants;
-  out->instructions       = self->instructions;
-  out->needed_stack_space = self->max_local_idx + arity + 1;
+  out->needed_stack_space = bfFuncBuilder__neededStackSpace(self, arity);
+  out->image              = NULL;
+  out->image_fn           = NULL;
+  out->image_objects      = NULL;
+  out->ctor_sites         = NULL;
+
+  const size_t num_ctor_sites = bfVMArray_size(&self->ctor_sites);
+
+  if (num_ctor_sites)
+  {
+    out->ctor_sites = bfVMArray_new(self->vm, BifrostVMCtorSite, num_ctor_sites);
+    bfVMArray_resize(self->vm, &out->ctor_sites, num_ctor_sites);
 
-  // Transfer of ownership of the constants to output function.
+    for (size_t i = 0; i < num_ctor_sites; ++i)
+    {
+      bfObjFn_initCtorSite(out->ctor_sites + i, self->ctor_sites[i]);
+    }
+  }
+
+  // The arena copies are dead now, the output function owns its own.
   self->constants = NULL;
 }
 
 void bfFuncBuilder_dtor(BifrostVMFunctionBuilder* self)
 {
-  bfVMArray_delete(self->vm, &self->local_vars);
-  bfVMArray_delete(self->vm, &self->local_var_scope_size);
+  // NOTE(SR): Everything the builder allocated belongs to the arena, it is released all at once by the parser.
+  self->constants            = NULL;
+  self->instructions         = NULL;
+  self->code_to_line         = NULL;
+  self->ctor_sites           = NULL;
+  self->constant_slots       = NULL;
+  self->local_vars           = NULL;
+  self->local_var_chain      = NULL;
+  self->local_var_scope_size = NULL;
 }
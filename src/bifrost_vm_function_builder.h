@@ -19,31 +19,41 @@
 extern "C" {
 #endif
 
-typedef struct BifrostVM    BifrostVM;
-typedef struct BifrostObjFn BifrostObjFn;
-typedef struct BifrostLexer BifrostLexer;
-typedef struct string_range string_range;
+typedef struct BifrostVM      BifrostVM;
+typedef struct BifrostVMArena BifrostVMArena;
+typedef struct BifrostObjFn   BifrostObjFn;
+typedef struct BifrostLexer   BifrostLexer;
+typedef struct string_range   string_range;
 
 typedef int bfScopeVarCount;
 
+#define BIFROST_VM_MAX_INLINE_SIZE      32  /*!< Upper bound on the number of instructions a function can have and still be inlined. */
+#define BIFROST_VM_LOCAL_VAR_NUM_BUCKETS 128 /*!< Must be a power of two, locals are bounded by the register count so this stays small. */
+
 typedef struct BifrostVMFunctionBuilder
 {
   const char*      name;     /*!< Stored in the source so no need to dynamically alloc */
   size_t           name_len; /*!< Length of [BifrostVMFunctionBuilder::name] */
   BifrostValue*       constants;
+  uint32_t*        constant_slots; /*!< Open addressed hash index into [constants], a slot holds 'index + 1' and 0 when empty. */
   string_range*    local_vars; /*!< Stored in the source so no need to dynamically alloc */
+  uint32_t*        local_var_chain; /*!< Parallel to [local_vars], the previous variable in the same bucket as 'index + 1'. */
+  uint32_t         local_var_buckets[BIFROST_VM_LOCAL_VAR_NUM_BUCKETS]; /*!< Name hash to the most recent [local_vars] 'index + 1'. */
   bfScopeVarCount* local_var_scope_size;
   uint32_t*        instructions;
-  uint16_t*        code_to_line;
-  size_t           max_local_idx;
+  uint32_t*        code_to_line; /*!< Parallel to [instructions], 'bfFuncBuilder_end' encodes it into the function's line table. */
+  uint32_t*        ctor_sites;   /*!< The constructor symbol of each 'NEW_CONSTRUCT', indexed by its rC. */
   BifrostVM*       vm;
+  BifrostVMArena*  arena; /*!< Every array above is allocated from here, 'bfFuncBuilder_end' copies the output into vm memory. */
   size_t*          current_line_no;
 
 } BifrostVMFunctionBuilder;
 
-void     bfFuncBuilder_ctor(BifrostVMFunctionBuilder* self, BifrostLexer* lexer);
+void     bfFuncBuilder_ctor(BifrostVMFunctionBuilder* self, BifrostLexer* lexer, BifrostVMArena* arena);
 void     bfFuncBuilder_begin(BifrostVMFunctionBuilder* self, const char* name, size_t length);
 uint32_t bfFuncBuilder_addConstant(BifrostVMFunctionBuilder* self, const BifrostValue value);
+uint32_t bfFuncBuilder_addConstantTable(BifrostVMFunctionBuilder* self, const BifrostValue* values, size_t num_values); /* Returns the index of the first value. */
+uint32_t bfFuncBuilder_addCtorSite(BifrostVMFunctionBuilder* self, uint32_t symbol); /* 'BIFROST_INST_RC_MASK + 1' once there are too many. */
 void     bfFuncBuilder_pushScope(BifrostVMFunctionBuilder* self);
 uint32_t bfFuncBuilder_declVariable(BifrostVMFunctionBuilder* self, const char* name, size_t length);
 uint16_t bfFuncBuilder_pushTemp(BifrostVMFunctionBuilder* self, uint16_t num_temps);
@@ -54,6 +64,12 @@ void     bfFuncBuilder_addInstABC(BifrostVMFunctionBuilder* self, bfInstructionO
 void     bfFuncBuilder_addInstABx(BifrostVMFunctionBuilder* self, bfInstructionOp op, uint16_t a, uint32_t bx);
 void     bfFuncBuilder_addInstAsBx(BifrostVMFunctionBuilder* self, bfInstructionOp op, uint16_t a, int32_t sbx);
 void     bfFuncBuilder_addInstBreak(BifrostVMFunctionBuilder* self);
+void     bfFuncBuilder_insertInstABx(BifrostVMFunctionBuilder* self, size_t index, bfInstructionOp op, uint16_t a, uint32_t bx);
+void     bfFuncBuilder_removeInst(BifrostVMFunctionBuilder* self, size_t index);
+bool     bfFuncBuilder_retargetLastInst(BifrostVMFunctionBuilder* self, size_t first_inst, uint16_t old_dst, uint16_t new_dst);
+bool     bfFuncBuilder_writesRegister(const BifrostVMFunctionBuilder* self, size_t first_inst, uint16_t reg);
+bool     bfFuncBuilder_canInline(const BifrostVMFunctionBuilder* self, const BifrostObjFn* fn, size_t max_insts, uint16_t base);
+void     bfFuncBuilder_inlineFunction(BifrostVMFunctionBuilder* self, const BifrostObjFn* fn, uint16_t base);
 void     bfFuncBuilder_end(BifrostVMFunctionBuilder* self, BifrostObjFn* out, int arity);
 void     bfFuncBuilder_dtor(BifrostVMFunctionBuilder* self);
 
@@ -45,6 +45,7 @@ static void   bfGCMarkValue(BifrostValue value, uint8_t mark_value);
 static void   bfGCMarkValues(BifrostValue* values, uint8_t mark_value);
 static void   bfGCMarkValuesN(BifrostValue* values, size_t size, uint8_t mark_value);
 static void   bfGCMarkObj(BifrostObj* obj, uint8_t mark_value);
+static void   bfGCMarkFnConstants(BifrostObjFn* fn, uint8_t mark_value);
 static void   bfGCMarkSymbols(BifrostVMSymbol* symbols, uint8_t mark_value);
 static void   bfGCFinalize(BifrostVM* self);
 
@@ -105,6 +106,11 @@ static void bfGCMarkObjects(struct BifrostVM* self)
       bfGCMarkObj(&parsers->current_clz->super, GC_MARK_REACHABLE);
     }
 
+    if (parsers->lazy_source)
+    {
+      bfGCMarkObj(&parsers->lazy_source->super, GC_MARK_REACHABLE);
+    }
+
     const size_t num_builders = bfVMArray_size(&parsers->fn_builder_stack);
 
     for (size_t i = 0; i < num_builders; ++i)
@@ -172,9 +178,9 @@ static size_t bfGCSweep(struct BifrostVM* self)
       BifrostObjInstance* const inst = (BifrostObjInstance*)g_cursor;
       BifrostObjClass* const    clz  = inst->clz;
 
-      if (clz && dtor_symbol < bfVMArray_size(&clz->symbols))
+      if (clz)
       {
-        const BifrostValue value = clz->symbols[dtor_symbol].value;
+        const BifrostValue value = bfObjClass_ownSymbol(self, clz, self->symbols[dtor_symbol]);
 
         if (bfVMValue_isPointer(value) && bfObj_IsFunction(bfVMValue_asPointer(value)))
         {
@@ -366,6 +372,19 @@ static void bfGCMarkValuesN(BifrostValue* values, size_t size, uint8_t mark_valu
   }
 }
 
+/* NOTE(SR): The constants of an image function are read only, its materialized objects live on the side. */
+static void bfGCMarkFnConstants(BifrostObjFn* fn, uint8_t mark_value)
+{
+  if (fn->image)
+  {
+    bfGCMarkValues(fn->image_objects, mark_value);
+  }
+  else
+  {
+    bfGCMarkValuesN(fn->constants, fn->num_constants, mark_value);
+  }
+}
+
 static void bfGCMarkObj(BifrostObj* obj, uint8_t mark_value)
 {
   if (!obj->gc_mark)
@@ -382,7 +401,7 @@ static void bfGCMarkObj(BifrostObj* obj, uint8_t mark_value)
         if (module->init_fn.name)
         {
           bfGCMarkObj(&module->init_fn.super, mark_value);
-          bfGCMarkValues(module->init_fn.constants, mark_value);
+          bfGCMarkFnConstants(&module->init_fn, mark_value);
         }
         break;
       }
@@ -413,7 +432,15 @@ static void bfGCMarkObj(BifrostObj* obj, uint8_t mark_value)
       case BIFROST_VM_OBJ_FUNCTION:
       {
         BifrostObjFn* const fn = (BifrostObjFn*)obj;
-        bfGCMarkValues(fn->constants, mark_value);
+
+        if (fn->lazy_source)
+        {
+          bfGCMarkObj(&fn->lazy_source->super, mark_value);
+        }
+        else
+        {
+          bfGCMarkFnConstants(fn, mark_value);
+        }
         break;
       }
       case BIFROST_VM_OBJ_NATIVE_FN:
@@ -467,7 +494,7 @@ static void bfGCFinalize(BifrostVM* self)
   while (cursor)
   {
     BifrostObjClass* const clz   = cursor->clz;
-    const BifrostValue        value = clz->symbols[dtor_symbol].value;
+    const BifrostValue        value = bfObjClass_ownSymbol(self, clz, self->symbols[dtor_symbol]);
 
     // TODO(SR):
     //   Investigate if this breaks some reentrancy model rules.
@@ -38,7 +38,7 @@ extern "C" {
 //   BIFROST_VM_OP_BIT_LS,   // rA = (rB << rC)
 //   BIFROST_VM_OP_BIT_RS,   // rA = (rB >> rC)
 
-// Total of 26 / 32 possible ops.
+// Total of 31 / 32 possible ops.
 
 /*!
    ///////////////////////////////////////////
@@ -58,11 +58,14 @@ extern "C" {
   /* Load OPs  */                                                                                                                                        \
   BF_INST_OP(LOAD_SYMBOL, "rA = rB.SYMBOLS[rC]")                                                                                                         \
   BF_INST_OP(LOAD_BASIC, "rA = (rBx == 0 : true) || (rBx == 1 : false) || (rBx == 2 : null) || (rBx == 3 : <current-module>) || (rBx > 3 : K[rBx - 4])") \
+  BF_INST_OP(LOAD_GLOBAL, "rA = <current-module>.VARIABLES[rBx]")                                                                                        \
   /* Store OPs */                                                                                                                                        \
   BF_INST_OP(STORE_MOVE, "rA              = rBx")                                                                                                        \
   BF_INST_OP(STORE_SYMBOL, "rA.SYMBOLS[rB] = rC")                                                                                                        \
+  BF_INST_OP(STORE_GLOBAL, "<current-module>.VARIABLES[rBx] = rA")                                                                                       \
   /* Memory OPs */                                                                                                                                       \
   BF_INST_OP(NEW_CLZ, "rA = new local[rBx];")                                                                                                            \
+  BF_INST_OP(NEW_CONSTRUCT, "rA = new rB, rB = rB.SYMBOLS[CTOR_SITES[rC]], rB + 1 = rA (always followed by the ctor's CALL_FN)")                         \
   /* Math OPs */                                                                                                                                         \
   BF_INST_OP(MATH_ADD, "rA = rB + rC")                                                                                                                   \
   BF_INST_OP(MATH_SUB, "rA = rB - rC")                                                                                                                   \
@@ -71,6 +74,7 @@ extern "C" {
   BF_INST_OP(MATH_MOD, "rA = rB % rC")                                                                                                                   \
   BF_INST_OP(MATH_POW, "rA = rB ^ rC")                                                                                                                   \
   BF_INST_OP(MATH_INV, "rA = -rB")                                                                                                                       \
+  BF_INST_OP(MATH_INC, "rA = rA + rsBx (a negative rsBx is a subtraction)")                                                                              \
   /* Comparisons */                                                                                                                                      \
   BF_INST_OP(CMP_EE, "rA = rB == rC")                                                                                                                    \
   BF_INST_OP(CMP_NE, "rA = rB != rC")                                                                                                                    \
@@ -82,10 +86,11 @@ extern "C" {
   BF_INST_OP(CMP_OR, "rA = rB || rC")                                                                                                                    \
   BF_INST_OP(NOT, "rA = !rBx")                                                                                                                           \
   /* Control Flow */                                                                                                                                     \
-  BF_INST_OP(CALL_FN, "call(local[rB]) (params-start = rA, num-args = rC)")                                                                              \
+  BF_INST_OP(CALL_FN, "local[rA] = call(local[rB]) (params-start = rA + 1, num-args = rC)")                                                              \
   BF_INST_OP(JUMP, "ip += rsBx")                                                                                                                         \
   BF_INST_OP(JUMP_IF, "if (rA) ip += rsBx")                                                                                                              \
   BF_INST_OP(JUMP_IF_NOT, "if (!rA) ip += rsBx")                                                                                                         \
+  BF_INST_OP(SWITCH, "ip += K[rBx] table entry of rA, falls through to the next instruction when there is none")                                          \
   BF_INST_OP(RETURN, "pop the current call frame.")
 
 typedef enum bfInstructionOp
@@ -117,9 +122,18 @@ typedef uint32_t bfInstruction;
 #define BIFROST_MAKE_INST_OP(op) \
   (bfInstruction)(op & BIFROST_INST_OP_MASK)
 
+#define BIFROST_MAKE_INST_RA(a) \
+  ((a & BIFROST_INST_RA_MASK) << BIFROST_INST_RA_OFFSET)
+
+#define BIFROST_MAKE_INST_RB(b) \
+  ((b & BIFROST_INST_RB_MASK) << BIFROST_INST_RB_OFFSET)
+
 #define BIFROST_MAKE_INST_RC(c) \
   ((c & BIFROST_INST_RC_MASK) << BIFROST_INST_RC_OFFSET)
 
+#define BIFROST_MAKE_INST_RBx(bx) \
+  ((bx & BIFROST_INST_RBx_MASK) << BIFROST_INST_RBx_OFFSET)
+
 #define BIFROST_MAKE_INST_OP_ABC(op, a, b, c)               \
   BIFROST_MAKE_INST_OP(op) |                                \
    ((a & BIFROST_INST_RA_MASK) << BIFROST_INST_RA_OFFSET) | \
@@ -145,6 +159,14 @@ typedef uint32_t bfInstruction;
  */
 #define bfInst_patchX(inst, x, val) *(inst) = (*(inst) & ~(BIFROST_INST_##x##_MASK << BIFROST_INST_##x##_OFFSET)) | BIFROST_MAKE_INST_##x(val)
 
+/* NOTE(SR):
+    The read counterpart to 'bfInst_patchX'.
+
+    inst : bfInstruction;
+    x    : can be one of - OP, RA, RB, RC, RBx
+ */
+#define bfInst_getX(inst, x) (((inst) >> BIFROST_INST_##x##_OFFSET) & BIFROST_INST_##x##_MASK)
+
 #if __cplusplus
 }
 #endif
@@ -11,9 +11,234 @@
 #include "bifrost_vm_lexer.h"
 
 #include "bifrost/bifrost_vm.h"  // bfVM_SetLastError
+#include "bifrost_vm_arena.h"    // BifrostVMArena
+#include "bifrost_vm_gc.h"       // bfGC_AllocMemory
+#include "bifrost_vm_obj.h"      // bfVMArray_newArena, bfVMString_hashN
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define BF_LEXER_SIMD_X86 1
+#include <emmintrin.h> /* SSE2 */
+#include <immintrin.h> /* AVX2 */
+#if defined(_MSC_VER)
+#include <intrin.h> /* __cpuid, __cpuidex, _BitScanForward */
+#endif
+#else
+#define BF_LEXER_SIMD_X86 0
+#endif
 
 static const char BTS_COMMENT_CHARACTER = '/';
 
+#define BF_LEXER_STREAM_LOOK_AHEAD   1024u  /*!< Available before every token of a streamed source, longer identifiers and numbers get split. */
+#define BF_LEXER_STREAM_CHUNK_SIZE   65536u /*!< How much the window grows by when a token does not fit.                                     */
+#define BF_LEXER_STREAM_NUM_BUCKETS  4096u  /*!< Must be a power of two.                                                                      */
+
+typedef struct bfLexerInternedStr
+{
+  string_range value;
+  uint32_t     next; /*!< 'index + 1' of the next string in the same bucket. */
+
+} bfLexerInternedStr;
+
+/*
+  NOTE(SR):
+    A streamed source is only ever partly in memory, the window is slid
+    forward (dropping everything before the current token and line) and refilled
+    on demand. Since the parser holds onto token text for as long as it likes,
+    identifiers and strings are interned into [strings] rather than pointing
+    into the window.
+*/
+struct BifrostLexerStream
+{
+  bfSourceReadFn      read_fn;
+  void*               user_data;
+  char*               window;
+  size_t              window_capacity;
+  size_t              window_offset; /*!< Position of the window's first character in the whole source.             */
+  size_t              token_bgn;     /*!< Offset in the window of the token being lexed, it must not be slid out. */
+  bool                is_done;
+  BifrostVMArena      strings;
+  bfLexerInternedStr* interned;
+  uint32_t            buckets[BF_LEXER_STREAM_NUM_BUCKETS];
+};
+
+enum
+{
+  BF_CHAR_SPACE   = (1 << 0), /*!< ' ', '\t', '\n', '\v', '\f', '\r'                 */
+  BF_CHAR_DIGIT   = (1 << 1), /*!< 0123456789                                       */
+  BF_CHAR_ID      = (1 << 2), /*!< abcdefghijklmnopqrstuvwxyz_0123456789 (any case) */
+  BF_CHAR_NEWLINE = (1 << 3), /*!< '\n', '\r', '\0'                                   */
+};
+
+/*
+  NOTE(SR):
+    Classification is a single table lookup rather than the locale
+    dependent <ctype.h> functions, bytes outside of ASCII are in no class.
+*/
+#define S BF_CHAR_SPACE
+#define D BF_CHAR_DIGIT
+#define I BF_CHAR_ID
+#define N BF_CHAR_NEWLINE
+static const uint8_t k_CharClass[256] =
+ {
+      N,   0,   0,   0,   0,   0,   0,   0,   0,   S, S|N,   S,   S, S|N,   0,   0, /* 0x00 */
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, /* 0x10 */
+      S,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, /* 0x20 */
+    D|I, D|I, D|I, D|I, D|I, D|I, D|I, D|I, D|I, D|I,   0,   0,   0,   0,   0,   0, /* 0x30 */
+      0,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I, /* 0x40 */
+      I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   0,   0,   0,   0,   I, /* 0x50 */
+      0,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I, /* 0x60 */
+      I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   I,   0,   0,   0,   0,   0, /* 0x70 */
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, /* 0x80 */
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, /* 0x90 */
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, /* 0xA0 */
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, /* 0xB0 */
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, /* 0xC0 */
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, /* 0xD0 */
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, /* 0xE0 */
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, /* 0xF0 */
+};
+#undef S
+#undef D
+#undef I
+#undef N
+
+static bool bfLexer_charIs(char c, uint8_t char_class)
+{
+  return (k_CharClass[(unsigned char)c] & char_class) != 0;
+}
+
+/*
+  NOTE(SR):
+    Block comments and string literals make up most of the bytes in large
+    (generated) scripts so finding the end of them is done a whole vector
+    at a time, see 'bfLexerScanFn'.
+
+    Newlines are always a stop so that the caller can still land on each of
+    them with 'bfLexer_advance' keeping 'current_line_no' correct.
+*/
+static const char* bfLexer_scanForScalar(const char* bgn, const char* end, char stop0, char stop1)
+{
+  while (bgn < end && *bgn != stop0 && *bgn != stop1 && !bfLexer_charIs(*bgn, BF_CHAR_NEWLINE))
+  {
+    ++bgn;
+  }
+
+  return bgn;
+}
+
+#if BF_LEXER_SIMD_X86
+
+static int bfLexer_firstBitSet(uint32_t mask)
+{
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return (int)index;
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+static const char* bfLexer_scanForSSE2(const char* bgn, const char* end, char stop0, char stop1)
+{
+  const __m128i v_stop0 = _mm_set1_epi8(stop0);
+  const __m128i v_stop1 = _mm_set1_epi8(stop1);
+  const __m128i v_lf    = _mm_set1_epi8('\n');
+  const __m128i v_cr    = _mm_set1_epi8('\r');
+  const __m128i v_nul   = _mm_setzero_si128();
+
+  while (end - bgn >= 16)
+  {
+    const __m128i chunk = _mm_loadu_si128((const __m128i*)bgn);
+    const __m128i hits  = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, v_stop0), _mm_cmpeq_epi8(chunk, v_stop1)),
+                                      _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, v_lf), _mm_cmpeq_epi8(chunk, v_cr)),
+                                                   _mm_cmpeq_epi8(chunk, v_nul)));
+    const uint32_t mask = (uint32_t)_mm_movemask_epi8(hits);
+
+    if (mask)
+    {
+      return bgn + bfLexer_firstBitSet(mask);
+    }
+
+    bgn += 16;
+  }
+
+  return bfLexer_scanForScalar(bgn, end, stop0, stop1);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+static const char*
+bfLexer_scanForAVX2(const char* bgn, const char* end, char stop0, char stop1)
+{
+  const __m256i v_stop0 = _mm256_set1_epi8(stop0);
+  const __m256i v_stop1 = _mm256_set1_epi8(stop1);
+  const __m256i v_lf    = _mm256_set1_epi8('\n');
+  const __m256i v_cr    = _mm256_set1_epi8('\r');
+  const __m256i v_nul   = _mm256_setzero_si256();
+
+  while (end - bgn >= 32)
+  {
+    const __m256i chunk = _mm256_loadu_si256((const __m256i*)bgn);
+    const __m256i hits  = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, v_stop0), _mm256_cmpeq_epi8(chunk, v_stop1)),
+                                         _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, v_lf), _mm256_cmpeq_epi8(chunk, v_cr)),
+                                                         _mm256_cmpeq_epi8(chunk, v_nul)));
+    const uint32_t mask = (uint32_t)_mm256_movemask_epi8(hits);
+
+    if (mask)
+    {
+      return bgn + bfLexer_firstBitSet(mask);
+    }
+
+    bgn += 32;
+  }
+
+  return bfLexer_scanForSSE2(bgn, end, stop0, stop1);
+}
+
+static bool bfLexer_cpuHasAVX2(void)
+{
+#if defined(_MSC_VER)
+  int info[4];
+
+  __cpuid(info, 0);
+
+  if (info[0] < 7)
+  {
+    return false;
+  }
+
+  __cpuid(info, 1);
+
+  /* OSXSAVE and AVX, then make sure the OS saves the YMM registers. */
+  if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+  {
+    return false;
+  }
+
+  __cpuidex(info, 7, 0);
+
+  return (info[1] & (1 << 5)) != 0;
+#elif defined(__GNUC__) || defined(__clang__)
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+#else
+  return false;
+#endif
+}
+
+#endif /* BF_LEXER_SIMD_X86 */
+
+static bfLexerScanFn bfLexer_selectScanFn(void)
+{
+#if BF_LEXER_SIMD_X86
+  return bfLexer_cpuHasAVX2() ? &bfLexer_scanForAVX2 : &bfLexer_scanForSSE2;
+#else
+  return &bfLexer_scanForScalar;
+#endif
+}
+
 static const char* bfLexer_peekStr(const BifrostLexer* self, size_t amt)
 {
   const char* target_str = self->source_bgn + self->cursor + amt;
@@ -41,7 +266,39 @@ static string_range bfLexer_currentLine(BifrostLexer* self)
 
 static bool bfLexer_isNewline(char c)
 {
-  return c == '\n' || c == '\r' || c == '\0';
+  return bfLexer_charIs(c, BF_CHAR_NEWLINE);
+}
+
+static void bfLexer_measureLine(BifrostLexer* self)
+{
+  const size_t source_length = self->source_end - self->source_bgn;
+
+  while (self->line_pos_end < source_length && !bfLexer_isNewline(self->source_bgn[self->line_pos_end]))
+  {
+    ++self->line_pos_end;
+  }
+
+  self->line_pos_end = self->line_pos_end < source_length ? self->line_pos_end + 1 : source_length;
+}
+
+static bool bfLexer_canRead(const BifrostLexer* self)
+{
+  return self->stream && !self->stream->is_done;
+}
+
+/*
+  NOTE(SR):
+    The cursor as an offset into the whole source, unlike 'cursor'
+    this stays valid across a 'bfLexer_fill'.
+*/
+static size_t bfLexer_position(const BifrostLexer* self)
+{
+  return (self->stream ? self->stream->window_offset : 0u) + self->cursor;
+}
+
+static const char* bfLexer_positionStr(const BifrostLexer* self, size_t position)
+{
+  return self->source_bgn + (position - (self->stream ? self->stream->window_offset : 0u));
 }
 
 static void bfLexer_advance(BifrostLexer* self, size_t amt)
@@ -56,21 +313,110 @@ static void bfLexer_advance(BifrostLexer* self, size_t amt)
 
   const char curr = bfLexer_peek(self, 0);
 
-  if (bfLexer_isNewline(curr) || amt == 0)
+  if ((bfLexer_isNewline(curr) && !(bfLexer_canRead(self) && self->source_bgn + self->cursor >= self->source_end)) || amt == 0)
   {
-    const size_t source_length = self->source_end - self->source_bgn;
-
     ++self->current_line_no;
     self->line_pos_bgn = self->cursor + (curr == '\n');
     self->line_pos_end = self->line_pos_bgn + (curr == '\n');
 
-    while (!bfLexer_isNewline(self->source_bgn[self->line_pos_end]) && self->line_pos_end < source_length)
+    bfLexer_measureLine(self);
+  }
+}
+
+/*
+  NOTE(SR):
+    Makes sure at least [look_ahead] characters past the cursor are in the
+    window, unless the stream ends first. Pointers into the window are
+    invalid afterwards, offsets (the cursor, line and token position) are kept up to date.
+*/
+static void bfLexer_fill(BifrostLexer* self, size_t look_ahead)
+{
+  BifrostLexerStream* const stream = self->stream;
+  size_t                    size   = self->source_end - self->source_bgn;
+
+  if (!stream || stream->is_done || self->cursor + look_ahead <= size)
+  {
+    return;
+  }
+
+  /* NOTE(SR): Landing on the end of the window is not a newline, whether it was is only known after the read. */
+  const bool is_line_deferred = self->cursor == size;
+  size_t     discard          = self->cursor < size ? self->cursor : size;
+
+  discard = self->line_pos_bgn < discard ? self->line_pos_bgn : discard;
+  discard = stream->token_bgn < discard ? stream->token_bgn : discard;
+
+  /* NOTE(SR): The first fill has no window yet (and nothing to keep). */
+  if (stream->window && discard != 0u && size != discard)
+  {
+    LibC_memmove(stream->window, stream->window + discard, size - discard);
+  }
+
+  size -= discard;
+  stream->window_offset += discard;
+  self->cursor -= discard;
+  self->line_pos_bgn -= discard;
+  stream->token_bgn -= discard;
+
+  const size_t needed_capacity = size + look_ahead + BF_LEXER_STREAM_CHUNK_SIZE + 1u;
+
+  if (needed_capacity > stream->window_capacity)
+  {
+    stream->window          = bfGC_AllocMemory(self->vm, stream->window, stream->window_capacity, needed_capacity);
+    stream->window_capacity = needed_capacity;
+  }
+
+  while (size < self->cursor + look_ahead)
+  {
+    const size_t num_read = stream->read_fn(stream->user_data, stream->window + size, stream->window_capacity - size - 1u);
+
+    if (num_read == 0u)
     {
-      ++self->line_pos_end;
+      stream->is_done = true;
+      break;
     }
 
-    self->line_pos_end = self->line_pos_end < source_length ? self->line_pos_end + 1 : source_length;
+    size += num_read;
   }
+
+  stream->window[size] = '\0';
+  self->source_bgn     = stream->window;
+  self->source_end     = stream->window + size;
+  self->line_pos_end   = self->line_pos_bgn;
+
+  bfLexer_measureLine(self);
+
+  if (is_line_deferred && bfLexer_isNewline(self->source_bgn[self->cursor]))
+  {
+    bfLexer_advance(self, 0);
+  }
+}
+
+static string_range bfLexer_intern(BifrostLexer* self, string_range value)
+{
+  BifrostLexerStream* const stream = self->stream;
+  uint32_t* const           bucket = stream->buckets + (bfVMString_hashN(value.str_bgn, value.str_len) & (BF_LEXER_STREAM_NUM_BUCKETS - 1u));
+
+  for (uint32_t index = *bucket; index != 0u; index = stream->interned[index - 1u].next)
+  {
+    const string_range interned = stream->interned[index - 1u].value;
+
+    if (interned.str_len == value.str_len && LibC_memcmp(interned.str_bgn, value.str_bgn, value.str_len) == 0)
+    {
+      return interned;
+    }
+  }
+
+  char* const copy = bfVMArena_alloc(&stream->strings, value.str_len + 1u);
+  LibC_memcpy(copy, value.str_bgn, value.str_len);
+  copy[value.str_len] = '\0';
+
+  bfLexerInternedStr* const entry = bfVMArray_emplace(self->vm, &stream->interned);
+  entry->value                    = MakeStringLen(copy, value.str_len);
+  entry->next                     = *bucket;
+  *bucket                         = (uint32_t)bfVMArray_size(&stream->interned);
+
+  return entry->value;
 }
 
 static void bfLexer_reset(BifrostLexer* self)
@@ -82,28 +428,79 @@ static void bfLexer_reset(BifrostLexer* self)
   bfLexer_advance(self, 0);
 }
 
-static void bfLexer_skipWhile(BifrostLexer* self, bool (*condition)(char c))
+/*
+  NOTE(SR):
+    Skips characters for as long as their class matches [char_class] (or doesn't
+    when [is_in_class] is false). The cursor only moves once per run since
+    'bfLexer_advance' only has to look at the character it lands on,
+    runs are split at newlines so each one is still counted.
+*/
+static void bfLexer_skipWhile(BifrostLexer* self, uint8_t char_class, bool is_in_class)
 {
-  while (condition(bfLexer_peek(self, 0)) && self->source_bgn + self->cursor < self->source_end)
+  const char* const source_end = self->source_end;
+
+  while (self->source_bgn + self->cursor < source_end)
   {
-    bfLexer_advance(self, 1);
+    const char* const bgn = self->source_bgn + self->cursor;
+    const char*       end = bgn;
+
+    while (end < source_end && bfLexer_charIs(*end, char_class) == is_in_class && !bfLexer_charIs(*end, BF_CHAR_NEWLINE))
+    {
+      ++end;
+    }
+
+    if (end != bgn)
+    {
+      bfLexer_advance(self, end - bgn);
+    }
+    else if (end < source_end && bfLexer_charIs(*end, char_class) == is_in_class)
+    {
+      bfLexer_advance(self, 1);
+    }
+    else
+    {
+      break;
+    }
   }
 }
 
 static void bfLexer_skipWhitespace(BifrostLexer* self)
 {
-  bfLexer_skipWhile(self, &LibC_isspace);
+  bfLexer_skipWhile(self, BF_CHAR_SPACE, true);
 }
 
-static bool bfLexer_isNotNewline(char c)
+/*
+  NOTE(SR):
+    Moves the cursor onto the next [stop0], [stop1] or newline character.
+    Returns that character (or the one at 'source_end').
+*/
+static char bfLexer_advanceTo(BifrostLexer* self, char stop0, char stop1)
 {
-  return !bfLexer_isNewline(c);
+  for (;;)
+  {
+    const char* const bgn  = self->source_bgn + self->cursor;
+    const char* const stop = bgn < self->source_end ? self->scan_fn(bgn, self->source_end, stop0, stop1) : bgn;
+
+    if (stop != bgn)
+    {
+      bfLexer_advance(self, stop - bgn);
+    }
+
+    if (stop != self->source_end || !bfLexer_canRead(self))
+    {
+      break;
+    }
+
+    bfLexer_fill(self, BF_LEXER_STREAM_CHUNK_SIZE);
+  }
+
+  return bfLexer_peek(self, 0);
 }
 
 static void bfLexer_skipLineComment(BifrostLexer* self)
 {
   bfLexer_advance(self, 2); /* // */
-  bfLexer_skipWhile(self, &bfLexer_isNotNewline);
+  bfLexer_advanceTo(self, '\n', '\n');
 }
 
 static void bfLexer_skipBlockComment(BifrostLexer* self)
@@ -111,9 +508,9 @@ static void bfLexer_skipBlockComment(BifrostLexer* self)
   const size_t line_no = self->current_line_no;
   bfLexer_advance(self, 2); /* / * */
 
-  while (bfLexer_peek(self, 0) != '*' || bfLexer_peek(self, 1) != '/')
+  while (bfLexer_advanceTo(self, '*', '*') != '*' || (bfLexer_fill(self, 2), bfLexer_peek(self, 1) != '/'))
   {
-    if (bfLexer_peek(self, 0) == '\0')
+    if (bfLexer_peek(self, 0) == '\0' || self->source_bgn + self->cursor >= self->source_end)
     {
       bfVM_SetLastError(BIFROST_VM_ERROR_LEXER,
                         self->vm,
@@ -131,19 +528,19 @@ static void bfLexer_skipBlockComment(BifrostLexer* self)
 
 static void bfLexer_advanceLine(BifrostLexer* self)
 {
-  bfLexer_skipWhile(self, &bfLexer_isNotNewline);
+  bfLexer_advanceTo(self, '\n', '\n');
 }
 
 static bool bfLexer_isFollowedByDigit(BifrostLexer* self, char c, char m)
 {
-  return c == m && LibC_isdigit(bfLexer_peek(self, 1));
+  return c == m && bfLexer_charIs(bfLexer_peek(self, 1), BF_CHAR_DIGIT);
 }
 
 static bfToken bfLexer_parseNumber(BifrostLexer* self)
 {
   const char*  bgn   = bfLexer_peekStr(self, 0);
-  char*        end   = NULL;
-  const double value = LibC_strtod(bgn, &end);
+  const char*  end   = NULL;
+  const double value = bfVM_parseNumber(bgn, self->source_end, &end);
   bfLexer_advance(self, end - bgn);
 
   const char current = bfLexer_peek(self, 0);
@@ -158,44 +555,63 @@ static bfToken bfLexer_parseNumber(BifrostLexer* self)
 
 static bool bfLexer_isID(char c)
 {
-  return LibC_isalpha(c) || c == '_' || LibC_isdigit(c);
+  return bfLexer_charIs(c, BF_CHAR_ID);
 }
 
+/*
+  NOTE(SR):
+    Perfect hash of the keywords, every keyword lands in a unique slot so
+    an identifier is only ever compared against at most one of them.
+    Must be regenerated if a keyword is added.
+*/
+#define BF_KEYWORD_HASH(first, last, length) (((unsigned)(unsigned char)(first) + (unsigned)(unsigned char)(last) * 17u + (unsigned)(length) * 4u) & 63u)
+#define BF_KEYWORD_MAX_LENGTH                7u
+
 static bfToken bfLexer_parseID(BifrostLexer* self)
 {
-  static const bfToken s_Keywords[] =
+  static const bfToken s_Keywords[64] =
    {
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CONST_BOOL, "true"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CONST_BOOL, "false"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_RETURN, "return"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CTRL_IF, "if"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CTRL_ELSE, "else"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CTRL_FOR, "for"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CTRL_WHILE, "while"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_FUNC, "func"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_VAR, "var"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CONST_NIL, "nil"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CLASS, "class"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_IMPORT, "import"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CTRL_BREAK, "break"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_NEW, "new"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_STATIC, "static"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_AS, "as"),
-    BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_SUPER, "super"),
+    [0]  = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CTRL_WHILE, "while"),
+    [4]  = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CTRL_FOR, "for"),
+    [9]  = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_FUNC, "func"),
+    [12] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_AS, "as"),
+    [17] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CTRL_BREAK, "break"),
+    [20] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_VAR, "var"),
+    [24] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_RETURN, "return"),
+    [25] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_SUPER, "super"),
+    [26] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CLASS, "class"),
+    [30] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_STATIC, "static"),
+    [33] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_NEW, "new"),
+    [38] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CONST_NIL, "nil"),
+    [40] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CTRL_CASE, "case"),
+    [42] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CTRL_ELSE, "else"),
+    [43] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CONST, "const"),
+    [47] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CONST_BOOL, "false"),
+    [51] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CTRL_SWITCH, "switch"),
+    [52] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CTRL_DEFAULT, "default"),
+    [53] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_IMPORT, "import"),
+    [55] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CTRL_IF, "if"),
+    [57] = BIFROST_TOKEN_MAKE_ARRAY_INIT(BIFROST_TOKEN_CONST_BOOL, "true"),
    };
 
-  const char* bgn = bfLexer_peekStr(self, 0);
-  bfLexer_skipWhile(self, &bfLexer_isID);
-  const char*  end          = bfLexer_peekStr(self, 0);
-  const size_t length       = end - bgn;
-  const size_t num_keywords = bfCArraySize(s_Keywords);
+  const char* const bgn        = bfLexer_peekStr(self, 0);
+  const char* const source_end = self->source_end;
+  const char*       end        = bgn;
+
+  while (end < source_end && bfLexer_isID(*end))
+  {
+    ++end;
+  }
+
+  bfLexer_advance(self, end - bgn);
+
+  const size_t length = end - bgn;
 
-  for (size_t i = 0; i < num_keywords; ++i)
+  if (length != 0u && length <= BF_KEYWORD_MAX_LENGTH)
   {
-    const bfToken* keyword        = s_Keywords + i;
-    const size_t   keyword_length = keyword->str_range.str_len;
+    const bfToken* const keyword = s_Keywords + BF_KEYWORD_HASH(bgn[0], bgn[length - 1], length);
 
-    if (keyword_length == length && LibC_strncmp(keyword->str_range.str_bgn, bgn, length) == 0)
+    if (keyword->str_range.str_len == length && LibC_strncmp(keyword->str_range.str_bgn, bgn, length) == 0)
     {
       return *keyword;
     }
@@ -204,10 +620,8 @@ static bfToken bfLexer_parseID(BifrostLexer* self)
   return BIFROST_TOKEN_MAKE_STR_RANGE(BIFROST_TOKEN_IDENTIFIER, bgn, length);
 }
 
-static bool bfLexer_isNotQuote(char c)
-{
-  return c != '\"';
-}
+#undef BF_KEYWORD_HASH
+#undef BF_KEYWORD_MAX_LENGTH
 
 // Not handling the escape sequences in the lexer anymore.
 // it is now the parsers' job. (this simplifies the case where
@@ -217,23 +631,32 @@ static bfToken bfLexer_parseString(BifrostLexer* self)
 {
   bfLexer_advance(self, 1);  // '"'
 
-  const char* bgn = bfLexer_peekStr(self, 0);
+  const size_t bgn = bfLexer_position(self);
 
-  while (bfLexer_isNotQuote(bfLexer_peek(self, 0)) && self->source_bgn + self->cursor < self->source_end)
+  while (self->source_bgn + self->cursor < self->source_end)
   {
-    bfLexer_advance(self, 1);
+    const char c = bfLexer_advanceTo(self, '\"', '\\');
+
+    if (c == '\"' || self->source_bgn + self->cursor >= self->source_end)
+    {
+      break;
+    }
 
-    if (bfLexer_peek(self, 0) == '\\' && bfLexer_peek(self, 1) == '\"')
+    /* NOTE(SR): The escaped character is stepped onto separately in case it is a newline. */
+    if (c == '\\')
     {
-      bfLexer_advance(self, 2);
+      bfLexer_fill(self, 2);
+      bfLexer_advance(self, 1);
     }
+
+    bfLexer_advance(self, 1);
   }
 
-  const char* end = bfLexer_peekStr(self, 0);
+  const size_t end = bfLexer_position(self);
 
   bfLexer_advance(self, 1);  // '"'
 
-  return BIFROST_TOKEN_MAKE_STR_RANGE(BIFROST_TOKEN_CONST_STR, bgn, end - bgn);
+  return BIFROST_TOKEN_MAKE_STR_RANGE(BIFROST_TOKEN_CONST_STR, bfLexer_positionStr(self, bgn), end - bgn);
 }
 
 BifrostLexer bfLexer_make(const BifrostLexerParams* params)
@@ -242,19 +665,53 @@ BifrostLexer bfLexer_make(const BifrostLexerParams* params)
   self.source_bgn = params->source;
   self.source_end = params->source + params->length;
   self.vm         = params->vm;
+  self.stream     = NULL;
+  self.scan_fn    = bfLexer_selectScanFn();
+
+  if (params->read_fn)
+  {
+    BifrostLexerStream* const stream = bfGC_AllocMemory(params->vm, NULL, 0u, sizeof(BifrostLexerStream));
+
+    LibC_memset(stream, 0x0, sizeof(BifrostLexerStream));
+    stream->read_fn   = params->read_fn;
+    stream->user_data = params->read_user_data;
+    bfVMArena_ctor(&stream->strings, params->vm);
+    stream->interned = bfVMArray_newArena(&stream->strings, bfLexerInternedStr, 64);
+
+    self.stream       = stream;
+    self.source_bgn   = "";
+    self.source_end   = self.source_bgn;
+    self.cursor       = 0;
+    self.line_pos_bgn = 0;
+
+    bfLexer_fill(&self, BF_LEXER_STREAM_LOOK_AHEAD);
+  }
+
   bfLexer_reset(&self);
   return self;
 }
 
-bfToken bfLexer_nextToken(BifrostLexer* self)
+static void bfLexer_beginToken(BifrostLexer* self)
 {
+  if (self->stream)
+  {
+    bfLexer_fill(self, BF_LEXER_STREAM_LOOK_AHEAD);
+    self->stream->token_bgn = self->cursor;
+  }
+}
+
+static bfToken bfLexer_scanToken(BifrostLexer* self)
+{
+  bfLexer_beginToken(self);
+
   char current_char = bfLexer_peek(self, 0);
 
   while (current_char != '\0')
   {
+    bfLexer_beginToken(self);
     current_char = bfLexer_peek(self, 0);
 
-    if (LibC_isspace(current_char))
+    if (bfLexer_charIs(current_char, BF_CHAR_SPACE))
     {
       bfLexer_skipWhitespace(self);
       continue;
@@ -272,6 +729,11 @@ bfToken bfLexer_nextToken(BifrostLexer* self)
       {
         bfLexer_skipBlockComment(self);
       }
+      else if (next_char == '=')
+      {
+        bfLexer_advance(self, 2);
+        return BIFROST_TOKEN_MAKE_STR(BIFROST_TOKEN_DIV_EQUALS, "/=");
+      }
       else
       {
         bfLexer_advance(self, 1);
@@ -280,7 +742,7 @@ bfToken bfLexer_nextToken(BifrostLexer* self)
       continue;
     }
 
-    if (LibC_isdigit(current_char) || bfLexer_isFollowedByDigit(self, current_char, '.'))
+    if (bfLexer_charIs(current_char, BF_CHAR_DIGIT) || bfLexer_isFollowedByDigit(self, current_char, '.'))
     {
       return bfLexer_parseNumber(self);
     }
@@ -349,6 +811,12 @@ bfToken bfLexer_nextToken(BifrostLexer* self)
           return BIFROST_TOKEN_MAKE_STR(BIFROST_TOKEN_PLUS_EQUALS, "+=");
         }
 
+        if (next_char == '+')
+        {
+          bfLexer_advance(self, 1);
+          return BIFROST_TOKEN_MAKE_STR(BIFROST_TOKEN_INC, "++");
+        }
+
         return BIFROST_TOKEN_MAKE_STR(BIFROST_TOKEN_PLUS, "+");
       }
       case '-':
@@ -359,10 +827,22 @@ bfToken bfLexer_nextToken(BifrostLexer* self)
           return BIFROST_TOKEN_MAKE_STR(BIFROST_TOKEN_MINUS_EQUALS, "-=");
         }
 
+        if (next_char == '-')
+        {
+          bfLexer_advance(self, 1);
+          return BIFROST_TOKEN_MAKE_STR(BIFROST_TOKEN_DEC, "--");
+        }
+
         return BIFROST_TOKEN_MAKE_STR(BIFROST_TOKEN_MINUS, "-");
       }
       case '*':
       {
+        if (next_char == '=')
+        {
+          bfLexer_advance(self, 1);
+          return BIFROST_TOKEN_MAKE_STR(BIFROST_TOKEN_MULT_EQUALS, "*=");
+        }
+
         return BIFROST_TOKEN_MAKE_STR(BIFROST_TOKEN_MULT, "*");
       }
       case '/':
@@ -431,4 +911,33 @@ bfToken bfLexer_nextToken(BifrostLexer* self)
   }
 
   return (bfToken){.type = BIFROST_TOKEN_EOP, .str_range = MakeString("BIFROST_TOKEN_EOP")};
-}
\ No newline at end of file
+}
+
+bfToken bfLexer_nextToken(BifrostLexer* self)
+{
+  bfToken token = bfLexer_scanToken(self);
+
+  if (self->stream && (token.type == BIFROST_TOKEN_IDENTIFIER || token.type == BIFROST_TOKEN_CONST_STR))
+  {
+    token.str_range = bfLexer_intern(self, token.str_range);
+  }
+
+  return token;
+}
+
+void bfLexer_dtor(BifrostLexer* self)
+{
+  BifrostLexerStream* const stream = self->stream;
+
+  if (stream)
+  {
+    bfGC_AllocMemory(self->vm, stream->window, stream->window_capacity, 0u);
+    bfVMArena_dtor(&stream->strings);
+    bfGC_AllocMemory(self->vm, stream, sizeof(BifrostLexerStream), 0u);
+    self->stream = NULL;
+  }
+}
+
+#undef BF_LEXER_STREAM_LOOK_AHEAD
+#undef BF_LEXER_STREAM_CHUNK_SIZE
+#undef BF_LEXER_STREAM_NUM_BUCKETS
\ No newline at end of file
@@ -13,7 +13,18 @@
 /******************************************************************************/
 #include "bifrost_vm_obj.h"
 
-#include "bifrost_vm_gc.h"  // Allocation Functions
+#include "bifrost_vm_arena.h"    // BifrostVMArena
+#include "bifrost_vm_bytecode.h" // BifrostVMImage
+#include "bifrost_vm_gc.h"       // Allocation Functions
+
+typedef struct BifrostStringHeader
+{
+  size_t capacity;
+  size_t length;
+
+} BifrostStringHeader;
+
+BifrostStringHeader* bfVMString_getHeader(ConstBifrostString self);
 
 inline static void SetupGCObject(BifrostObj* obj, BifrostObjType type, BifrostObj** next)
 {
@@ -40,12 +51,38 @@ inline static BifrostObj* AllocateVMObjectImpl(struct BifrostVM* self, size_t si
 #define AllocateVMObjectEx(T, vm, type, extra_size) (T*)AllocateVMObjectImpl(vm, sizeof(T) + extra_size, type)
 #define AllocateVMObject(T, vm, type)               AllocateVMObjectEx(T, vm, type, 0)
 
-BifrostObjModule* bfObj_NewModule(struct BifrostVM* self, string_range name)
+/*
+  NOTE(SR):
+    Anything an object owns is allocated before the object itself, any of
+    those allocations can collect garbage and the new object is not rooted yet.
+*/
+
+#define BIFROST_VM_MODULE_MIN_INDEX_SIZE 16u
+
+static uint32_t* bfObjModule__newIndex(struct BifrostVM* self, size_t num_buckets)
 {
-  BifrostObjModule* module = AllocateVMObject(BifrostObjModule, self, BIFROST_VM_OBJ_MODULE);
+  uint32_t* index = bfVMArray_new(self, uint32_t, num_buckets);
+
+  bfVMArray_resize(self, &index, num_buckets);
+  LibC_memset(index, 0x0, sizeof(uint32_t) * num_buckets);
 
-  module->name      = bfVMString_newLen(self, name.str_bgn, name.str_len);
-  module->variables = bfVMArray_newA(self, module->variables, 32);
+  return index;
+}
+
+BifrostObjModule* bfObj_NewModule(struct BifrostVM* self, string_range name)
+{
+  const BifrostString         module_name    = bfVMString_newLen(self, name.str_bgn, name.str_len);
+  BifrostVMSymbol* const      variables      = bfVMArray_new(self, BifrostVMSymbol, 8);
+  uint32_t* const             variable_index = bfObjModule__newIndex(self, BIFROST_VM_MODULE_MIN_INDEX_SIZE);
+  uint32_t* const             const_slots    = bfVMArray_new(self, uint32_t, 4);
+  BifrostVMConstImport* const const_imports  = bfVMArray_new(self, BifrostVMConstImport, 2);
+  BifrostObjModule*           module         = AllocateVMObject(BifrostObjModule, self, BIFROST_VM_OBJ_MODULE);
+
+  module->name           = module_name;
+  module->variables      = variables;
+  module->variable_index = variable_index;
+  module->const_slots    = const_slots;
+  module->const_imports  = const_imports;
   LibC_memset(&module->init_fn, 0x0, sizeof(module->init_fn));
   module->init_fn.module = module;
 
@@ -56,39 +93,97 @@ BifrostObjModule* bfObj_NewModule(struct BifrostVM* self, string_range name)
 
 BifrostObjClass* bfObj_NewClass(struct BifrostVM* self, BifrostObjModule* module, string_range name, BifrostObjClass* base_clz, size_t extra_data)
 {
-  BifrostObjClass* clz = AllocateVMObject(BifrostObjClass, self, BIFROST_VM_OBJ_CLASS);
-
-  clz->name               = bfVMString_newLen(self, name.str_bgn, name.str_len);
-  clz->base_clz           = base_clz;
-  clz->module             = module;
-  clz->symbols            = bfVMArray_newA(self, clz->symbols, 32);
-  clz->field_initializers = bfVMArray_newA(self, clz->field_initializers, 32);
-  clz->extra_data         = extra_data;
-  clz->finalizer          = NULL;
+  const BifrostString    clz_name           = bfVMString_newLen(self, name.str_bgn, name.str_len);
+  BifrostVMSymbol* const symbols            = bfVMArray_new(self, BifrostVMSymbol, 8);
+  BifrostVMSymbol* const field_initializers = bfVMArray_new(self, BifrostVMSymbol, 32);
+  BifrostObjClass*       clz                = AllocateVMObject(BifrostObjClass, self, BIFROST_VM_OBJ_CLASS);
+
+  clz->name                   = clz_name;
+  clz->base_clz               = base_clz;
+  clz->module                 = module;
+  clz->symbols                = symbols;
+  clz->members                = NULL;
+  clz->members_version        = 0u;
+  clz->field_initializers     = field_initializers;
+  clz->field_template         = NULL;
+  clz->field_template_version = 0u;
+  clz->extra_data             = extra_data;
+  clz->finalizer              = NULL;
 
   return clz;
 }
 
-BifrostObjInstance* bfObj_NewInstance(struct BifrostVM* self, BifrostObjClass* clz)
+/*
+  NOTE(SR):
+    Inserting the de-duplicated template in declaration order gives the
+    same map that setting each initializer one by one did, minus the
+    hashing and compares for every field of every new instance.
+*/
+static void bfObjClass__buildFieldTemplate(struct BifrostVM* self, BifrostObjClass* clz, const BifrostHashMapParams* hash_params)
 {
-  BifrostObjInstance* inst = AllocateVMObjectEx(BifrostObjInstance, self, BIFROST_VM_OBJ_INSTANCE, clz->extra_data);
+  const uint32_t          version    = self->class_version;
+  const size_t            num_fields = bfVMArray_size(&clz->field_initializers);
+  BifrostVMFieldTemplate* fields     = bfVMArray_new(self, BifrostVMFieldTemplate, num_fields + 1u);
+
+  for (size_t i = 0; i < num_fields; ++i)
+  {
+    const BifrostVMSymbol* const initializer = clz->field_initializers + i;
+    const size_t                 num_unique  = bfVMArray_size(&fields);
+    size_t                       j           = 0;
+
+    while (j < num_unique && fields[j].name != initializer->name)
+    {
+      ++j;
+    }
+
+    if (j == num_unique)
+    {
+      BifrostVMFieldTemplate* const field = bfVMArray_emplace(self, &fields);
+
+      field->name = initializer->name;
+      field->hash = hash_params->hash(initializer->name);
+    }
+
+    fields[j].value = initializer->value;
+  }
+
+  if (clz->field_template)
+  {
+    bfVMArray_delete(self, &clz->field_template);
+  }
+
+  clz->field_template         = fields;
+  clz->field_template_version = version;
+}
 
+BifrostObjInstance* bfObj_NewInstance(struct BifrostVM* self, BifrostObjClass* clz)
+{
   BifrostHashMapParams hash_params;
   bfHashMapParams_init(&hash_params, self);
   hash_params.value_size = sizeof(BifrostValue);
 
-  bfHashMap_ctor(&inst->fields, &hash_params);
-  inst->clz = clz;
+  if (!clz->field_template || clz->field_template_version != self->class_version)
+  {
+    bfObjClass__buildFieldTemplate(self, clz, &hash_params);
+  }
 
-  const size_t num_fields = bfVMArray_size(&clz->field_initializers);
+  BifrostHashMap fields;
+  bfHashMap_ctor(&fields, &hash_params);
+
+  const size_t num_fields = bfVMArray_size(&clz->field_template);
 
   for (size_t i = 0; i < num_fields; ++i)
   {
-    BifrostVMSymbol* const sym = clz->field_initializers + i;
+    BifrostVMFieldTemplate* const field = clz->field_template + i;
 
-    bfHashMap_set(&inst->fields, sym->name, &sym->value);
+    bfHashMap_insertNew(&fields, field->name, field->hash, &field->value);
   }
 
+  BifrostObjInstance* inst = AllocateVMObjectEx(BifrostObjInstance, self, BIFROST_VM_OBJ_INSTANCE, clz->extra_data);
+
+  inst->fields = fields;
+  inst->clz    = clz;
+
   return inst;
 }
 
@@ -96,7 +191,19 @@ BifrostObjFn* bfObj_NewFunction(struct BifrostVM* self, BifrostObjModule* module
 {
   BifrostObjFn* fn = AllocateVMObject(BifrostObjFn, self, BIFROST_VM_OBJ_FUNCTION);
 
-  fn->module = module;
+  fn->module           = module;
+  fn->name             = NULL;
+  fn->instructions     = NULL;
+  fn->constants        = NULL;
+  fn->num_instructions = 0u;
+  fn->num_constants    = 0u;
+  fn->line_table       = NULL;
+  fn->line_table_size  = 0u;
+  fn->lazy_source      = NULL;
+  fn->image            = NULL;
+  fn->image_fn         = NULL;
+  fn->image_objects    = NULL;
+  fn->ctor_sites       = NULL;
 
   /* NOTE(SR): 'fn' Will be filled out later by a Function Builder. */
 
@@ -118,15 +225,27 @@ BifrostObjNativeFn* bfObj_NewNativeFn(struct BifrostVM* self, bfNativeFnT fn_ptr
 
 BifrostObjStr* bfObj_NewString(struct BifrostVM* self, string_range value)
 {
-  BifrostObjStr* obj = AllocateVMObject(BifrostObjStr, self, BIFROST_VM_OBJ_STRING);
+  const BifrostString str_value = bfVMString_newLen(self, value.str_bgn, value.str_len);
+  BifrostObjStr*      obj       = AllocateVMObject(BifrostObjStr, self, BIFROST_VM_OBJ_STRING);
 
-  obj->value = bfVMString_newLen(self, value.str_bgn, value.str_len);
+  obj->value = str_value;
   bfVMString_unescape(obj->value);
   obj->hash = bfVMString_hashN(obj->value, bfVMString_length(obj->value));
 
   return obj;
 }
 
+BifrostObjStr* bfObj_NewStringVerbatim(struct BifrostVM* self, string_range value)
+{
+  const BifrostString str_value = bfVMString_newLen(self, value.str_bgn, value.str_len);
+  BifrostObjStr*      obj       = AllocateVMObject(BifrostObjStr, self, BIFROST_VM_OBJ_STRING);
+
+  obj->value = str_value;
+  obj->hash  = bfVMString_hashN(obj->value, bfVMString_length(obj->value));
+
+  return obj;
+}
+
 BifrostObjReference* bfObj_NewReference(struct BifrostVM* self, size_t extra_data_size)
 {
   BifrostObjReference* obj = AllocateVMObjectEx(BifrostObjReference, self, BIFROST_VM_OBJ_REFERENCE, extra_data_size);
@@ -199,6 +318,9 @@ void bfObj_Destruct(struct BifrostVM* self, BifrostObj* obj)
       BifrostObjModule* const module = (BifrostObjModule*)obj;
       bfVMString_delete(self, module->name);
       bfVMArray_delete(self, &module->variables);
+      bfVMArray_delete(self, &module->variable_index);
+      bfVMArray_delete(self, &module->const_slots);
+      bfVMArray_delete(self, &module->const_imports);
       if (module->init_fn.name)
       {
         bfObj_Destruct(self, &module->init_fn.super);
@@ -211,7 +333,18 @@ void bfObj_Destruct(struct BifrostVM* self, BifrostObj* obj)
 
       bfVMString_delete(self, clz->name);
       bfVMArray_delete(self, &clz->symbols);
+      if (clz->members)
+      {
+        bfVMArray_delete(self, &clz->members);
+      }
       bfVMArray_delete(self, &clz->field_initializers);
+      if (clz->field_template)
+      {
+        bfVMArray_delete(self, &clz->field_template);
+      }
+
+      /* NOTE(SR): Caches hold classes weakly, the address may be reused by a new class. */
+      ++self->class_version;
       break;
     }
     case BIFROST_VM_OBJ_INSTANCE:
@@ -225,10 +358,26 @@ void bfObj_Destruct(struct BifrostVM* self, BifrostObj* obj)
     {
       BifrostObjFn* const fn = (BifrostObjFn*)obj;
 
-      bfVMString_delete(self, fn->name);
-      bfVMArray_delete(self, &fn->constants);
-      bfVMArray_delete(self, &fn->instructions);
-      bfVMArray_delete(self, &fn->code_to_line);
+      if (fn->ctor_sites)
+      {
+        bfVMArray_delete(self, &fn->ctor_sites);
+      }
+
+      /* NOTE(SR): Only a compiled function's name lives in its code block. */
+      if (fn->image)
+      {
+        bfVMString_delete(self, fn->name);
+        bfVMArray_delete(self, &fn->image_objects);
+        bfBytecode_releaseImage(self, fn->image);
+      }
+      else if (fn->lazy_source)
+      {
+        bfVMString_delete(self, fn->name);
+      }
+      else
+      {
+        bfObjFn_freeCode(self, fn);
+      }
       break;
     }
     case BIFROST_VM_OBJ_NATIVE_FN:
@@ -271,6 +420,502 @@ bool bfObj_IsFunction(const BifrostObj* obj)
   return obj->type == BIFROST_VM_OBJ_FUNCTION || obj->type == BIFROST_VM_OBJ_NATIVE_FN;
 }
 
+size_t bfObjFn_numInstructions(const BifrostObjFn* fn)
+{
+  return fn->num_instructions;
+}
+
+size_t bfObjFn_numConstants(const BifrostObjFn* fn)
+{
+  return fn->num_constants;
+}
+
+int bfObjFn_lineOf(const BifrostObjFn* fn, const bfInstruction* ip)
+{
+  return bfVMLineTable_lineOf(fn->line_table, fn->line_table_size, ip - fn->instructions);
+}
+
+/*
+  NOTE(SR):
+    A compiled function's code is one allocation with the data a call touches first:
+      [instructions | constants | line table | BifrostStringHeader | name]
+*/
+typedef struct bfObjFnCodeLayout
+{
+  size_t constants;
+  size_t line_table;
+  size_t name;
+  size_t size;
+
+} bfObjFnCodeLayout;
+
+static size_t bfObjFn__alignUp(size_t offset, size_t alignment)
+{
+  return (offset + alignment - 1u) & ~(alignment - 1u);
+}
+
+static bfObjFnCodeLayout bfObjFn__codeLayout(size_t num_instructions, size_t num_constants, size_t line_table_size, size_t name_len)
+{
+  bfObjFnCodeLayout layout;
+
+  layout.constants  = bfObjFn__alignUp(sizeof(bfInstruction) * num_instructions, sizeof(BifrostValue));
+  layout.line_table = layout.constants + sizeof(BifrostValue) * num_constants;
+  layout.name       = bfObjFn__alignUp(layout.line_table + line_table_size, sizeof(size_t)) + sizeof(BifrostStringHeader);
+  layout.size       = layout.name + name_len + 1u;
+
+  return layout;
+}
+
+void bfObjFn_allocCode(struct BifrostVM* self, BifrostObjFn* fn, size_t num_instructions, size_t num_constants, size_t line_table_size, const char* name, size_t name_len)
+{
+  const bfObjFnCodeLayout layout = bfObjFn__codeLayout(num_instructions, num_constants, line_table_size, name_len);
+
+  self->gc_is_running = true;
+  uint8_t* const code = bfGC_AllocMemory(self, NULL, 0u, layout.size);
+  self->gc_is_running = false;
+
+  LibC_assert(code, "bfObjFn_allocCode:: The function's code could not be allocated");
+
+  BifrostStringHeader* const name_header = (BifrostStringHeader*)(code + layout.name) - 1;
+
+  name_header->capacity = name_len + 1u;
+  name_header->length   = name_len;
+
+  fn->instructions     = (bfInstruction*)code;
+  fn->constants        = (BifrostValue*)(code + layout.constants);
+  fn->num_instructions = (uint32_t)num_instructions;
+  fn->num_constants    = (uint32_t)num_constants;
+  fn->line_table       = line_table_size ? code + layout.line_table : NULL;
+  fn->line_table_size  = (uint32_t)line_table_size;
+  fn->name             = (BifrostString)(code + layout.name);
+
+  if (name_len)
+  {
+    LibC_memcpy(fn->name, name, name_len);
+  }
+
+  fn->name[name_len] = '\0';
+}
+
+void bfObjFn_freeCode(struct BifrostVM* self, BifrostObjFn* fn)
+{
+  if (!fn->instructions)
+  {
+    return;
+  }
+
+  const bfObjFnCodeLayout layout = bfObjFn__codeLayout(fn->num_instructions, fn->num_constants, fn->line_table_size, bfVMString_length(fn->name));
+
+  self->gc_is_running = true;
+  bfGC_AllocMemory(self, fn->instructions, layout.size, 0u);
+  self->gc_is_running = false;
+
+  fn->instructions = NULL;
+  fn->constants    = NULL;
+  fn->line_table   = NULL;
+  fn->name         = NULL;
+}
+
+void bfObjFn_initCtorSite(BifrostVMCtorSite* site, uint32_t symbol)
+{
+  site->symbol  = symbol;
+  site->version = 0u;
+  site->clz     = NULL;
+  site->owner   = NULL;
+  site->slot    = 0u;
+}
+
+/*
+  NOTE(SR):
+    Leaves [BifrostObjModule::init_fn] as it was before the module was
+    compiled, nested functions and classes are separate objects that stay
+    alive through the module's variables.
+*/
+void bfObjModule_releaseInitFn(struct BifrostVM* self, BifrostObjModule* module)
+{
+  BifrostObjFn* const init_fn = &module->init_fn;
+
+  if (init_fn->name)
+  {
+    bfObj_Destruct(self, &init_fn->super);
+
+    LibC_memset(init_fn, 0x0, sizeof(*init_fn));
+    init_fn->module = module;
+    SetupGCObject(&init_fn->super, BIFROST_VM_OBJ_FUNCTION, NULL);
+  }
+}
+
+/*
+  NOTE(SR):
+    Names are interned in [BifrostVM::symbols] so the index hashes and
+    compares the string pointers, the table is kept at most half full.
+*/
+static size_t bfObjModule__bucket(ConstBifrostString symbol, size_t mask)
+{
+  return (size_t)(((uintptr_t)symbol >> 3u) * 2654435761u) & mask;
+}
+
+size_t bfObjModule_findSlot(const BifrostObjModule* module, ConstBifrostString symbol)
+{
+  const uint32_t* const index = module->variable_index;
+  const size_t          mask  = bfVMArray_size(&index) - 1u;
+  size_t                i     = bfObjModule__bucket(symbol, mask);
+
+  while (index[i])
+  {
+    const size_t slot = index[i] - 1u;
+
+    if (module->variables[slot].name == symbol)
+    {
+      return slot;
+    }
+
+    i = (i + 1u) & mask;
+  }
+
+  return BIFROST_ARRAY_INVALID_INDEX;
+}
+
+void bfObjModule_rebuildIndex(struct BifrostVM* self, BifrostObjModule* module)
+{
+  const size_t num_variables = bfVMArray_size(&module->variables);
+  size_t       num_buckets   = BIFROST_VM_MODULE_MIN_INDEX_SIZE;
+
+  while (num_buckets < num_variables * 2u)
+  {
+    num_buckets *= 2u;
+  }
+
+  uint32_t* const index = bfObjModule__newIndex(self, num_buckets);
+  const size_t    mask  = num_buckets - 1u;
+
+  for (size_t slot = 0; slot < num_variables; ++slot)
+  {
+    size_t i = bfObjModule__bucket(module->variables[slot].name, mask);
+
+    while (index[i])
+    {
+      i = (i + 1u) & mask;
+    }
+
+    index[i] = (uint32_t)slot + 1u;
+  }
+
+  bfVMArray_delete(self, &module->variable_index);
+  module->variable_index = index;
+}
+
+size_t bfObjModule_addSlot(struct BifrostVM* self, BifrostObjModule* module, ConstBifrostString symbol)
+{
+  const size_t existing = bfObjModule_findSlot(module, symbol);
+
+  if (existing != BIFROST_ARRAY_INVALID_INDEX)
+  {
+    return existing;
+  }
+
+  const size_t           slot     = bfVMArray_size(&module->variables);
+  BifrostVMSymbol* const variable = bfVMArray_emplace(self, &module->variables);
+
+  variable->name  = symbol;
+  variable->value = bfVMValue_fromNull();
+
+  if ((slot + 1u) * 2u > bfVMArray_size(&module->variable_index))
+  {
+    bfObjModule_rebuildIndex(self, module);
+  }
+  else
+  {
+    const uint32_t* const index = module->variable_index;
+    const size_t          mask  = bfVMArray_size(&index) - 1u;
+    size_t                i     = bfObjModule__bucket(symbol, mask);
+
+    while (index[i])
+    {
+      i = (i + 1u) & mask;
+    }
+
+    module->variable_index[i] = (uint32_t)slot + 1u;
+  }
+
+  return slot;
+}
+
+/* NOTE(SR): A module has a handful of constants at most, a linear scan beats hashing them. */
+bool bfObjModule_isConst(const BifrostObjModule* module, size_t slot)
+{
+  const size_t num_consts = bfVMArray_size(&module->const_slots);
+
+  for (size_t i = 0; i < num_consts; ++i)
+  {
+    if (module->const_slots[i] == slot)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void bfObjModule_markConst(struct BifrostVM* self, BifrostObjModule* module, size_t slot)
+{
+  if (!bfObjModule_isConst(module, slot))
+  {
+    const uint32_t const_slot = (uint32_t)slot;
+
+    bfVMArray_push(self, &module->const_slots, &const_slot);
+  }
+}
+
+/* 64bit FNV-1a of the name and value of every constant, an importer that inlined them is stale once this changes. */
+uint64_t bfObjModule_constHash(const BifrostObjModule* module)
+{
+  const size_t num_consts = bfVMArray_size(&module->const_slots);
+  uint64_t     hash       = 0xCBF29CE484222325ull;
+
+  for (size_t i = 0; i < num_consts; ++i)
+  {
+    const BifrostVMSymbol* const variable  = module->variables + module->const_slots[i];
+    const BifrostValue           value     = variable->value;
+    const char*                  bytes     = variable->name;
+    size_t                       num_bytes = bfVMString_length(variable->name) + 1u;
+
+    for (size_t j = 0; j < num_bytes; ++j)
+    {
+      hash = (hash ^ (uint8_t)bytes[j]) * 0x100000001B3ull;
+    }
+
+    /* NOTE(SR): A string constant is a new object in every compile, only its contents matter. */
+    if (bfVMValue_isPointer(value) && (BIFROST_AS_OBJ(value)->type & BifrostVMObjType_mask) == BIFROST_VM_OBJ_STRING)
+    {
+      const BifrostObjStr* const str = (const BifrostObjStr*)BIFROST_AS_OBJ(value);
+
+      bytes     = str->value;
+      num_bytes = bfVMString_length(str->value);
+    }
+    else
+    {
+      bytes     = (const char*)&value;
+      num_bytes = sizeof(value);
+    }
+
+    for (size_t j = 0; j < num_bytes; ++j)
+    {
+      hash = (hash ^ (uint8_t)bytes[j]) * 0x100000001B3ull;
+    }
+  }
+
+  return hash;
+}
+
+void bfObjModule_addConstImport(struct BifrostVM* self, BifrostObjModule* module, uint32_t module_symbol, uint64_t const_hash)
+{
+  const size_t num_imports = bfVMArray_size(&module->const_imports);
+
+  for (size_t i = 0; i < num_imports; ++i)
+  {
+    if (module->const_imports[i].module_symbol == module_symbol)
+    {
+      module->const_imports[i].const_hash = const_hash;
+      return;
+    }
+  }
+
+  const BifrostVMConstImport const_import = {.module_symbol = module_symbol, .const_hash = const_hash};
+
+  bfVMArray_push(self, &module->const_imports, &const_import);
+}
+
+static bool bfObjClass__hasMembers(const struct BifrostVM* self, const BifrostObjClass* clz)
+{
+  return clz->members && clz->members_version == self->class_version;
+}
+
+static const BifrostVMClassMember* bfObjClass__lookup(const BifrostVMClassMember* members, ConstBifrostString symbol)
+{
+  const size_t mask = bfVMArray_size(&members) - 1u;
+  size_t       i    = bfObjModule__bucket(symbol, mask);
+
+  while (members[i].owner)
+  {
+    if (members[i].name == symbol)
+    {
+      return members + i;
+    }
+
+    i = (i + 1u) & mask;
+  }
+
+  return NULL;
+}
+
+/*
+  NOTE(SR):
+    Copies down every member of the class and its bases, the nearest
+    declaration wins. The version is read before allocating since a
+    collection may run script code that changes a class, the table is
+    then just rebuilt again on the next lookup.
+*/
+static void bfObjClass__buildMembers(struct BifrostVM* self, BifrostObjClass* clz)
+{
+  const uint32_t version     = self->class_version;
+  size_t         num_members = 0u;
+
+  for (const BifrostObjClass* c = clz; c; c = c->base_clz)
+  {
+    num_members += bfVMArray_size(&c->symbols);
+  }
+
+  size_t num_buckets = 8u;
+
+  while (num_buckets < num_members * 2u)
+  {
+    num_buckets *= 2u;
+  }
+
+  BifrostVMClassMember* members = bfVMArray_new(self, BifrostVMClassMember, num_buckets);
+  const size_t          mask    = num_buckets - 1u;
+
+  bfVMArray_resize(self, &members, num_buckets);
+  LibC_memset(members, 0x0, sizeof(BifrostVMClassMember) * num_buckets);
+
+  for (BifrostObjClass* c = clz; c; c = c->base_clz)
+  {
+    const size_t num_symbols = bfVMArray_size(&c->symbols);
+
+    for (size_t slot = 0; slot < num_symbols; ++slot)
+    {
+      ConstBifrostString const symbol = c->symbols[slot].name;
+      size_t                   i      = bfObjModule__bucket(symbol, mask);
+
+      while (members[i].owner && members[i].name != symbol)
+      {
+        i = (i + 1u) & mask;
+      }
+
+      if (!members[i].owner)
+      {
+        members[i].name  = symbol;
+        members[i].slot  = (uint32_t)slot;
+        members[i].owner = c;
+      }
+    }
+  }
+
+  if (clz->members)
+  {
+    bfVMArray_delete(self, &clz->members);
+  }
+
+  clz->members         = members;
+  clz->members_version = version;
+}
+
+const BifrostVMClassMember* bfObjClass_findMember(struct BifrostVM* self, BifrostObjClass* clz, ConstBifrostString symbol)
+{
+  if (!bfObjClass__hasMembers(self, clz))
+  {
+    bfObjClass__buildMembers(self, clz);
+  }
+
+  return bfObjClass__lookup(clz->members, symbol);
+}
+
+bool bfObjClass_resolveSymbol(struct BifrostVM* self, BifrostObjClass* clz, ConstBifrostString symbol, BifrostVMClassMember* out)
+{
+  while (clz)
+  {
+    const BifrostVMClassMember* const member = bfObjClass_findMember(self, clz, symbol);
+
+    if (!member)
+    {
+      break;
+    }
+
+    if (!bfVMValue_isNull(member->owner->symbols[member->slot].value))
+    {
+      *out = *member;
+      return true;
+    }
+
+    clz = member->owner->base_clz;
+  }
+
+  return false;
+}
+
+bool bfObjClass_loadSymbol(struct BifrostVM* self, BifrostObjClass* clz, ConstBifrostString symbol, BifrostValue* out)
+{
+  BifrostVMClassMember member;
+
+  if (bfObjClass_resolveSymbol(self, clz, symbol, &member))
+  {
+    *out = member.owner->symbols[member.slot].value;
+    return true;
+  }
+
+  return false;
+}
+
+/* Index into [clz->symbols] or 'BIFROST_ARRAY_INVALID_INDEX', the flattened table is only used when it is up to date. */
+static size_t bfObjClass__ownSlot(const struct BifrostVM* self, const BifrostObjClass* clz, ConstBifrostString symbol)
+{
+  if (bfObjClass__hasMembers(self, clz))
+  {
+    const BifrostVMClassMember* const member = bfObjClass__lookup(clz->members, symbol);
+
+    return member && member->owner == clz ? member->slot : BIFROST_ARRAY_INVALID_INDEX;
+  }
+
+  const size_t num_symbols = bfVMArray_size(&clz->symbols);
+
+  for (size_t i = 0; i < num_symbols; ++i)
+  {
+    if (clz->symbols[i].name == symbol)
+    {
+      return i;
+    }
+  }
+
+  return BIFROST_ARRAY_INVALID_INDEX;
+}
+
+BifrostValue bfObjClass_ownSymbol(const struct BifrostVM* self, const BifrostObjClass* clz, ConstBifrostString symbol)
+{
+  const size_t slot = bfObjClass__ownSlot(self, clz, symbol);
+
+  return slot != BIFROST_ARRAY_INVALID_INDEX ? clz->symbols[slot].value : bfVMValue_fromNull();
+}
+
+void bfObjClass_setSymbol(struct BifrostVM* self, BifrostObjClass* clz, ConstBifrostString symbol, BifrostValue value)
+{
+  const size_t slot = bfObjClass__ownSlot(self, clz, symbol);
+
+  if (slot != BIFROST_ARRAY_INVALID_INDEX)
+  {
+    clz->symbols[slot].value = value;
+  }
+  else
+  {
+    BifrostVMSymbol* const member = bfVMArray_emplace(self, &clz->symbols);
+
+    member->name  = symbol;
+    member->value = value;
+
+    ++self->class_version;
+  }
+}
+
+void bfObjClass_addField(struct BifrostVM* self, BifrostObjClass* clz, ConstBifrostString symbol, BifrostValue value)
+{
+  BifrostVMSymbol* const field = bfVMArray_emplace(self, &clz->field_initializers);
+
+  field->name  = symbol;
+  field->value = value;
+
+  ++self->class_version;
+}
+
 void bfObj_Finalize(struct BifrostVM* self, BifrostObj* obj)
 {
   // TODO(SR): Find a way to guarantee instances don't get finalized twice
@@ -295,6 +940,135 @@ void bfObj_Finalize(struct BifrostVM* self, BifrostObj* obj)
   }
 }
 
+/* line table */
+
+static void bfVMLineTable__writeVarint(struct BifrostVM* vm, uint8_t** table, uint32_t value)
+{
+  do
+  {
+    const uint8_t byte = (uint8_t)(value & 0x7Fu);
+
+    value >>= 7u;
+
+    *(uint8_t*)bfVMArray_emplace(vm, table) = value ? (byte | 0x80u) : byte;
+  } while (value);
+}
+
+/* NOTE(SR): NULL when the varint is malformed or runs past [end]. */
+static const uint8_t* bfVMLineTable__readVarint(const uint8_t* cursor, const uint8_t* end, uint32_t* out)
+{
+  uint32_t value = 0u;
+
+  for (uint32_t shift = 0u; shift < 35u; shift += 7u)
+  {
+    if (cursor >= end)
+    {
+      break;
+    }
+
+    const uint8_t byte = *cursor++;
+
+    value |= (uint32_t)(byte & 0x7Fu) << shift;
+
+    if (!(byte & 0x80u))
+    {
+      *out = value;
+      return cursor;
+    }
+  }
+
+  return NULL;
+}
+
+uint8_t* bfVMLineTable_encode(struct BifrostVM* vm, struct BifrostVMArena* arena, const uint32_t* lines, size_t num_lines)
+{
+  uint8_t* table     = bfVMArray_newArena(arena, uint8_t, num_lines / 2u + 2u);
+  uint32_t last_line = 0u;
+  size_t   run_start = 0u;
+
+  while (run_start < num_lines)
+  {
+    const uint32_t line    = lines[run_start];
+    size_t         run_end = run_start + 1u;
+
+    while (run_end < num_lines && lines[run_end] == line)
+    {
+      ++run_end;
+    }
+
+    const int32_t delta = (int32_t)(line - last_line);
+
+    bfVMLineTable__writeVarint(vm, &table, (uint32_t)(run_end - run_start));
+    bfVMLineTable__writeVarint(vm, &table, ((uint32_t)delta << 1u) ^ (uint32_t)(delta >> 31));
+
+    last_line = line;
+    run_start = run_end;
+  }
+
+  return table;
+}
+
+int bfVMLineTable_lineOf(const uint8_t* table, size_t table_size, size_t inst_index)
+{
+  if (!table)
+  {
+    return -1;
+  }
+
+  const uint8_t* const end       = table + table_size;
+  uint32_t             line      = 0u;
+  size_t               run_start = 0u;
+
+  while (table && table < end)
+  {
+    uint32_t run_length = 0u;
+    uint32_t zig_zag    = 0u;
+
+    table = bfVMLineTable__readVarint(table, end, &run_length);
+    table = table ? bfVMLineTable__readVarint(table, end, &zig_zag) : NULL;
+    line += (zig_zag >> 1u) ^ (0u - (zig_zag & 1u));
+
+    run_start += run_length;
+
+    if (table && inst_index < run_start)
+    {
+      return (int)line;
+    }
+  }
+
+  return -1;
+}
+
+bool bfVMLineTable_isValid(const uint8_t* table, size_t table_size, size_t num_instructions)
+{
+  const uint8_t* const end       = table + table_size;
+  size_t               num_insts = 0u;
+
+  while (table < end && num_insts < num_instructions)
+  {
+    uint32_t run_length = 0u;
+    uint32_t zig_zag    = 0u;
+
+    table = bfVMLineTable__readVarint(table, end, &run_length);
+
+    if (!table || run_length == 0u)
+    {
+      return false;
+    }
+
+    table = bfVMLineTable__readVarint(table, end, &zig_zag);
+
+    if (!table)
+    {
+      return false;
+    }
+
+    num_insts += run_length;
+  }
+
+  return table == end && num_insts == num_instructions;
+}
+
 /* array */
 
 typedef struct
@@ -308,9 +1082,10 @@ typedef struct
 
 typedef struct
 {
-  size_t capacity;
-  size_t size;
-  size_t stride;
+  size_t          capacity;
+  size_t          size;
+  size_t          stride;
+  BifrostVMArena* arena; /*!< NULL when allocated from the vm. */
 
 } BifrostArrayHeader;
 
@@ -327,7 +1102,7 @@ static size_t ArrayAllocationSize(size_t capacity, size_t stride)
 void* _bfVMArrayT_new(struct BifrostVM* vm, const size_t stride, const size_t initial_capacity)
 {
   LibC_assert(stride, "_ArrayT_new:: The struct must be greater than 0.");
-  LibC_assert(initial_capacity * stride, "_ArrayT_new:: Please initialize the Array with a size greater than 0");
+  LibC_assert(initial_capacity != 0 && stride != 0, "_ArrayT_new:: Please initialize the Array with a size greater than 0");
 
   vm->gc_is_running              = true;
   BifrostArrayHeader* const self = (BifrostArrayHeader*)bfGC_AllocMemory(vm, NULL, 0u, ArrayAllocationSize(initial_capacity, stride));
@@ -343,10 +1118,47 @@ void* _bfVMArrayT_new(struct BifrostVM* vm, const size_t stride, const size_t in
   self->capacity = initial_capacity;
   self->size     = 0;
   self->stride   = stride;
+  self->arena    = NULL;
 
   return (uint8_t*)self + sizeof(BifrostArrayHeader);
 }
 
+void* _bfVMArrayT_newArena(struct BifrostVMArena* arena, const size_t stride, const size_t initial_capacity)
+{
+  LibC_assert(stride, "_ArrayT_new:: The struct must be greater than 0.");
+  LibC_assert(initial_capacity != 0 && stride != 0, "_ArrayT_new:: Please initialize the Array with a size greater than 0");
+
+  BifrostArrayHeader* const self = (BifrostArrayHeader*)bfVMArena_alloc(arena, ArrayAllocationSize(initial_capacity, stride));
+
+  LibC_assert(self, "Array_new:: The Dynamic Array could not be allocated");
+
+  if (!self)
+  {
+    return NULL;
+  }
+
+  self->capacity = initial_capacity;
+  self->size     = 0;
+  self->stride   = stride;
+  self->arena    = arena;
+
+  return (uint8_t*)self + sizeof(BifrostArrayHeader);
+}
+
+void* bfVMArray_clone(struct BifrostVM* vm, const void* const self)
+{
+  const BifrostArrayHeader* const header = Array_getHeader(*SELF_CAST(self));
+  void*                           clone  = _bfVMArrayT_new(vm, header->stride, header->size ? header->size : 1);
+
+  if (clone)
+  {
+    LibC_memcpy(clone, *SELF_CAST(self), header->size * header->stride);
+    Array_getHeader(clone)->size = header->size;
+  }
+
+  return clone;
+}
+
 // bfVMArray_push
 static void* Array_end(const void* const self)
 {
@@ -372,17 +1184,24 @@ static void Array_reserve(struct BifrostVM* vm, void* const self, const size_t n
   {
     size_t new_capacity = (header->capacity >> 3) + (header->capacity < 9 ? 3 : 6) + header->capacity;
 
+    /* NOTE(SR): Outgrown arena blocks are not reused so grow faster to waste less. */
+    if (header->arena && new_capacity < header->capacity * 2)
+    {
+      new_capacity = header->capacity * 2;
+    }
+
     if (new_capacity < num_elements)
     {
       new_capacity = num_elements;
     }
 
+    const size_t old_alloc_size = ArrayAllocationSize(header->capacity, header->stride);
+    const size_t new_alloc_size = ArrayAllocationSize(new_capacity, header->stride);
+
     vm->gc_is_running              = true;
-    BifrostArrayHeader* new_header = (BifrostArrayHeader*)bfGC_AllocMemory(
-     vm,
-     header,
-     ArrayAllocationSize(header->capacity, header->stride),
-     ArrayAllocationSize(new_capacity, header->stride));
+    BifrostArrayHeader* new_header = (BifrostArrayHeader*)(header->arena ?
+                                                             bfVMArena_realloc(header->arena, header, old_alloc_size, new_alloc_size) :
+                                                             bfGC_AllocMemory(vm, header, old_alloc_size, new_alloc_size));
 
     if (new_header)
     {
@@ -456,10 +1275,16 @@ void* bfVMArray_back(const void* const self)
 
 void bfVMArray_delete(struct BifrostVM* vm, void* const self)
 {
-  vm->gc_is_running = true;
-
   BifrostArrayHeader* const header = Array_getHeader(*SELF_CAST(self));
 
+  /* NOTE(SR): Arena memory is all released together by 'bfVMArena_dtor'. */
+  if (header->arena)
+  {
+    return;
+  }
+
+  vm->gc_is_running = true;
+
   bfGC_AllocMemory(vm, header, ArrayAllocationSize(header->capacity, header->stride), 0u);
 
   vm->gc_is_running = false;
@@ -467,15 +1292,6 @@ void bfVMArray_delete(struct BifrostVM* vm, void* const self)
 
 /* string */
 
-typedef struct BifrostStringHeader
-{
-  size_t capacity;
-  size_t length;
-
-} BifrostStringHeader;
-
-BifrostStringHeader* bfVMString_getHeader(ConstBifrostString self);
-
 static size_t StringAllocationSize(size_t capacity)
 {
   return sizeof(BifrostStringHeader) + capacity;
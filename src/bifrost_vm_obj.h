@@ -55,36 +55,95 @@ typedef struct BifrostObj
 
 } BifrostObj;
 
+/*!
+ * @brief
+ *   Per site cache of a 'NEW_CONSTRUCT', the constructor is remembered as
+ *   the slot that declares it so a reassigned constructor is still seen.
+ */
+typedef struct BifrostVMCtorSite
+{
+  uint32_t                symbol;  /*!< vm symbol of the constructor's name.                                     */
+  uint32_t                version; /*!< The [BifrostVM::class_version] the entry was resolved at.                */
+  struct BifrostObjClass* clz;     /*!< The class last constructed at this site, NULL before the first one.      */
+  struct BifrostObjClass* owner;   /*!< The class in [clz]'s hierarchy that declares the constructor.            */
+  uint32_t                slot;    /*!< Index into [owner]'s symbols.                                            */
+
+} BifrostVMCtorSite;
+
 typedef struct BifrostObjFn
 {
-  BifrostObj               super;
-  BifrostString            name;
-  int32_t                  arity;  //!< An arity of -1 indicates variadic args [0, 512).
-  uint16_t*                code_to_line;
-  BifrostValue*            constants;
-  bfInstruction*           instructions;
-  size_t                   needed_stack_space; /* params + locals + temps */
-  struct BifrostObjModule* module;
+  BifrostObj                     super;
+  bfInstruction*                 instructions;       /*!< The start of the function's code block, see 'bfObjFn_allocCode'.                                 */
+  BifrostValue*                  constants;          /*!< Follows [BifrostObjFn::instructions] in the code block.                                          */
+  uint32_t                       num_instructions;
+  uint32_t                       num_constants;
+  int32_t                        arity;              //!< An arity of -1 indicates variadic args [0, 512).
+  uint32_t                       line_table_size;    /*!< In bytes.                                                                                        */
+  size_t                         needed_stack_space; /* params + locals + temps */
+  struct BifrostObjModule*       module;
+  BifrostString                  name;               /*!< Stored at the end of the code block once compiled, separately allocated otherwise.             */
+  uint8_t*                       line_table;         /*!< Line numbers in the 'bfVMLineTable' encoding, NULL when debug info is stripped.                  */
+  struct BifrostObjStr*          lazy_source;        /*!< Non NULL until the body is compiled on the first call, the source of the module it was declared in. */
+  uint32_t                       lazy_offset;        /*!< Offset into [BifrostObjFn::lazy_source] of the parameter list.                                     */
+  uint32_t                       lazy_line_no;       /*!< The line the parameter list starts on.                                                              */
+  struct BifrostVMImage*         image;              /*!< Non NULL when the code, constant and line arrays are borrowed from a mapped bytecode image.       */
+  const struct BifrostVMImageFn* image_fn;           /*!< This function's record in [BifrostObjFn::image].                                                 */
+  BifrostValue*                  image_objects;      /*!< Object constants of an image function, strings are materialized on first use.                    */
+  BifrostVMCtorSite*             ctor_sites;         /*!< Indexed by the rC of 'NEW_CONSTRUCT', NULL when the function constructs nothing.                */
 
 } BifrostObjFn;
 
+/*!
+ * @brief
+ *   Another module whose constants were inlined into a module's code.
+ */
+typedef struct BifrostVMConstImport
+{
+  uint32_t module_symbol; /*!< vm symbol of the imported module's name.                              */
+  uint64_t const_hash;    /*!< 'bfObjModule_constHash' of the imported module when it was inlined. */
+
+} BifrostVMConstImport;
+
 typedef struct BifrostObjModule
 {
-  BifrostObj       super;
-  BifrostString    name;
-  BifrostVMSymbol* variables;
-  BifrostObjFn     init_fn;
+  BifrostObj            super;
+  BifrostString         name;
+  BifrostVMSymbol*      variables;      /*!< Dense, a variable gets its slot the first time it is declared or referenced by compiled code. */
+  uint32_t*             variable_index; /*!< Open addressed 'slot + 1' (0 is empty) keyed by the interned name, see 'bfObjModule_findSlot'. */
+  uint32_t*             const_slots;    /*!< Slots declared 'const', their value is substituted into code as it is compiled.            */
+  BifrostVMConstImport* const_imports;  /*!< Modules whose constants this module's code depends on, a saved image is stale once they change. */
+  BifrostObjFn          init_fn;
 
 } BifrostObjModule;
 
+typedef struct BifrostVMClassMember
+{
+  ConstBifrostString      name;  /*!< Interned in [BifrostVM::symbols].                            */
+  uint32_t                slot;  /*!< Index into [BifrostObjClass::symbols] of [owner].            */
+  struct BifrostObjClass* owner; /*!< The nearest class declaring the member, NULL for an empty bucket. */
+
+} BifrostVMClassMember;
+
+typedef struct BifrostVMFieldTemplate
+{
+  ConstBifrostString name;  /*!< Interned in [BifrostVM::symbols].        */
+  unsigned           hash;  /*!< The instance field map's hash of [name]. */
+  BifrostValue       value;
+
+} BifrostVMFieldTemplate;
+
 typedef struct BifrostObjClass
 {
   BifrostObj              super;
   BifrostString           name;
   struct BifrostObjClass* base_clz;
   BifrostObjModule*       module;
-  BifrostVMSymbol*        symbols;
+  BifrostVMSymbol*        symbols;                /*!< Dense, the members declared by this class itself.                                                */
+  BifrostVMClassMember*   members;                /*!< Own and inherited members flattened, open addressed by name, see 'bfObjClass_findMember'.        */
+  uint32_t                members_version;        /*!< The [BifrostVM::class_version] [members] was built at, a stale table is rebuilt on the next use. */
   BifrostVMSymbol*        field_initializers;
+  BifrostVMFieldTemplate* field_template;         /*!< [field_initializers] without duplicates and hashed, copied into every new instance.              */
+  uint32_t                field_template_version; /*!< Like [members_version] but for [field_template].                                                 */
   size_t                  extra_data;
   bfClassFinalizer        finalizer;
 
@@ -156,23 +215,70 @@ BifrostObjInstance*  bfObj_NewInstance(struct BifrostVM* self, BifrostObjClass*
 BifrostObjFn*        bfObj_NewFunction(struct BifrostVM* self, BifrostObjModule* module);
 BifrostObjNativeFn*  bfObj_NewNativeFn(struct BifrostVM* self, bfNativeFnT fn_ptr, int32_t arity, uint32_t num_statics, uint16_t extra_data);
 BifrostObjStr*       bfObj_NewString(struct BifrostVM* self, string_range value);
+BifrostObjStr*       bfObj_NewStringVerbatim(struct BifrostVM* self, string_range value);
 BifrostObjReference* bfObj_NewReference(struct BifrostVM* self, size_t extra_data_size);
 BifrostObjWeakRef*   bfObj_NewWeaKRef(struct BifrostVM* self, void* data);
 size_t               bfObj_AllocationSize(const BifrostObj* obj);
 void                 bfObj_Destruct(struct BifrostVM* self, BifrostObj* obj);
 size_t               bfObj_Delete(struct BifrostVM* self, BifrostObj* obj);
 bool                 bfObj_IsFunction(const BifrostObj* obj);
+size_t               bfObjFn_numInstructions(const BifrostObjFn* fn);
+size_t               bfObjFn_numConstants(const BifrostObjFn* fn);
+int                  bfObjFn_lineOf(const BifrostObjFn* fn, const bfInstruction* ip);
+void                 bfObjFn_allocCode(struct BifrostVM* self, BifrostObjFn* fn, size_t num_instructions, size_t num_constants, size_t line_table_size, const char* name, size_t name_len);
+void                 bfObjFn_freeCode(struct BifrostVM* self, BifrostObjFn* fn);
+void                 bfObjFn_initCtorSite(BifrostVMCtorSite* site, uint32_t symbol);
+void                 bfObjModule_releaseInitFn(struct BifrostVM* self, BifrostObjModule* module);
+size_t               bfObjModule_findSlot(const BifrostObjModule* module, ConstBifrostString symbol);                  /* [symbol] is from [BifrostVM::symbols], 'BIFROST_ARRAY_INVALID_INDEX' if not found. */
+size_t               bfObjModule_addSlot(struct BifrostVM* self, BifrostObjModule* module, ConstBifrostString symbol); /* The existing slot or a new one holding null.                                           */
+void                 bfObjModule_rebuildIndex(struct BifrostVM* self, BifrostObjModule* module);
+bool                 bfObjModule_isConst(const BifrostObjModule* module, size_t slot);
+void                 bfObjModule_markConst(struct BifrostVM* self, BifrostObjModule* module, size_t slot);
+uint64_t             bfObjModule_constHash(const BifrostObjModule* module);
+void                 bfObjModule_addConstImport(struct BifrostVM* self, BifrostObjModule* module, uint32_t module_symbol, uint64_t const_hash);
 void                 bfObj_Finalize(struct BifrostVM* self, BifrostObj* obj);
 
+/* class members */
+
+/*
+  NOTE(SR):
+    Member names are interned in [BifrostVM::symbols] so they are compared by
+    pointer. The flattened table is rebuilt on the next lookup once any class
+    gained a member or a new base, only 'bfObjClass_ownSymbol' never allocates.
+*/
+const BifrostVMClassMember* bfObjClass_findMember(struct BifrostVM* self, BifrostObjClass* clz, ConstBifrostString symbol);
+bool                        bfObjClass_loadSymbol(struct BifrostVM* self, BifrostObjClass* clz, ConstBifrostString symbol, BifrostValue* out); /* A null member falls through to the base classes like a missing one. */
+BifrostValue                bfObjClass_ownSymbol(const struct BifrostVM* self, const BifrostObjClass* clz, ConstBifrostString symbol);       /* Only members declared by [clz] itself, null if missing.            */
+void                        bfObjClass_setSymbol(struct BifrostVM* self, BifrostObjClass* clz, ConstBifrostString symbol, BifrostValue value);  /* Declares the member on [clz] itself if it is not already.          */
+bool                        bfObjClass_resolveSymbol(struct BifrostVM* self, BifrostObjClass* clz, ConstBifrostString symbol, BifrostVMClassMember* out); /* Like 'bfObjClass_loadSymbol' but where the value is stored. */
+void                        bfObjClass_addField(struct BifrostVM* self, BifrostObjClass* clz, ConstBifrostString symbol, BifrostValue value);
+
+/* line table */
+
+struct BifrostVMArena;
+
+/*
+  NOTE(SR):
+    A line table is a list of runs, each run is the number of consecutive
+    instructions on the same line followed by that line's difference from the
+    previous run's line (zig-zag), both as LEB128 varints.
+*/
+uint8_t* bfVMLineTable_encode(struct BifrostVM* vm, struct BifrostVMArena* arena, const uint32_t* lines, size_t num_lines); /* An arena 'bfVMArray'. */
+int      bfVMLineTable_lineOf(const uint8_t* table, size_t table_size, size_t inst_index); /* -1 when [inst_index] is past the end. */
+bool     bfVMLineTable_isValid(const uint8_t* table, size_t table_size, size_t num_instructions);
+
 /* array */
 
 #define BIFROST_ARRAY_INVALID_INDEX           ((size_t)(-1))
 #define bfVMArray_new(vm, T, initial_size)    (T*)_bfVMArrayT_new((vm), sizeof(T), (initial_size))
 #define bfVMArray_newA(vm, arr, initial_size) _bfVMArrayT_new((vm), sizeof((arr)[0]), (initial_size))
+#define bfVMArray_newArena(arena, T, initial_size) (T*)_bfVMArrayT_newArena((arena), sizeof(T), (initial_size))
 
 typedef int (*bfVMArrayFindCompare)(const void*, const void*);
 
 void*  _bfVMArrayT_new(struct BifrostVM* vm, const size_t stride, const size_t initial_size);
+void*  _bfVMArrayT_newArena(struct BifrostVMArena* arena, const size_t stride, const size_t initial_size); /* Growing / deleting never goes through the vm. */
+void*  bfVMArray_clone(struct BifrostVM* vm, const void* const self);                                       /* A right sized, vm owned copy. */
 size_t bfVMArray_size(const void* const self);
 void*  bfVMArray_at(const void* const self, const size_t index);
 void   bfVMArray_resize(struct BifrostVM* vm, void* const self, const size_t size);
@@ -225,6 +331,7 @@ void bfHashMapParams_init(BifrostHashMapParams* self, struct BifrostVM* vm);
 
 void          bfHashMap_ctor(BifrostHashMap* self, const BifrostHashMapParams* params);
 void          bfHashMap_set(BifrostHashMap* self, const void* key, void* value);
+void          bfHashMap_insertNew(BifrostHashMap* self, const void* key, unsigned hash, void* value);  // 'key' must not be in the map, 'hash' is 'params.hash(key)'
 void*         bfHashMap_get(BifrostHashMap* self, const void* key);
 int           bfHashMap_removeCmp(BifrostHashMap* self, const void* key, bfHashMapCmp cmp);  // 'key' is the first param for 'cmp'
 bfHashMapIter bfHashMap_itBegin(const BifrostHashMap* self);
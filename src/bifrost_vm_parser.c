@@ -39,28 +39,53 @@ extern BifrostObjModule* bfVM_importModule(BifrostVM* self, const char* from, co
 
 /*  */
 
-uint16_t bfVM_xSetVariable(BifrostVMSymbol** variables, BifrostVM* vm, string_range name, BifrostValue value)
+/*
+  NOTE(SR):
+    Interning [name] and growing the class or module may collect while a
+    freshly made [value] (Ex: a function that was just compiled) is not
+    reachable from anything yet.
+*/
+static void parserPushValueRoot(BifrostVM* vm, BifrostGCRoot* root, BifrostValue value)
 {
-  const size_t idx      = bfVM_getSymbol(vm, name);
-  const size_t old_size = bfVMArray_size(variables);
+  if (bfVMValue_isPointer(value))
+  {
+    bfGC_PushRoot(vm, root, BIFROST_AS_OBJ(value));
+  }
+}
 
-  if (idx >= old_size)
+static void parserPopValueRoot(BifrostVM* vm, BifrostValue value)
+{
+  if (bfVMValue_isPointer(value))
   {
-    const size_t new_size = idx + 1;
+    bfGC_PopRoot(vm);
+  }
+}
 
-    bfVMArray_resize(vm, variables, new_size);
+void bfVM_xSetClassSymbol(BifrostObjClass* clz, BifrostVM* vm, string_range name, BifrostValue value)
+{
+  BifrostGCRoot value_root;
+  parserPushValueRoot(vm, &value_root, value);
 
-    for (size_t i = old_size; i < new_size; ++i)
-    {
-      (*variables)[i].name  = NULL;
-      (*variables)[i].value = bfVMValue_fromNull();
-    }
-  }
+  const uint32_t symbol = bfVM_getSymbol(vm, name);
 
-  (*variables)[idx].name  = vm->symbols[idx];
-  (*variables)[idx].value = value;
+  bfObjClass_setSymbol(vm, clz, vm->symbols[symbol], value);
 
-  return idx & 0xFFFF;
+  parserPopValueRoot(vm, value);
+}
+
+uint32_t bfVM_xSetModuleVariable(BifrostObjModule* module, BifrostVM* vm, string_range name, BifrostValue value)
+{
+  BifrostGCRoot value_root;
+  parserPushValueRoot(vm, &value_root, value);
+
+  const uint32_t symbol = bfVM_getSymbol(vm, name);
+  const size_t   slot   = bfObjModule_addSlot(vm, module, vm->symbols[symbol]);
+
+  module->variables[slot].value = value;
+
+  parserPopValueRoot(vm, value);
+
+  return (uint32_t)slot;
 }
 
 static uint16_t parserGetSymbol(const BifrostParser* const self, const string_range name)
@@ -84,7 +109,7 @@ typedef enum VariableKind
 typedef struct VariableInfo
 {
   uint16_t kind : 1;                             /* VariableKind                                        */
-  uint16_t location : BIFROST_VAR_LOCATION_BITS; /* V_LOCAL => register index, V_MODULE => symbol index */
+  uint16_t location : BIFROST_VAR_LOCATION_BITS; /* V_LOCAL => register index, V_MODULE => module slot    */
 
 } VariableInfo;
 
@@ -115,19 +140,54 @@ static VariableInfo VariableInfo_local(const BifrostParser* const self, const st
   return var;
 }
 
-static VariableInfo VariableInfo_LocalOrSymbol(const BifrostParser* const self, const string_range name)
+static uint16_t parserModuleSlot(BifrostParser* const self, size_t slot)
+{
+  if (slot >= BIFROST_VM_INVALID_SLOT)
+  {
+    Parser_EmitError(self, "Module '%s' has too many variables (max is %u).", self->current_module->name, (unsigned)BIFROST_VM_INVALID_SLOT);
+    return BIFROST_VM_INVALID_SLOT;
+  }
+
+  return (uint16_t)slot;
+}
+
+static VariableInfo VariableInfo_LocalOrSymbol(BifrostParser* const self, const string_range name)
 {
   VariableInfo var = VariableInfo_local(self, name);
 
   if (var.location == BIFROST_VM_INVALID_SLOT)
   {
+    const uint32_t symbol = bfVM_getSymbol(self->vm, name);
+
     var.kind     = V_MODULE;
-    var.location = parserGetSymbol(self, name);
+    var.location = parserModuleSlot(self, bfObjModule_addSlot(self->vm, self->current_module, self->vm->symbols[symbol]));
   }
 
   return var;
 }
 
+/* A module 'const' that no local shadows, [out_value] is what gets substituted for [name]. */
+static bool parserFindConst(const BifrostParser* const self, const string_range name, BifrostValue* out_value)
+{
+  const BifrostObjModule* const module = self->current_module;
+
+  if (bfVMArray_size(&module->const_slots) == 0u || VariableInfo_local(self, name).location != BIFROST_VM_INVALID_SLOT)
+  {
+    return false;
+  }
+
+  const uint32_t symbol = bfVM_getSymbol(self->vm, name);
+  const size_t   slot   = bfObjModule_findSlot(module, self->vm->symbols[symbol]);
+
+  if (slot == BIFROST_ARRAY_INVALID_INDEX || !bfObjModule_isConst(module, slot))
+  {
+    return false;
+  }
+
+  *out_value = module->variables[slot].value;
+  return true;
+}
+
 /* Expr Grammar Rules */
 
 // https://en.wikipedia.org/wiki/Order_of_operations#Programming_languages
@@ -153,7 +213,8 @@ typedef enum Precedence
 
 typedef struct ExprInfo
 {
-  uint16_t     write_loc;
+  uint16_t     write_loc; /* The register the result must end up in.                                     */
+  uint16_t     read_loc;  /* The register the result currently lives in, a local is read from in place.  */
   VariableInfo var;
 
 } ExprInfo;
@@ -173,6 +234,7 @@ static ExprInfo exprMake(uint16_t write_loc, VariableInfo variable)
 {
   ExprInfo ret;
   ret.write_loc = write_loc;
+  ret.read_loc  = write_loc;
   ret.var       = variable;
 
   return ret;
@@ -221,6 +283,8 @@ static void loopPop(BifrostParser* const self)
 }
 
 static bool Parser_parseStatement(BifrostParser* const self);
+static int  parserParseFunction(BifrostParser* const self);
+static bool parserIsUpdateToken(const bfTokenType type);
 
 /* Jump Helpers */
 
@@ -288,12 +352,7 @@ static void parserVariableLoad(BifrostParser* const self, VariableInfo variable,
     }
     case V_MODULE:
     {
-      const uint16_t module_expr = bfFuncBuilder_pushTemp(self->fn_builder, 1);
-
-      bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_LOAD_BASIC, module_expr, BIFROST_VM_OP_LOAD_BASIC_CURRENT_MODULE);
-      bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_LOAD_SYMBOL, write_loc, module_expr, variable.location);
-
-      bfFuncBuilder_popTemp(self->fn_builder, module_expr);
+      bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_LOAD_GLOBAL, write_loc, variable.location);
       break;
     }
     default:
@@ -318,12 +377,7 @@ static void parserVariableStore(BifrostParser* const self, VariableInfo variable
     }
     case V_MODULE:
     {
-      const uint16_t module_expr = bfFuncBuilder_pushTemp(self->fn_builder, 1);
-
-      bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_LOAD_BASIC, module_expr, BIFROST_VM_OP_LOAD_BASIC_CURRENT_MODULE);
-      bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_STORE_SYMBOL, module_expr, variable.location, read_loc);
-
-      bfFuncBuilder_popTemp(self->fn_builder, module_expr);
+      bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_GLOBAL, read_loc, variable.location);
       break;
     }
     default:
@@ -356,7 +410,7 @@ static BifrostValue parserTokenConstexprValue(const BifrostParser* const self, c
 static void bfParser_pushBuilder(BifrostParser* const self, const char* fn_name, size_t fn_name_len)
 {
   self->fn_builder = bfVMArray_emplace(self->vm, &self->fn_builder_stack);
-  bfFuncBuilder_ctor(self->fn_builder, self->lexer);
+  bfFuncBuilder_ctor(self->fn_builder, self->lexer, &self->arena);
   bfFuncBuilder_begin(self->fn_builder, fn_name, fn_name_len);
 }
 
@@ -414,12 +468,36 @@ static inline bool bfParser_is(BifrostParser* const self, bfTokenType type)
 
 static inline GrammarRule typeToRule(const bfTokenType type);
 
+/* Applies infix operators to [expr_loc] until one binds looser than [minimum_prec]. */
+static void parseExprInfix(BifrostParser* const self, ExprInfo* expr_loc, const Precedence minimum_prec)
+{
+  while (minimum_prec < typeToRule(self->current_token.type).precedence)
+  {
+    const bfToken         token = self->current_token;
+    const InfixParseletFn infix = typeToRule(token.type).infix;
+
+    if (!infix)
+    {
+      Parser_EmitError(self, "No infix operator for token: %s", bfDbg_TokenTypeToString(token.type));
+      return;
+    }
+
+    bfParser_match(self, token.type);
+
+    infix(self, expr_loc, expr_loc, &token, typeToRule(token.type).precedence);
+  }
+}
+
 // Pratt Parser
 //   [Vaughan Pratt - Top Down Operator Precendence 1973](reference/Vaughan.Pratt.TDOP.pdf | https://tdop.github.io/)
 //
 //   [Pratt Parsing and Precedence Climbing Are the Same Algorithm](https://www.oilshell.org/blog/2016/11/01.html)
 //
-static void parseExpr(BifrostParser* const self, ExprInfo* expr_loc, const Precedence minimum_prec)
+//   The result is left wherever it was produced ([ExprInfo::read_loc]) so that
+//   consumers can read a local straight from its register, 'parseExpr' is the
+//   variant that guarantees the result is in [ExprInfo::write_loc].
+//
+static void parseExprDeferred(BifrostParser* const self, ExprInfo* expr_loc, const Precedence minimum_prec)
 {
   bfToken           token = self->current_token;
   const GrammarRule rule  = typeToRule(token.type);
@@ -434,32 +512,57 @@ static void parseExpr(BifrostParser* const self, ExprInfo* expr_loc, const Prece
 
   rule.prefix(self, expr_loc, &token);
 
-  while (minimum_prec < typeToRule(self->current_token.type).precedence)
+  parseExprInfix(self, expr_loc, minimum_prec);
+}
+
+static void parserExprMaterialize(BifrostParser* const self, ExprInfo* expr)
+{
+  if (expr->read_loc != expr->write_loc)
   {
-    token                       = self->current_token;
-    const InfixParseletFn infix = typeToRule(token.type).infix;
+    bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, expr->write_loc, expr->read_loc);
+    expr->read_loc = expr->write_loc;
+  }
+}
 
-    if (!infix)
-    {
-      Parser_EmitError(self, "No infix operator for token: %s", bfDbg_TokenTypeToString(token.type));
-      return;
-    }
+static void parseExpr(BifrostParser* const self, ExprInfo* expr_loc, const Precedence minimum_prec)
+{
+  parseExprDeferred(self, expr_loc, minimum_prec);
+  parserExprMaterialize(self, expr_loc);
+}
 
-    bfParser_match(self, token.type);
+/* Function Call Helpers */
 
-    infix(self, expr_loc, expr_loc, &token, typeToRule(token.type).precedence);
+/*
+  NOTE(SR):
+    Calling Convention:
+      [base + 0]   : The callee's register 0, holds the return value once the call is done.
+      [base + 1..] : The arguments, for methods 'self' is the first one.
+
+    The callee's frame starts at [base] so arguments are evaluated straight
+    into its parameters and when [base] is the destination register the
+    result is already where it needs to be.
+*/
+
+static uint16_t FunctionCall_begin(BifrostParser* const self, uint16_t return_loc)
+{
+  const size_t num_registers = bfVMArray_size(&self->fn_builder->local_vars);
+
+  /* @Optimization: The destination doubles as the base when nothing is allocated above it. */
+  if (return_loc != BIFROST_VM_INVALID_SLOT && (size_t)return_loc + 1u == num_registers)
+  {
+    return return_loc;
   }
-}
 
-/* Function Call Helpers */
+  return bfFuncBuilder_pushTemp(self->fn_builder, 1);
+}
 
-static uint16_t FunctionCall_parseParameters(BifrostParser* const self, uint16_t temp_first, uint16_t num_params, bfTokenType end_token)
+static uint16_t FunctionCall_parseParameters(BifrostParser* const self, uint16_t num_params, bfTokenType end_token)
 {
   if (!bfParser_is(self, end_token))
   {
     do
     {
-      const uint16_t param_loc  = num_params == 0 ? temp_first : bfFuncBuilder_pushTemp(self->fn_builder, 1);
+      const uint16_t param_loc  = bfFuncBuilder_pushTemp(self->fn_builder, 1);
       ExprInfo       param_expr = exprMakeTemp(param_loc);
 
       parseExpr(self, &param_expr, PREC_NONE);
@@ -472,36 +575,104 @@ static uint16_t FunctionCall_parseParameters(BifrostParser* const self, uint16_t
   return num_params;
 }
 
-static void FunctionCall_finish(BifrostParser* const self, VariableInfo fn, VariableInfo return_loc, uint32_t zero_slot)
+static const BifrostObjFn* FunctionCall_inlineTarget(const BifrostParser* const self, const ExprInfo* fn_expr, uint16_t num_params, uint16_t base)
 {
-  const bool     is_local_fn  = fn.kind == V_LOCAL;
-  const uint16_t function_loc = is_local_fn ? (uint16_t)fn.location : bfFuncBuilder_pushTemp(self->fn_builder, 1);
+  const uint32_t inline_threshold = self->vm->params.inline_threshold;
 
-  if (!is_local_fn)
+  if (inline_threshold == 0 || fn_expr->var.kind != V_MODULE || fn_expr->var.location == BIFROST_VM_INVALID_SLOT)
   {
-    parserVariableLoad(self, fn, function_loc);
+    return NULL;
   }
 
-  uint16_t       num_params = 0;
-  const uint16_t temp_first = bfFuncBuilder_pushTemp(self->fn_builder, 1);
+  const BifrostObjModule* const module = self->current_module;
 
-  if (zero_slot != BIFROST_VM_INVALID_SLOT)
+  if (fn_expr->var.location >= bfVMArray_size(&module->variables))
   {
-    bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, temp_first, zero_slot);
-    ++num_params;
+    return NULL;
   }
 
-  num_params = FunctionCall_parseParameters(self, temp_first, num_params, BIFROST_TOKEN_R_PAREN);
-  bfParser_eat(self, BIFROST_TOKEN_R_PAREN, false, "Function call must end with a closing parenthesis.");
+  const BifrostValue fn_value = module->variables[fn_expr->var.location].value;
 
-  bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_CALL_FN, temp_first, function_loc, num_params);
+  if (!bfVMValue_isPointer(fn_value) || BIFROST_AS_OBJ(fn_value)->type != BIFROST_VM_OBJ_FUNCTION)
+  {
+    return NULL;
+  }
 
-  if (return_loc.location != BIFROST_VM_INVALID_SLOT)
+  const BifrostObjFn* const fn = (const BifrostObjFn*)BIFROST_AS_OBJ(fn_value);
+
+  if (fn->module != module || fn->lazy_source || fn->arity != (int32_t)num_params || !bfFuncBuilder_canInline(self->fn_builder, fn, inline_threshold, base))
   {
-    parserVariableStore(self, return_loc, temp_first);
+    return NULL;
   }
 
-  bfFuncBuilder_popTemp(self->fn_builder, (is_local_fn ? temp_first : function_loc));
+  return fn;
+}
+
+static void FunctionCall_end(BifrostParser* const self, uint16_t base, uint16_t function_loc, uint16_t num_params, uint16_t return_loc, const BifrostObjFn* inline_fn)
+{
+  uint32_t skip_call_jump = BIFROST_VM_INVALID_SLOT;
+
+  /*
+    NOTE(SR):
+      The module variable can be reassigned at runtime so the inlined body is
+      guarded by checking that it still holds the function that was spliced in,
+      otherwise the regular call is made.
+  */
+  if (inline_fn)
+  {
+    const uint16_t guard_loc = bfFuncBuilder_pushTemp(self->fn_builder, 1);
+    const uint32_t k_loc     = bfFuncBuilder_addConstant(self->fn_builder, bfVMValue_fromPointer(inline_fn));
+
+    bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_LOAD_BASIC, guard_loc, BIFROST_VM_OP_LOAD_BASIC_CONSTANT + k_loc);
+    bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_CMP_EE, guard_loc, guard_loc, function_loc);
+
+    const uint32_t guard_jump = parserMakeJump(self);
+
+    bfFuncBuilder_popTemp(self->fn_builder, guard_loc);
+    bfFuncBuilder_inlineFunction(self->fn_builder, inline_fn, base);
+
+    skip_call_jump = parserMakeJump(self);
+
+    parserPatchJump(self, guard_jump, guard_loc, true);
+  }
+
+  bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_CALL_FN, base, function_loc, num_params);
+
+  if (skip_call_jump != BIFROST_VM_INVALID_SLOT)
+  {
+    parserPatchJump(self, skip_call_jump, BIFROST_VM_INVALID_SLOT, false);
+  }
+
+  if (base == return_loc)
+  {
+    bfFuncBuilder_popTemp(self->fn_builder, base + 1);
+  }
+  else
+  {
+    if (return_loc != BIFROST_VM_INVALID_SLOT)
+    {
+      bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, return_loc, base);
+    }
+
+    bfFuncBuilder_popTemp(self->fn_builder, base);
+  }
+}
+
+static uint16_t FunctionCall_pushSelf(BifrostParser* const self, const ExprInfo* obj_expr)
+{
+  const uint16_t self_loc = bfFuncBuilder_pushTemp(self->fn_builder, 1);
+
+  /*
+    @Optimization:
+      When the object was just computed into its [write_loc] the
+      instruction that did so is patched to write into the 'self' slot.
+  */
+  if (obj_expr->read_loc != obj_expr->write_loc || !bfFuncBuilder_retargetLastInst(self->fn_builder, 0, obj_expr->write_loc, self_loc))
+  {
+    bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, self_loc, obj_expr->read_loc);
+  }
+
+  return self_loc;
 }
 
 static void parseVarDecl(BifrostParser* const self, const bool is_static)
@@ -519,11 +690,18 @@ static void parseVarDecl(BifrostParser* const self, const bool is_static)
 
   if (bfParser_eat(self, BIFROST_TOKEN_IDENTIFIER, false, "Expected identifier after var keyword."))
   {
+    BifrostValue const_value;
+
+    if (is_static && parserFindConst(self, name, &const_value))
+    {
+      Parser_EmitError(self, "'%.*s' is already declared as a constant.", (int)name.str_len, name.str_bgn);
+    }
+
     if (is_static)
     {
-      const uint16_t location = bfVM_xSetVariable(&self->current_module->variables, self->vm, name, bfVMValue_fromNull());
+      const uint16_t location = parserModuleSlot(self, bfVM_xSetModuleVariable(self->current_module, self->vm, name, bfVMValue_fromNull()));
 
-      if (bfParser_match(self, BIFROST_TOKEN_EQUALS))
+      if (bfParser_match(self, BIFROST_TOKEN_EQUALS) && location != BIFROST_VM_INVALID_SLOT)
       {
         VariableInfo var;
         var.kind     = V_MODULE;
@@ -531,8 +709,8 @@ static void parseVarDecl(BifrostParser* const self, const bool is_static)
 
         const uint16_t expr_loc = bfFuncBuilder_pushTemp(self->fn_builder, 1);
         ExprInfo       expr     = exprMakeTemp(expr_loc);
-        parseExpr(self, &expr, PREC_NONE);
-        parserVariableStore(self, var, expr_loc);
+        parseExprDeferred(self, &expr, PREC_NONE);
+        parserVariableStore(self, var, expr.read_loc);
         bfFuncBuilder_popTemp(self->fn_builder, expr_loc);
       }
     }
@@ -551,18 +729,262 @@ static void parseVarDecl(BifrostParser* const self, const bool is_static)
   }
 }
 
+/* Constant Folding */
+
+static bool parserIsConstString(const BifrostValue value)
+{
+  return bfVMValue_isPointer(value) && BIFROST_AS_OBJ(value)->type == BIFROST_VM_OBJ_STRING;
+}
+
+static bool parserIsConstOp(const bfTokenType type)
+{
+  switch (type)
+  {
+    case BIFROST_TOKEN_PLUS:
+    case BIFROST_TOKEN_MINUS:
+    case BIFROST_TOKEN_MULT:
+    case BIFROST_TOKEN_DIV:
+    case BIFROST_TOKEN_CTRL_EE:
+    case BIFROST_TOKEN_CTRL_NE:
+    case BIFROST_TOKEN_CTRL_LT:
+    case BIFROST_TOKEN_CTRL_GT:
+    case BIFROST_TOKEN_CTRL_LE:
+    case BIFROST_TOKEN_CTRL_GE:
+    case BIFROST_TOKEN_CTRL_AND:
+    case BIFROST_TOKEN_CTRL_OR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/*
+  NOTE(SR):
+    Mirrors what the vm does for the same operator so a folded constant
+    has the value the expression would have had at runtime, '&&' / '||'
+    result in the lhs when it decides the outcome like the short circuit.
+    Ordering anything but numbers depends on where objects are allocated
+    so that is left as an error rather than folded.
+*/
+static bool parserFoldConstOp(BifrostParser* const self, const bfToken* token, const BifrostValue lhs, const BifrostValue rhs, BifrostValue* out_value)
+{
+  const bool is_numbers = bfVMValue_isNumber(lhs) && bfVMValue_isNumber(rhs);
+
+  switch (token->type)
+  {
+    case BIFROST_TOKEN_PLUS:
+    {
+      if (is_numbers)
+      {
+        *out_value = bfVMValue_fromNumber(bfVMValue_asNumber(lhs) + bfVMValue_asNumber(rhs));
+        return true;
+      }
+
+      if (parserIsConstString(lhs) || parserIsConstString(rhs))
+      {
+        char         string_buffer[512];
+        const size_t offset = bfDbg_ValueToString(lhs, string_buffer, sizeof(string_buffer));
+        bfDbg_ValueToString(rhs, string_buffer + offset, sizeof(string_buffer) - offset);
+
+        *out_value = bfVMValue_fromPointer(bfObj_NewString(self->vm, MakeString(string_buffer)));
+        return true;
+      }
+      break;
+    }
+    case BIFROST_TOKEN_MINUS:    *out_value = bfVMValue_sub(lhs, rhs); return is_numbers;
+    case BIFROST_TOKEN_MULT:     *out_value = bfVMValue_mul(lhs, rhs); return is_numbers;
+    case BIFROST_TOKEN_DIV:      *out_value = bfVMValue_div(lhs, rhs); return is_numbers;
+    case BIFROST_TOKEN_CTRL_EE:  *out_value = bfVMValue_fromBool(bfVMValue_ee(lhs, rhs)); return true;
+    case BIFROST_TOKEN_CTRL_NE:  *out_value = bfVMValue_fromBool(!bfVMValue_ee(lhs, rhs)); return true;
+    case BIFROST_TOKEN_CTRL_LT:  *out_value = bfVMValue_fromBool(bfVMValue_lt(lhs, rhs)); return is_numbers;
+    case BIFROST_TOKEN_CTRL_GT:  *out_value = bfVMValue_fromBool(bfVMValue_gt(lhs, rhs)); return is_numbers;
+    case BIFROST_TOKEN_CTRL_LE:  *out_value = bfVMValue_fromBool(bfVMValue_lt(lhs, rhs) || bfVMValue_ee(lhs, rhs)); return is_numbers;
+    case BIFROST_TOKEN_CTRL_GE:  *out_value = bfVMValue_fromBool(bfVMValue_gt(lhs, rhs) || bfVMValue_ee(lhs, rhs)); return is_numbers;
+    case BIFROST_TOKEN_CTRL_AND: *out_value = bfVMValue_isThuthy(lhs) ? bfVMValue_fromBool(bfVMValue_isThuthy(rhs)) : lhs; return true;
+    case BIFROST_TOKEN_CTRL_OR:  *out_value = bfVMValue_isThuthy(lhs) ? lhs : bfVMValue_fromBool(bfVMValue_isThuthy(rhs)); return true;
+    default:                     break;
+  }
+
+  return false;
+}
+
+static bool parserFoldConstExpr(BifrostParser* const self, const Precedence minimum_prec, BifrostValue* out_value);
+
+static bool parserFoldConstPrefix(BifrostParser* const self, BifrostValue* out_value)
+{
+  const bfToken token = self->current_token;
+
+  switch (token.type)
+  {
+    case BIFROST_TOKEN_CONST_REAL:
+    case BIFROST_TOKEN_CONST_BOOL:
+    case BIFROST_TOKEN_CONST_STR:
+    case BIFROST_TOKEN_CONST_NIL:
+    {
+      bfParser_match(self, token.type);
+      *out_value = parserTokenConstexprValue(self, &token);
+      return true;
+    }
+    case BIFROST_TOKEN_L_PAREN:
+    {
+      bfParser_match(self, BIFROST_TOKEN_L_PAREN);
+      const bool is_folded = parserFoldConstExpr(self, PREC_NONE, out_value);
+      bfParser_eat(self, BIFROST_TOKEN_R_PAREN, false, "Missing closing parenthesis for an group expression.");
+      return is_folded;
+    }
+    case BIFROST_TOKEN_MINUS:
+    {
+      bfParser_match(self, BIFROST_TOKEN_MINUS);
+
+      if (!parserFoldConstExpr(self, PREC_UNARY, out_value))
+      {
+        return false;
+      }
+
+      if (!bfVMValue_isNumber(*out_value))
+      {
+        Parser_EmitError(self, "Only a number can be negated.");
+        return false;
+      }
+
+      *out_value = bfVMValue_fromNumber(-bfVMValue_asNumber(*out_value));
+      return true;
+    }
+    case BIFROST_TOKEN_IDENTIFIER:
+    {
+      bfParser_match(self, BIFROST_TOKEN_IDENTIFIER);
+
+      if (!parserFindConst(self, token.str_range, out_value))
+      {
+        Parser_EmitError(self, "'%.*s' is not a constant.", (int)token.str_range.str_len, token.str_range.str_bgn);
+        return false;
+      }
+
+      return true;
+    }
+    default:
+    {
+      Parser_EmitError(self, "Expected a constant expression but got: %s", bfDbg_TokenTypeToString(token.type));
+      return false;
+    }
+  }
+}
+
+/* Same precedence climbing as 'parseExprDeferred' except the value is computed rather than code emitted for it. */
+static bool parserFoldConstExpr(BifrostParser* const self, const Precedence minimum_prec, BifrostValue* out_value)
+{
+  if (!parserFoldConstPrefix(self, out_value))
+  {
+    return false;
+  }
+
+  while (minimum_prec < typeToRule(self->current_token.type).precedence)
+  {
+    const bfToken token = self->current_token;
+
+    if (!parserIsConstOp(token.type))
+    {
+      Parser_EmitError(self, "'%.*s' cannot be used in a constant expression.", (int)token.str_range.str_len, token.str_range.str_bgn);
+      return false;
+    }
+
+    bfParser_match(self, token.type);
+
+    /* NOTE(SR): Folding the rhs can allocate, nothing else refers to a string lhs yet. */
+    BifrostGCRoot lhs_root;
+    const bool    is_rooted = bfVMValue_isPointer(*out_value);
+
+    if (is_rooted)
+    {
+      bfGC_PushRoot(self->vm, &lhs_root, BIFROST_AS_OBJ(*out_value));
+    }
+
+    BifrostValue rhs;
+    bool         is_folded = parserFoldConstExpr(self, typeToRule(token.type).precedence, &rhs);
+
+    if (is_folded && !parserFoldConstOp(self, &token, *out_value, rhs, out_value))
+    {
+      Parser_EmitError(self, "Operator '%.*s' cannot be folded for these operands.", (int)token.str_range.str_len, token.str_range.str_bgn);
+      is_folded = false;
+    }
+
+    if (is_rooted)
+    {
+      bfGC_PopRoot(self->vm);
+    }
+
+    if (!is_folded)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void parseConstDecl(BifrostParser* const self)
+{
+  /* GRAMMAR(SR):
+       const <identifier> = <const-expr>;
+
+     <const-expr> is made of literals, other constants, parenthesis and operators.
+  */
+
+  bfParser_match(self, BIFROST_TOKEN_CONST);
+
+  const string_range name = self->current_token.str_range;
+
+  if (bfParser_eat(self, BIFROST_TOKEN_IDENTIFIER, false, "Expected identifier after const keyword.") &&
+      bfParser_eat(self, BIFROST_TOKEN_EQUALS, false, "A constant must be initialized."))
+  {
+    /*
+      NOTE(SR):
+        The value is stored into the module variable at compile time, no code
+        is emitted for the declaration. Code compiled afterwards (in this or an
+        importing module) has the value substituted for the name.
+    */
+    BifrostValue value;
+    uint16_t     location = BIFROST_VM_INVALID_SLOT;
+
+    if (self->fn_builder != self->fn_builder_stack)
+    {
+      Parser_EmitError(self, "Constants can only be declared at module level.");
+    }
+    else if (parserFindConst(self, name, &value))
+    {
+      Parser_EmitError(self, "The constant '%.*s' is already declared.", (int)name.str_len, name.str_bgn);
+    }
+    else
+    {
+      location = parserModuleSlot(self, bfVM_xSetModuleVariable(self->current_module, self->vm, name, bfVMValue_fromNull()));
+    }
+
+    if (parserFoldConstExpr(self, PREC_NONE, &value) && location != BIFROST_VM_INVALID_SLOT)
+    {
+      self->current_module->variables[location].value = value;
+      bfObjModule_markConst(self->vm, self->current_module, location);
+    }
+
+    bfParser_eat(self, BIFROST_TOKEN_SEMI_COLON, false, "Expected semi colon after constant declaration.");
+  }
+}
+
 void bfParser_ctor(BifrostParser* const self, struct BifrostVM* vm, BifrostLexer* lexer, struct BifrostObjModule* current_module)
 {
   self->parent           = vm->parser_stack;
   vm->parser_stack       = self;
   self->lexer            = lexer;
   self->current_token    = bfLexer_nextToken(lexer);
-  self->fn_builder_stack = bfVMArray_new(vm, BifrostVMFunctionBuilder, 2);
+  bfVMArena_ctor(&self->arena, vm);
+  self->fn_builder_stack = bfVMArray_newArena(&self->arena, BifrostVMFunctionBuilder, 2);
   self->has_error        = false;
   self->current_clz      = NULL;
   self->loop_stack       = NULL;
   self->vm               = vm;
   self->current_module   = current_module;
+  self->lazy_source      = NULL;
+  self->postfix_copy     = BIFROST_ARRAY_INVALID_INDEX;
+  self->postfix_end      = 0u;
   bfParser_pushBuilder(self, self->current_module->name, bfVMString_length(self->current_module->name));
 }
 
@@ -575,14 +997,65 @@ bool bfParser_compile(BifrostParser* const self)
   return self->has_error;
 }
 
+bool bfParser_compileFunction(BifrostParser* const self, BifrostObjFn* fn)
+{
+  /*
+    NOTE(SR):
+      The module level builder stays at the bottom of the stack so that
+      functions declared in the body are still treated as locals.
+  */
+
+  BifrostObjFn compiled;
+
+  bfParser_pushBuilder(self, fn->name, bfVMString_length(fn->name));
+  const int arity = parserParseFunction(self);
+  bfParser_popBuilder(self, &compiled, arity);
+
+  compiled.module = fn->module;
+
+  if (self->has_error || arity != fn->arity)
+  {
+    /* NOTE(SR): Frees the code block and [BifrostObjFn::ctor_sites] along with it. */
+    compiled.lazy_source = NULL;
+    bfObj_Destruct(self->vm, &compiled.super);
+    self->has_error = true;
+  }
+  else
+  {
+    bfVMString_delete(self->vm, fn->name);
+
+    fn->name               = compiled.name;
+    fn->instructions       = compiled.instructions;
+    fn->constants          = compiled.constants;
+    fn->num_instructions   = compiled.num_instructions;
+    fn->num_constants      = compiled.num_constants;
+    fn->line_table         = compiled.line_table;
+    fn->line_table_size    = compiled.line_table_size;
+    fn->needed_stack_space = compiled.needed_stack_space;
+    fn->ctor_sites         = compiled.ctor_sites;
+    fn->lazy_source        = NULL;
+  }
+
+  bfFuncBuilder_dtor(self->fn_builder);
+  bfVMArray_pop(&self->fn_builder_stack);
+
+  return self->has_error;
+}
+
 void bfParser_dtor(BifrostParser* const self)
 {
-  self->vm->parser_stack = self->parent;
+  /* NOTE(SR): Stays on the parser stack until the module function is built so the gc still sees its constants. */
+  if (bfVMArray_size(&self->fn_builder_stack) != 0)
+  {
+    BifrostObjFn* const module_fn = &self->current_module->init_fn;
+
+    bfParser_popBuilder(self, module_fn, 0);
+  }
 
-  BifrostObjFn* const module_fn = &self->current_module->init_fn;
+  self->vm->parser_stack = self->parent;
 
-  bfParser_popBuilder(self, module_fn, 0);
-  bfVMArray_delete(self->vm, &self->fn_builder_stack);
+  bfVMArena_dtor(&self->arena);
+  self->fn_builder_stack = NULL;
 }
 
 static void parseBlock(BifrostParser* const self)
@@ -679,11 +1152,87 @@ static int parserParseFunction(BifrostParser* const self)
   return arity;
 }
 
+static void parserSkipFunction(BifrostParser* const self)
+{
+  /*
+    NOTE(SR):
+      The body is only matched brace for brace, syntax errors inside of it
+      are reported when the function is first called.
+  */
+
+  const string_range name_str = self->current_token.str_range;
+
+  bfParser_eat(self, BIFROST_TOKEN_IDENTIFIER, false, "Function name expected after 'func' keyword.");
+
+  // NOTE(SR): The lexer is always just past the current token, which is the opening parenthesis here.
+  const size_t params_offset = self->lexer->cursor - 1;
+  const size_t params_line   = self->lexer->current_line_no;
+  int          arity         = 0;
+
+  bfParser_eat(self, BIFROST_TOKEN_L_PAREN, false, "Expected parameter list after function name.");
+
+  while (!bfParser_is(self, BIFROST_TOKEN_R_PAREN))
+  {
+    bfParser_eat(self, BIFROST_TOKEN_IDENTIFIER, false, "Parameter names must be a word and not a keyword.");
+    bfParser_eat(self, BIFROST_TOKEN_COMMA, true, "The last comma isn't needed but this allows a func (a b c) syntax.");
+
+    ++arity;
+  }
+
+  bfParser_eat(self, BIFROST_TOKEN_R_PAREN, false, "Function must have a body.");
+
+  if (!bfParser_is(self, BIFROST_TOKEN_L_CURLY))
+  {
+    bfParser_eat(self, BIFROST_TOKEN_L_CURLY, false, "Block must start with an opening curly boi.");
+    return;
+  }
+
+  int depth = 0;
+
+  do
+  {
+    switch (self->current_token.type)
+    {
+      case BIFROST_TOKEN_L_CURLY: ++depth; break;
+      case BIFROST_TOKEN_R_CURLY: --depth; break;
+      case BIFROST_TOKEN_EOP:
+      {
+        Parser_EmitError(self, "Block must end with an closing curly boi.");
+        return;
+      }
+      default: break;
+    }
+
+    self->current_token = bfLexer_nextToken(self->lexer);
+
+  } while (depth != 0);
+
+  bfParser_match(self, BIFROST_TOKEN_SEMI_COLON);
+
+  BifrostVM* const    vm = self->vm;
+  BifrostObjFn* const fn = bfObj_NewFunction(vm, self->current_module);
+
+  fn->name         = bfVMString_newLen(vm, name_str.str_bgn, name_str.str_len);
+  fn->arity        = arity;
+  fn->lazy_source  = self->lazy_source;
+  fn->lazy_offset  = (uint32_t)params_offset;
+  fn->lazy_line_no = (uint32_t)params_line;
+
+  bfVM_xSetModuleVariable(self->current_module, vm, name_str, bfVMValue_fromPointer(fn));
+}
+
 static void parseFunctionDecl(BifrostParser* const self)
 {
   bfParser_match(self, BIFROST_TOKEN_FUNC);
 
-  const bool          is_local = bfVMArray_size(&self->fn_builder_stack) != 1;
+  const bool is_local = bfVMArray_size(&self->fn_builder_stack) != 1;
+
+  if (!is_local && self->lazy_source && bfParser_is(self, BIFROST_TOKEN_IDENTIFIER))
+  {
+    parserSkipFunction(self);
+    return;
+  }
+
   const string_range  name_str = parserBeginFunction(self, true);
   const int           arity    = parserParseFunction(self);
   BifrostObjFn* const fn       = bfObj_NewFunction(self->vm, self->current_module);
@@ -698,7 +1247,7 @@ static void parseFunctionDecl(BifrostParser* const self)
   }
   else
   {
-    bfVM_xSetVariable(&self->current_module->variables, self->vm, name_str, fn_value);
+    bfVM_xSetModuleVariable(self->current_module, self->vm, name_str, fn_value);
   }
 }
 
@@ -715,6 +1264,14 @@ static void Expr_parseFunctionExpr(BifrostParser* const self, ExprInfo* expr, co
   bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_LOAD_BASIC, expr->write_loc, BIFROST_VM_OP_LOAD_BASIC_CONSTANT + k_loc);
 }
 
+/* Remembers the values [imported_module]'s constants had so that a saved image of this module can tell when they changed. */
+static void parserAddConstImport(BifrostParser* const self, const BifrostObjModule* imported_module)
+{
+  const string_range module_name = MakeStringLen(imported_module->name, bfVMString_length(imported_module->name));
+
+  bfObjModule_addConstImport(self->vm, self->current_module, bfVM_getSymbol(self->vm, module_name), bfObjModule_constHash(imported_module));
+}
+
 static void parseImport(BifrostParser* const self)
 {
   /* GRAMMAR(SR):
@@ -754,7 +1311,15 @@ static void parseImport(BifrostParser* const self)
 
       if (imported_module)
       {
-        bfVM_xSetVariable(&self->current_module->variables, self->vm, dst_name, bfVM_stackFindVariable(imported_module, src_name.str_bgn, src_name.str_len));
+        const uint32_t dst_slot = bfVM_xSetModuleVariable(self->current_module, self->vm, dst_name, bfVM_stackFindVariable(imported_module, src_name.str_bgn, src_name.str_len));
+        const size_t   src_slot = bfObjModule_findSlot(imported_module, self->vm->symbols[bfVM_getSymbol(self->vm, src_name)]);
+
+        /* NOTE(SR): The imported module has already been compiled so its constants have their final value and are inlined here too. */
+        if (src_slot != BIFROST_ARRAY_INVALID_INDEX && bfObjModule_isConst(imported_module, src_slot))
+        {
+          bfObjModule_markConst(self->vm, self->current_module, dst_slot);
+          parserAddConstImport(self, imported_module);
+        }
       }
     } while (bfParser_match(self, BIFROST_TOKEN_COMMA));
   }
@@ -766,17 +1331,18 @@ static void parseImport(BifrostParser* const self)
     {
       const BifrostVMSymbol* const module_symbol = imported_module->variables + variable_index;
 
-      if (module_symbol->name == NULL)
+      /* NOTE(SR): A slot that is only referenced by the imported module's code was never declared. */
+      if (!bfVMValue_isNull(module_symbol->value))
       {
-        continue;
-      }
+        const string_range variable_name = MakeStringLen(module_symbol->name, bfVMString_length(module_symbol->name));
 
-      const string_range variable_name = MakeStringLen(module_symbol->name, bfVMString_length(module_symbol->name));
+        const uint32_t dst_slot = bfVM_xSetModuleVariable(self->current_module, self->vm, variable_name, module_symbol->value);
 
-      // TODO(SR): The way symbols are stored is dumb and leaves lots of empty slots.
-      if (!bfVMValue_isNull(module_symbol->value))
-      {
-        bfVM_xSetVariable(&self->current_module->variables, self->vm, variable_name, module_symbol->value);
+        if (bfObjModule_isConst(imported_module, variable_index))
+        {
+          bfObjModule_markConst(self->vm, self->current_module, dst_slot);
+          parserAddConstImport(self, imported_module);
+        }
       }
     }
   }
@@ -826,44 +1392,334 @@ static void parseForStatement(BifrostParser* const self)
       Parser_parseStatement(self);
     }
 
-    const uint32_t inc_to_cond = parserMakeJumpRev(self);
-    const uint16_t cond_loc    = bfFuncBuilder_pushTemp(self->fn_builder, 1);
+    const uint32_t inc_to_cond = parserMakeJumpRev(self);
+    const uint16_t cond_loc    = bfFuncBuilder_pushTemp(self->fn_builder, 1);
+    ExprInfo       cond_expr   = exprMake(cond_loc, VariableInfo_temp(BIFROST_VM_INVALID_SLOT));
+
+    if (!bfParser_is(self, BIFROST_TOKEN_SEMI_COLON))
+    {
+      parseExprDeferred(self, &cond_expr, PREC_NONE);
+    }
+    else
+    {
+      bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_LOAD_BASIC, cond_loc, BIFROST_VM_OP_LOAD_BASIC_TRUE);
+    }
+
+    const uint32_t cond_to_loop = parserMakeJump(self);
+    const uint32_t cond_to_end  = parserMakeJump(self);
+
+    bfFuncBuilder_popTemp(self->fn_builder, cond_loc);
+
+    bfParser_match(self, BIFROST_TOKEN_SEMI_COLON);
+
+    const uint32_t loop_to_inc = parserMakeJumpRev(self);
+    if (!bfParser_match(self, BIFROST_TOKEN_R_PAREN))
+    {
+      Parser_parseStatement(self);
+      bfParser_eat(self, BIFROST_TOKEN_R_PAREN, false, "Expected ( list after for loop.");
+    }
+    parserPatchJumpRev(self, inc_to_cond, BIFROST_VM_INVALID_SLOT, false);
+
+    parserPatchJump(self, cond_to_loop, cond_expr.read_loc, false);
+    loopPush(self, &loop);
+    parseBlock(self);
+    parserPatchJumpRev(self, loop_to_inc, BIFROST_VM_INVALID_SLOT, false);
+
+    parserPatchJump(self, cond_to_end, cond_expr.read_loc, true);
+    loopPop(self);
+  }
+  bfFuncBuilder_popScope(self->fn_builder);
+  bfParser_match(self, BIFROST_TOKEN_SEMI_COLON);
+}
+
+typedef struct SwitchCase
+{
+  BifrostValue key;
+  uint32_t     body; /*!< Index of the first instruction of the case's statements. */
+
+} SwitchCase;
+
+static bool parserParseCaseLabel(BifrostParser* const self, BifrostValue* out_key)
+{
+  const bool    is_negative = bfParser_match(self, BIFROST_TOKEN_MINUS);
+  const bfToken token       = self->current_token;
+
+  /* NOTE(SR): A constant is kept alive by its module variable. */
+  if (!is_negative && token.type == BIFROST_TOKEN_IDENTIFIER && parserFindConst(self, token.str_range, out_key))
+  {
+    bfParser_match(self, BIFROST_TOKEN_IDENTIFIER);
+    return true;
+  }
+
+  const bool is_literal = token.type == BIFROST_TOKEN_CONST_REAL ||
+                          (!is_negative && (token.type == BIFROST_TOKEN_CONST_BOOL ||
+                                            token.type == BIFROST_TOKEN_CONST_STR ||
+                                            token.type == BIFROST_TOKEN_CONST_NIL));
+
+  if (!is_literal)
+  {
+    Parser_EmitError(self, "A case label must be a constant or a number, string, boolean or nil literal.");
+    return false;
+  }
+
+  bfParser_match(self, token.type);
+
+  *out_key = is_negative ? bfVMValue_fromNumber(-token.num) : parserTokenConstexprValue(self, &token);
+
+  /* NOTE(SR): The builder's constants are what keeps a string label alive until the table is made. */
+  if (bfVMValue_isPointer(*out_key))
+  {
+    bfFuncBuilder_addConstant(self->fn_builder, *out_key);
+  }
+
+  return true;
+}
+
+/*
+  NOTE(SR):
+    The table read by 'SWITCH' lives in the function's constants, every
+    offset is relative to the 'SWITCH' and an offset of 0 means "no case"
+    which falls through to the jump to the default case.
+
+      Dense  : K[0] = n  | K[1] = lowest label | K[2 + i]             = offset of 'lowest label + i'
+      Hashed : K[0] = -n | K[1 + i * 2] = key  | K[2 + i * 2] = offset
+
+    A switch over integers spread no wider than twice the case count is
+    dense, anything else is hashed. A hashed table is open addressed with
+    linear probing from 'bfVMValue_hash(key) & (n - 1)', [n] is a power of
+    two at least twice the case count so a probe always finds a free slot.
+*/
+static void parserEmitSwitchTable(BifrostParser* const self, uint32_t switch_idx, uint16_t value_loc, const SwitchCase* cases, size_t num_cases)
+{
+  bool   is_dense = true;
+  double lowest   = 0.0;
+  double highest  = 0.0;
+
+  for (size_t i = 0; i < num_cases && is_dense; ++i)
+  {
+    const BifrostValue key    = cases[i].key;
+    const double       number = bfVMValue_isNumber(key) ? bfVMValue_asNumber(key) : 0.0;
+
+    /* NOTE(SR): Range checked before the cast, a label outside of int32 (or a NaN) makes the table hashed. */
+    if (!bfVMValue_isNumber(key) || !(number >= (double)INT32_MIN && number <= (double)INT32_MAX) || number != (double)(int32_t)number)
+    {
+      is_dense = false;
+    }
+    else
+    {
+      lowest  = (i == 0 || number < lowest) ? number : lowest;
+      highest = (i == 0 || number > highest) ? number : highest;
+    }
+  }
+
+  is_dense = is_dense && highest - lowest < (double)num_cases * 2.0;
+
+  size_t num_slots = 1u;
+
+  if (is_dense)
+  {
+    num_slots = (size_t)(highest - lowest) + 1u;
+  }
+  else
+  {
+    while (num_slots < num_cases * 2u)
+    {
+      num_slots *= 2u;
+    }
+  }
+
+  const size_t        table_size = is_dense ? 2u + num_slots : 1u + num_slots * 2u;
+  BifrostValue* const table      = bfVMArena_alloc(&self->arena, sizeof(BifrostValue) * table_size);
+
+  for (size_t i = 0; i < table_size; ++i)
+  {
+    table[i] = bfVMValue_fromNumber(0.0);
+  }
+
+  if (is_dense)
+  {
+    table[0] = bfVMValue_fromNumber((double)num_slots);
+    table[1] = bfVMValue_fromNumber(lowest);
+
+    for (size_t i = 0; i < num_cases; ++i)
+    {
+      table[2u + (size_t)(bfVMValue_asNumber(cases[i].key) - lowest)] = bfVMValue_fromNumber((double)cases[i].body - (double)switch_idx);
+    }
+  }
+  else
+  {
+    const uint32_t mask = (uint32_t)num_slots - 1u;
+
+    table[0] = bfVMValue_fromNumber(-(double)num_slots);
+
+    for (size_t i = 0; i < num_cases; ++i)
+    {
+      uint32_t slot = bfVMValue_hash(cases[i].key) & mask;
+
+      while (bfVMValue_asNumber(table[2u + slot * 2u]) != 0.0)
+      {
+        slot = (slot + 1u) & mask;
+      }
+
+      table[1u + slot * 2u] = cases[i].key;
+      table[2u + slot * 2u] = bfVMValue_fromNumber((double)cases[i].body - (double)switch_idx);
+    }
+  }
+
+  const uint32_t table_idx = bfFuncBuilder_addConstantTable(self->fn_builder, table, table_size);
+
+  if (table_idx + table_size > BIFROST_INST_RBx_MASK)
+  {
+    Parser_EmitError(self, "Too many constants in function '%.*s' for a switch table.", (int)self->fn_builder->name_len, self->fn_builder->name);
+  }
+
+  self->fn_builder->instructions[switch_idx] = BIFROST_MAKE_INST_OP_ABx(BIFROST_VM_OP_SWITCH, value_loc, table_idx);
+}
+
+static void parseSwitchStatement(BifrostParser* const self)
+{
+  /* GRAMMAR(SR):
+      switch (<expr>)
+      {
+        case <literal>: [case <literal>:]... <statement>...
+        default: <statement>...
+      }
+
+      <literal> may also be the name of a constant.
+  */
+  /*
+    // This gets compiled into:
+    //
+    //   switch <expr> -> label_case_N  (one instruction, see 'parserEmitSwitchTable')
+    //   goto label_default;            (label_end when there is no default)
+    //
+    // label_case_0:
+    //   <statements>...
+    //   goto label_end;
+    //
+    // ...
+    //
+    // label_case_N:
+    //   <statements>...
+    // label_end:
+    //
+    // Cases do not fall through, 'break' leaves the switch early.
+  */
+
+  bfParser_eat(self, BIFROST_TOKEN_L_PAREN, false, "Expected '(' after 'switch' keyword.");
+
+  const uint16_t expr_loc = bfFuncBuilder_pushTemp(self->fn_builder, 1);
+  ExprInfo       expr     = exprMake(expr_loc, VariableInfo_temp(BIFROST_VM_INVALID_SLOT));
+  parseExprDeferred(self, &expr, PREC_NONE);
+
+  bfParser_eat(self, BIFROST_TOKEN_R_PAREN, false, "switch statements must have r paren after the value.");
+  bfParser_eat(self, BIFROST_TOKEN_L_CURLY, false, "switch statements must have their cases within curly braces.");
+
+  /* NOTE(SR): Both patched once every case is known. */
+  const uint32_t switch_jump  = parserMakeJump(self);
+  const uint32_t default_jump = parserMakeJump(self);
+
+  bfFuncBuilder_popTemp(self->fn_builder, expr_loc);
+
+  SwitchCase* cases        = bfVMArray_newArena(&self->arena, SwitchCase, 8);
+  uint32_t*   end_jumps    = bfVMArray_newArena(&self->arena, uint32_t, 8);
+  size_t      default_body = BIFROST_ARRAY_INVALID_INDEX;
+  LoopInfo    loop;
+
+  loopPush(self, &loop);
+
+  while (!bfParser_is(self, BIFROST_TOKEN_R_CURLY) && !bfParser_is(self, BIFROST_TOKEN_EOP))
+  {
+    const uint32_t body = (uint32_t)bfVMArray_size(&self->fn_builder->instructions);
+
+    if (!bfParser_is(self, BIFROST_TOKEN_CTRL_CASE) && !bfParser_is(self, BIFROST_TOKEN_CTRL_DEFAULT))
+    {
+      Parser_EmitError(self, "Expected 'case' or 'default' in switch statement but got (%s).", bfDbg_TokenTypeToString(self->current_token.type));
+      bfParser_match(self, self->current_token.type);
+      continue;
+    }
+
+    while (bfParser_is(self, BIFROST_TOKEN_CTRL_CASE) || bfParser_is(self, BIFROST_TOKEN_CTRL_DEFAULT))
+    {
+      if (bfParser_match(self, BIFROST_TOKEN_CTRL_CASE))
+      {
+        SwitchCase new_case;
+        new_case.body = body;
+
+        if (parserParseCaseLabel(self, &new_case.key))
+        {
+          const size_t num_cases = bfVMArray_size(&cases);
+
+          for (size_t i = 0; i < num_cases; ++i)
+          {
+            if (bfVMValue_ee(cases[i].key, new_case.key))
+            {
+              Parser_EmitError(self, "Duplicate case label in switch statement.");
+              break;
+            }
+          }
+
+          bfVMArray_push(self->vm, &cases, &new_case);
+        }
+      }
+      else
+      {
+        bfParser_match(self, BIFROST_TOKEN_CTRL_DEFAULT);
+
+        if (default_body != BIFROST_ARRAY_INVALID_INDEX)
+        {
+          Parser_EmitError(self, "A switch statement can only have one default case.");
+        }
+
+        default_body = body;
+      }
+
+      bfParser_eat(self, BIFROST_TOKEN_COLON, false, "Expected ':' after a case label.");
+    }
+
+    bfFuncBuilder_pushScope(self->fn_builder);
+
+    while (!bfParser_is(self, BIFROST_TOKEN_CTRL_CASE) &&
+           !bfParser_is(self, BIFROST_TOKEN_CTRL_DEFAULT) &&
+           !bfParser_is(self, BIFROST_TOKEN_R_CURLY) &&
+           !bfParser_is(self, BIFROST_TOKEN_EOP))
+    {
+      Parser_parseStatement(self);
+    }
+
+    bfFuncBuilder_popScope(self->fn_builder);
 
-    if (!bfParser_is(self, BIFROST_TOKEN_SEMI_COLON))
-    {
-      ExprInfo cond_expr = exprMake(cond_loc, VariableInfo_temp(BIFROST_VM_INVALID_SLOT));
-      parseExpr(self, &cond_expr, PREC_NONE);
-    }
-    else
-    {
-      bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_LOAD_BASIC, cond_loc, BIFROST_VM_OP_LOAD_BASIC_TRUE);
-    }
+    const uint32_t end_jump = parserMakeJump(self);
+    bfVMArray_push(self->vm, &end_jumps, &end_jump);
+  }
 
-    const uint32_t cond_to_loop = parserMakeJump(self);
-    const uint32_t cond_to_end  = parserMakeJump(self);
+  bfParser_eat(self, BIFROST_TOKEN_R_CURLY, false, "switch statements must end with a closing curly brace.");
 
-    bfFuncBuilder_popTemp(self->fn_builder, cond_loc);
+  size_t num_end_jumps = bfVMArray_size(&end_jumps);
 
-    bfParser_match(self, BIFROST_TOKEN_SEMI_COLON);
+  /* @Optimization: The last case is already at the end. */
+  if (num_end_jumps)
+  {
+    bfFuncBuilder_removeInst(self->fn_builder, end_jumps[--num_end_jumps]);
+  }
 
-    const uint32_t loop_to_inc = parserMakeJumpRev(self);
-    if (!bfParser_match(self, BIFROST_TOKEN_R_PAREN))
-    {
-      Parser_parseStatement(self);
-      bfParser_eat(self, BIFROST_TOKEN_R_PAREN, false, "Expected ( list after for loop.");
-    }
-    parserPatchJumpRev(self, inc_to_cond, BIFROST_VM_INVALID_SLOT, false);
+  for (size_t i = 0; i < num_end_jumps; ++i)
+  {
+    parserPatchJump(self, end_jumps[i], BIFROST_VM_INVALID_SLOT, false);
+  }
 
-    parserPatchJump(self, cond_to_loop, cond_loc, false);
-    loopPush(self, &loop);
-    parseBlock(self);
-    parserPatchJumpRev(self, loop_to_inc, BIFROST_VM_INVALID_SLOT, false);
+  loopPop(self);
 
-    parserPatchJump(self, cond_to_end, cond_loc, true);
-    loopPop(self);
+  if (default_body != BIFROST_ARRAY_INVALID_INDEX)
+  {
+    parserPatchJumpHelper(self, default_jump, BIFROST_VM_INVALID_SLOT, (int)default_body - (int)default_jump, false);
   }
-  bfFuncBuilder_popScope(self->fn_builder);
-  bfParser_match(self, BIFROST_TOKEN_SEMI_COLON);
+  else
+  {
+    parserPatchJump(self, default_jump, BIFROST_VM_INVALID_SLOT, false);
+  }
+
+  parserEmitSwitchTable(self, switch_jump, expr.read_loc, cases, bfVMArray_size(&cases));
 }
 
 // Expr Parsers
@@ -871,7 +1727,7 @@ static void parseForStatement(BifrostParser* const self)
 static void Expr_parseGroup(BifrostParser* const self, ExprInfo* expr_info, const bfToken* token)
 {
   (void)token;
-  parseExpr(self, expr_info, PREC_NONE);
+  parseExprDeferred(self, expr_info, PREC_NONE);
   bfParser_eat(self, BIFROST_TOKEN_R_PAREN, false, "Missing closing parenthesis for an group expression.");
 }
 
@@ -882,10 +1738,8 @@ static void bfParser_loadConstant(BifrostParser* const self, ExprInfo* expr_info
   bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_LOAD_BASIC, expr_info->write_loc, const_loc + BIFROST_VM_OP_LOAD_BASIC_CONSTANT);
 }
 
-static void Expr_parseLiteral(BifrostParser* const self, ExprInfo* expr_info, const bfToken* token)
+static void parserLoadValue(BifrostParser* const self, ExprInfo* expr_info, BifrostValue constexpr_value)
 {
-  const BifrostValue constexpr_value = parserTokenConstexprValue(self, token);
-
   if (bfVMValue_isTrue(constexpr_value))
   {
     bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_LOAD_BASIC, expr_info->write_loc, BIFROST_VM_OP_LOAD_BASIC_TRUE);
@@ -904,6 +1758,11 @@ static void Expr_parseLiteral(BifrostParser* const self, ExprInfo* expr_info, co
   }
 }
 
+static void Expr_parseLiteral(BifrostParser* const self, ExprInfo* expr_info, const bfToken* token)
+{
+  parserLoadValue(self, expr_info, parserTokenConstexprValue(self, token));
+}
+
 static void Expr_parseNew(BifrostParser* const self, ExprInfo* expr, const bfToken* token)
 {
   (void)token;
@@ -917,8 +1776,6 @@ static void Expr_parseNew(BifrostParser* const self, ExprInfo* expr, const bfTok
 
     parserVariableLoad(self, clz_var, clz_loc);
 
-    bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_NEW_CLZ, expr->write_loc, clz_loc);
-
     string_range ctor_name = MakeString("ctor");
 
     if (bfParser_match(self, BIFROST_TOKEN_DOT))
@@ -933,16 +1790,32 @@ static void Expr_parseNew(BifrostParser* const self, ExprInfo* expr, const bfTok
 
     if (bfParser_match(self, BIFROST_TOKEN_L_PAREN))
     {
-      const uint16_t     ctor_sym     = parserGetSymbol(self, ctor_name);
-      const VariableInfo function_var = VariableInfo_temp(clz_loc);
-      const VariableInfo return_var   = VariableInfo_temp(BIFROST_VM_INVALID_SLOT);
+      /* NOTE(SR): [clz_loc] is the top register so it is reused as the base of the constructor call. */
+      const uint16_t ctor_sym  = parserGetSymbol(self, ctor_name);
+      const uint32_t ctor_site = bfFuncBuilder_addCtorSite(self->fn_builder, ctor_sym);
+      const uint16_t self_loc  = bfFuncBuilder_pushTemp(self->fn_builder, 1);
+
+      if (ctor_site <= BIFROST_INST_RC_MASK)
+      {
+        bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_NEW_CONSTRUCT, expr->write_loc, clz_loc, (uint16_t)ctor_site);
+      }
+      else
+      {
+        bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_NEW_CLZ, expr->write_loc, clz_loc);
+        bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_LOAD_SYMBOL, clz_loc, clz_loc, ctor_sym);
+        bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, self_loc, expr->write_loc);
+      }
 
-      bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_LOAD_SYMBOL, clz_loc, clz_loc, ctor_sym);
+      const uint16_t num_args = FunctionCall_parseParameters(self, 1, BIFROST_TOKEN_R_PAREN);
+      bfParser_eat(self, BIFROST_TOKEN_R_PAREN, false, "Function call must end with a closing parenthesis.");
 
-      FunctionCall_finish(self, function_var, return_var, expr->write_loc);
+      FunctionCall_end(self, clz_loc, clz_loc, num_args, BIFROST_VM_INVALID_SLOT, NULL);
+    }
+    else
+    {
+      bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_NEW_CLZ, expr->write_loc, clz_loc);
+      bfFuncBuilder_popTemp(self->fn_builder, clz_loc);
     }
-
-    bfFuncBuilder_popTemp(self->fn_builder, clz_loc);
   }
 }
 
@@ -970,17 +1843,37 @@ static void Expr_parseSuper(BifrostParser* const self, ExprInfo* expr, const bfT
 static void Expr_parseVariable(BifrostParser* const self, ExprInfo* expr, const bfToken* token)
 {
   const string_range var_name = token->str_range;
-  VariableInfo       var      = expr->var;
+  BifrostValue       const_value;
 
-  if (var.location == BIFROST_VM_INVALID_SLOT)
+  /* @Optimization: A constant is loaded straight from the function's constants, the module variable is never read. */
+  if (parserFindConst(self, var_name, &const_value))
   {
-    var = VariableInfo_LocalOrSymbol(self, var_name);
+    if (self->current_token.type == BIFROST_TOKEN_EQUALS || parserIsUpdateToken(self->current_token.type))
+    {
+      Parser_EmitError(self, "Cannot assign to the constant '%.*s'.", (int)(var_name.str_len), var_name.str_bgn);
+    }
+
+    parserLoadValue(self, expr, const_value);
+    *expr = exprMakeTemp(expr->write_loc);
+    return;
   }
 
+  const VariableInfo var = VariableInfo_LocalOrSymbol(self, var_name);
+
   if (var.location != BIFROST_VM_INVALID_SLOT)
   {
-    parserVariableLoad(self, var, expr->write_loc);
     (*expr) = exprMake(expr->write_loc, var);
+
+    if (var.kind == V_LOCAL)
+    {
+      /* @Optimization: Locals are read in place, the move only happens if the consumer needs the value in [write_loc]. */
+      expr->read_loc = var.location;
+    }
+    else if (self->current_token.type != BIFROST_TOKEN_EQUALS)
+    {
+      /* @Optimization: The target of an assignment does not need its old value loaded. */
+      parserVariableLoad(self, var, expr->write_loc);
+    }
   }
   else
   {
@@ -1010,13 +1903,32 @@ static void Expr_parseBinOp(BifrostParser* const self, ExprInfo* expr_info, cons
     default:  Parser_EmitError(self, "Invalid Binary Operator. %.*s", (int)token->str_range.str_len, token->str_range.str_bgn); break;
   }
 
-  const uint16_t rhs_loc  = bfFuncBuilder_pushTemp(self->fn_builder, 1);
-  ExprInfo       rhs_expr = exprMake(rhs_loc, VariableInfo_temp(BIFROST_VM_INVALID_SLOT));
-  const uint32_t jmp      = bin_op == '&' || bin_op == '|' ? parserMakeJump(self) : BIFROST_VM_INVALID_SLOT;
+  const bool is_short_circuit = bin_op == '&' || bin_op == '|';
 
-  parseExpr(self, &rhs_expr, prec);
+  if (is_short_circuit)
+  {
+    // NOTE(SR): The short circuit path skips the op so the lhs must already be the result.
+    parserExprMaterialize(self, expr_info);
+  }
+
+  uint16_t       lhs_loc   = lhs->read_loc;
+  const uint16_t rhs_loc   = bfFuncBuilder_pushTemp(self->fn_builder, 1);
+  ExprInfo       rhs_expr  = exprMake(rhs_loc, VariableInfo_temp(BIFROST_VM_INVALID_SLOT));
+  const uint32_t jmp       = is_short_circuit ? parserMakeJump(self) : BIFROST_VM_INVALID_SLOT;
+  const size_t   rhs_start = bfVMArray_size(&self->fn_builder->instructions);
+
+  parseExprDeferred(self, &rhs_expr, prec);
 
-  bfFuncBuilder_addInstABC(self->fn_builder, inst, expr_info->write_loc, lhs->write_loc, rhs_loc);
+  // NOTE(SR):
+  //   The lhs is being read in place from a local, if the rhs assigns
+  //   to that same local the old value has to be copied out beforehand.
+  if (lhs_loc != expr_info->write_loc && bfFuncBuilder_writesRegister(self->fn_builder, rhs_start, lhs_loc))
+  {
+    bfFuncBuilder_insertInstABx(self->fn_builder, rhs_start, BIFROST_VM_OP_STORE_MOVE, expr_info->write_loc, lhs_loc);
+    lhs_loc = expr_info->write_loc;
+  }
+
+  bfFuncBuilder_addInstABC(self->fn_builder, inst, expr_info->write_loc, lhs_loc, rhs_expr.read_loc);
 
   if (jmp != BIFROST_VM_INVALID_SLOT)
   {
@@ -1024,30 +1936,23 @@ static void Expr_parseBinOp(BifrostParser* const self, ExprInfo* expr_info, cons
   }
 
   bfFuncBuilder_popTemp(self->fn_builder, rhs_loc);
+
+  *expr_info = exprMakeTemp(expr_info->write_loc);
 }
 
 static void Expr_parseSubscript(BifrostParser* const self, ExprInfo* expr, const ExprInfo* lhs, const bfToken* token, Precedence prec)
 {
-  (void)lhs;
   (void)token;
   (void)prec;
 
-  // TODO(SR):
-  //   Find some way to merge this into the main function call routine.
-  const uint16_t subscript_op_loc = bfFuncBuilder_pushTemp(self->fn_builder, 3);
-  const uint16_t self_loc         = subscript_op_loc + 1;
-  const uint16_t temp_first       = subscript_op_loc + 2;
-  const uint16_t subscript_sym    = parserGetSymbol(self, MakeString("[]"));
-  uint16_t       num_args         = 1;
-
-  parserVariableLoad(self, expr->var, self_loc);
-
+  const uint16_t base          = FunctionCall_begin(self, expr->write_loc);
+  const uint16_t self_loc      = FunctionCall_pushSelf(self, lhs);
+  const uint16_t subscript_sym = parserGetSymbol(self, MakeString("[]"));
   const uint32_t load_sym_inst = (uint32_t)bfVMArray_size(&self->fn_builder->instructions);
 
-  bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_LOAD_SYMBOL, subscript_op_loc, self_loc, (uint16_t)subscript_sym);
-  bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, temp_first, self_loc);
+  bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_LOAD_SYMBOL, base, self_loc, (uint16_t)subscript_sym);
 
-  num_args = FunctionCall_parseParameters(self, temp_first, num_args, BIFROST_TOKEN_R_SQR_BOI);
+  uint16_t num_args = FunctionCall_parseParameters(self, 1, BIFROST_TOKEN_R_SQR_BOI);
 
   bfParser_eat(self, BIFROST_TOKEN_R_SQR_BOI, false, "Subscript call must end with a closing square bracket.");
 
@@ -1065,10 +1970,140 @@ static void Expr_parseSubscript(BifrostParser* const self, ExprInfo* expr, const
     ++num_args;
   }
 
-  bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_CALL_FN, temp_first, subscript_op_loc, num_args);
-  bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, expr->write_loc, temp_first);
+  FunctionCall_end(self, base, base, num_args, expr->write_loc, NULL);
+
+  *expr = exprMakeTemp(expr->write_loc);
+}
+
+/* Compound Assignment */
+
+static bool parserIsUpdateToken(const bfTokenType type)
+{
+  switch (type)
+  {
+    case BIFROST_TOKEN_PLUS_EQUALS:
+    case BIFROST_TOKEN_MINUS_EQUALS:
+    case BIFROST_TOKEN_MULT_EQUALS:
+    case BIFROST_TOKEN_DIV_EQUALS:
+    case BIFROST_TOKEN_INC:
+    case BIFROST_TOKEN_DEC:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static bfInstructionOp parserUpdateOp(const bfTokenType type)
+{
+  switch (type)
+  {
+    case BIFROST_TOKEN_MINUS_EQUALS: return BIFROST_VM_OP_MATH_SUB;
+    case BIFROST_TOKEN_MULT_EQUALS:  return BIFROST_VM_OP_MATH_MUL;
+    case BIFROST_TOKEN_DIV_EQUALS:   return BIFROST_VM_OP_MATH_DIV;
+    default:                         return BIFROST_VM_OP_MATH_ADD;
+  }
+}
+
+/*
+  NOTE(SR):
+    Parses the rhs of 'op=' and updates [value_loc] in place with it, an
+    integer literal (or constant) rhs of '+=' / '-=' becomes the immediate
+    of a single 'MATH_INC' so no constant is loaded at all.
+*/
+static void parserUpdateInPlace(BifrostParser* const self, bfInstructionOp op, uint16_t value_loc, Precedence prec)
+{
+  const uint16_t spill_loc = bfFuncBuilder_pushTemp(self->fn_builder, 2);
+  const uint16_t rhs_loc   = spill_loc + 1;
+  ExprInfo       rhs_expr  = exprMakeTemp(rhs_loc);
+  const size_t   rhs_start = bfVMArray_size(&self->fn_builder->instructions);
+  const bfToken  literal   = self->current_token;
+  uint16_t       lhs_loc   = value_loc;
+  BifrostValue   rhs_value = literal.type == BIFROST_TOKEN_CONST_REAL ? bfVMValue_fromNumber(literal.num) : bfVMValue_fromNull();
+
+  const bool is_number = bfVMValue_isNumber(rhs_value) ||
+                         (literal.type == BIFROST_TOKEN_IDENTIFIER && parserFindConst(self, literal.str_range, &rhs_value) && bfVMValue_isNumber(rhs_value));
+  const double num = is_number ? bfVMValue_asNumber(rhs_value) : 0.0;
+
+  if ((op == BIFROST_VM_OP_MATH_ADD || op == BIFROST_VM_OP_MATH_SUB) &&
+      is_number &&
+      num > 0.0 && num <= (double)BIFROST_INST_RsBx_MAX && num == (double)(int32_t)num)
+  {
+    bfParser_match(self, literal.type);
+
+    if (prec >= typeToRule(self->current_token.type).precedence)
+    {
+      const int32_t amount = (int32_t)num;
+
+      bfFuncBuilder_addInstAsBx(self->fn_builder, BIFROST_VM_OP_MATH_INC, value_loc, op == BIFROST_VM_OP_MATH_SUB ? -amount : amount);
+      bfFuncBuilder_popTemp(self->fn_builder, spill_loc);
+      return;
+    }
+
+    parserLoadValue(self, &rhs_expr, rhs_value);
+    parseExprInfix(self, &rhs_expr, prec);
+  }
+  else
+  {
+    parseExprDeferred(self, &rhs_expr, prec);
+  }
+
+  // NOTE(SR): Same as a binary operator, the rhs assigning to the local being updated must not change the value it is combined with.
+  if (bfFuncBuilder_writesRegister(self->fn_builder, rhs_start, value_loc))
+  {
+    bfFuncBuilder_insertInstABx(self->fn_builder, rhs_start, BIFROST_VM_OP_STORE_MOVE, spill_loc, value_loc);
+    lhs_loc = spill_loc;
+  }
+
+  bfFuncBuilder_addInstABC(self->fn_builder, op, value_loc, lhs_loc, rhs_expr.read_loc);
+  bfFuncBuilder_popTemp(self->fn_builder, spill_loc);
+}
+
+/*
+  NOTE(SR):
+    'obj.field op= rhs', 'obj.field++' and 'obj.field--'.
+    The field gets its own register so the object survives being in [write_loc].
+*/
+static void parserUpdateField(BifrostParser* const self, ExprInfo* expr, uint16_t obj_loc, uint16_t sym, const bfToken* token, Precedence prec)
+{
+  const bool     obj_in_dst = obj_loc == expr->write_loc;
+  const bool     is_postfix = token->type == BIFROST_TOKEN_INC || token->type == BIFROST_TOKEN_DEC;
+  const uint16_t value_loc  = obj_in_dst || is_postfix ? bfFuncBuilder_pushTemp(self->fn_builder, 1) : expr->write_loc;
+
+  bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_LOAD_SYMBOL, value_loc, obj_loc, sym);
+
+  if (is_postfix)
+  {
+    const uint16_t old_loc = obj_in_dst ? bfFuncBuilder_pushTemp(self->fn_builder, 1) : expr->write_loc;
+
+    self->postfix_copy = obj_in_dst ? BIFROST_ARRAY_INVALID_INDEX : bfVMArray_size(&self->fn_builder->instructions);
+    bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, old_loc, value_loc);
+    bfFuncBuilder_addInstAsBx(self->fn_builder, BIFROST_VM_OP_MATH_INC, value_loc, token->type == BIFROST_TOKEN_INC ? 1 : -1);
+    bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_STORE_SYMBOL, obj_loc, sym, value_loc);
+
+    if (obj_in_dst)
+    {
+      bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, expr->write_loc, old_loc);
+    }
+
+    self->postfix_end = bfVMArray_size(&self->fn_builder->instructions);
+  }
+  else
+  {
+    parserUpdateInPlace(self, parserUpdateOp(token->type), value_loc, prec);
+    bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_STORE_SYMBOL, obj_loc, sym, value_loc);
+
+    if (value_loc != expr->write_loc)
+    {
+      bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, expr->write_loc, value_loc);
+    }
+  }
+
+  if (value_loc != expr->write_loc)
+  {
+    bfFuncBuilder_popTemp(self->fn_builder, value_loc);
+  }
 
-  bfFuncBuilder_popTemp(self->fn_builder, subscript_op_loc);
+  *expr = exprMakeTemp(expr->write_loc);
 }
 
 static void Expr_parseDotOp(BifrostParser* const self, ExprInfo* expr, const ExprInfo* lhs, const bfToken* token, Precedence prec)
@@ -1077,46 +2112,64 @@ static void Expr_parseDotOp(BifrostParser* const self, ExprInfo* expr, const Exp
   // self->current_token = rhs token
   // expr->token         = lhs token
 
-  static const bool isRightAssoc = true;
+  (void)prec;
 
   if (self->current_token.type == BIFROST_TOKEN_IDENTIFIER)
   {
-    const bfToken field = self->current_token;
-    const size_t  sym   = parserGetSymbol(self, field.str_range);
+    const bfToken  field   = self->current_token;
+    const size_t   sym     = parserGetSymbol(self, field.str_range);
+    const uint16_t obj_loc = lhs->read_loc;
 
-    bfFuncBuilder_addInstABC(
-     self->fn_builder,
-     BIFROST_VM_OP_LOAD_SYMBOL,
-     expr->write_loc,
-     lhs->write_loc,
-     (uint16_t)sym);
+    bfParser_match(self, BIFROST_TOKEN_IDENTIFIER);
 
-    const VariableInfo lhs_var = lhs->var;
+    if (self->current_token.type == BIFROST_TOKEN_EQUALS)
+    {
+      bfParser_match(self, BIFROST_TOKEN_EQUALS);
 
-    *expr              = exprMakeTemp(expr->write_loc);
-    expr->var.location = expr->write_loc;
+      /* @Optimization: A store does not need the old value of the field, the rhs goes straight to the destination unless the object lives there. */
+      const bool     obj_in_dst = obj_loc == expr->write_loc;
+      const uint16_t rhs_loc    = obj_in_dst ? bfFuncBuilder_pushTemp(self->fn_builder, 1) : expr->write_loc;
+      ExprInfo       rhs_expr   = exprMakeTemp(rhs_loc);
 
-    parseExpr(self, expr, prec - (isRightAssoc ? 1 : 0));
+      parseExprDeferred(self, &rhs_expr, PREC_ASSIGN);
 
-    if (bfParser_match(self, BIFROST_TOKEN_EQUALS))
-    {
-      const uint16_t rhs_loc = bfFuncBuilder_pushTemp(self->fn_builder, 2);
-      const uint16_t var_loc = rhs_loc + 1;
+      bfFuncBuilder_addInstABC(
+       self->fn_builder,
+       BIFROST_VM_OP_STORE_SYMBOL,
+       obj_loc,
+       (uint16_t)sym,
+       rhs_expr.read_loc);
 
-      ExprInfo rhs_expr = exprMakeTemp(rhs_loc);
+      *expr = exprMakeTemp(expr->write_loc);
 
-      parseExpr(self, &rhs_expr, PREC_ASSIGN);
+      if (obj_in_dst)
+      {
+        bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, expr->write_loc, rhs_expr.read_loc);
+        bfFuncBuilder_popTemp(self->fn_builder, rhs_loc);
+      }
+      else
+      {
+        expr->read_loc = rhs_expr.read_loc;
+      }
+    }
+    else if (parserIsUpdateToken(self->current_token.type))
+    {
+      const bfToken update = self->current_token;
 
-      parserVariableLoad(self, lhs_var, var_loc);
+      bfParser_match(self, update.type);
 
+      parserUpdateField(self, expr, obj_loc, (uint16_t)sym, &update, PREC_ASSIGN);
+    }
+    else
+    {
       bfFuncBuilder_addInstABC(
        self->fn_builder,
-       BIFROST_VM_OP_STORE_SYMBOL,
-       var_loc,
-       (uint16_t)sym,
-       rhs_expr.write_loc);
+       BIFROST_VM_OP_LOAD_SYMBOL,
+       expr->write_loc,
+       obj_loc,
+       (uint16_t)sym);
 
-      bfFuncBuilder_popTemp(self->fn_builder, rhs_loc);
+      *expr = exprMakeTemp(expr->write_loc);
     }
   }
   else
@@ -1127,44 +2180,191 @@ static void Expr_parseDotOp(BifrostParser* const self, ExprInfo* expr, const Exp
 
 static void Expr_parseAssign(BifrostParser* const self, ExprInfo* expr, const ExprInfo* lhs, const bfToken* token, Precedence prec)
 {
-  (void)expr;
-  (void)token;
+  const VariableInfo lhs_var = lhs->var;
 
-  const uint16_t rhs_loc  = bfFuncBuilder_pushTemp(self->fn_builder, 1);
-  ExprInfo       rhs_expr = exprMakeTemp(rhs_loc);
-  parseExpr(self, &rhs_expr, prec);
-  parserVariableStore(self, lhs->var, rhs_loc);
-  bfFuncBuilder_popTemp(self->fn_builder, rhs_loc);
+  if (lhs_var.location == BIFROST_VM_INVALID_SLOT)
+  {
+    Parser_EmitError(self, "Invalid assignment target.");
+  }
+
+  if (token->type != BIFROST_TOKEN_EQUALS)
+  {
+    /* @Optimization: A local is updated in its own register, anything else was already loaded into [write_loc] by the lhs. */
+    const bool is_local = lhs_var.kind == V_LOCAL && lhs_var.location != BIFROST_VM_INVALID_SLOT;
+
+    if (!is_local)
+    {
+      *expr = *lhs;
+      parserExprMaterialize(self, expr);
+    }
+
+    const uint16_t value_loc = is_local ? lhs_var.location : expr->write_loc;
+
+    parserUpdateInPlace(self, parserUpdateOp(token->type), value_loc, prec);
+
+    if (lhs_var.kind == V_MODULE && lhs_var.location != BIFROST_VM_INVALID_SLOT)
+    {
+      parserVariableStore(self, lhs_var, value_loc);
+    }
+
+    *expr          = exprMake(expr->write_loc, lhs_var);
+    expr->read_loc = value_loc;
+    return;
+  }
+
+  if (lhs_var.kind == V_LOCAL)
+  {
+    // NOTE(SR): Nothing was loaded into [expr->write_loc] for the target so it is free to hold the rhs.
+    const uint16_t rhs_loc   = expr->write_loc;
+    ExprInfo       rhs_expr  = exprMakeTemp(rhs_loc);
+    const size_t   rhs_start = bfVMArray_size(&self->fn_builder->instructions);
+
+    parseExprDeferred(self, &rhs_expr, prec);
+
+    if (lhs_var.location != BIFROST_VM_INVALID_SLOT)
+    {
+      /* @Optimization: The instruction that computed the rhs is patched to write straight into the local. */
+      if (rhs_expr.read_loc != rhs_loc || !bfFuncBuilder_retargetLastInst(self->fn_builder, rhs_start, rhs_loc, lhs_var.location))
+      {
+        parserVariableLoad(self, VariableInfo_temp(rhs_expr.read_loc), lhs_var.location);
+      }
+    }
+
+    *expr = exprMake(expr->write_loc, lhs_var);
+
+    if (lhs_var.location != BIFROST_VM_INVALID_SLOT)
+    {
+      expr->read_loc = lhs_var.location;
+    }
+  }
+  else
+  {
+    ExprInfo rhs_expr = exprMakeTemp(expr->write_loc);
+
+    parseExprDeferred(self, &rhs_expr, prec);
+    parserVariableStore(self, lhs_var, rhs_expr.read_loc);
+
+    *expr          = exprMake(expr->write_loc, lhs_var);
+    expr->read_loc = rhs_expr.read_loc;
+  }
 }
 
-static void Expr_parseCall(BifrostParser* const self, ExprInfo* expr, const ExprInfo* lhs, const bfToken* token, Precedence prec)
+static void Expr_parsePrefixIncDec(BifrostParser* const self, ExprInfo* expr, const bfToken* token)
+{
+  const int32_t amount        = token->type == BIFROST_TOKEN_INC ? 1 : -1;
+  const size_t  operand_start = bfVMArray_size(&self->fn_builder->instructions);
+
+  parseExprDeferred(self, expr, PREC_PREFIX);
+
+  const VariableInfo   var       = expr->var;
+  const size_t         num_insts = bfVMArray_size(&self->fn_builder->instructions);
+  const bfInstruction* last_inst = num_insts > operand_start ? self->fn_builder->instructions + (num_insts - 1) : NULL;
+
+  if (var.location != BIFROST_VM_INVALID_SLOT && var.kind == V_LOCAL)
+  {
+    bfFuncBuilder_addInstAsBx(self->fn_builder, BIFROST_VM_OP_MATH_INC, var.location, amount);
+  }
+  else if (var.location != BIFROST_VM_INVALID_SLOT)
+  {
+    parserExprMaterialize(self, expr);
+    bfFuncBuilder_addInstAsBx(self->fn_builder, BIFROST_VM_OP_MATH_INC, expr->write_loc, amount);
+    parserVariableStore(self, var, expr->write_loc);
+  }
+  /*
+    NOTE(SR):
+      The dot operator only sees the field after it has been read, the
+      read is turned into an update as long as the object is still intact
+      in a local below [write_loc].
+  */
+  else if (last_inst &&
+           bfInst_getX(*last_inst, OP) == BIFROST_VM_OP_LOAD_SYMBOL &&
+           bfInst_getX(*last_inst, RA) == expr->read_loc &&
+           bfInst_getX(*last_inst, RB) < expr->read_loc)
+  {
+    const uint16_t obj_loc = (uint16_t)bfInst_getX(*last_inst, RB);
+    const uint16_t sym     = (uint16_t)bfInst_getX(*last_inst, RC);
+
+    bfFuncBuilder_addInstAsBx(self->fn_builder, BIFROST_VM_OP_MATH_INC, expr->read_loc, amount);
+    bfFuncBuilder_addInstABC(self->fn_builder, BIFROST_VM_OP_STORE_SYMBOL, obj_loc, sym, expr->read_loc);
+  }
+  else
+  {
+    Parser_EmitError(self, "Invalid target for a prefix '%.*s'.", (int)token->str_range.str_len, token->str_range.str_bgn);
+  }
+}
+
+static void Expr_parsePostfixIncDec(BifrostParser* const self, ExprInfo* expr, const ExprInfo* lhs, const bfToken* token, Precedence prec)
 {
-  (void)expr;
-  (void)lhs;
-  (void)token;
   (void)prec;
 
-  const uint16_t function_loc      = bfFuncBuilder_pushTemp(self->fn_builder, 1);
-  const uint16_t real_function_loc = lhs->var.kind == V_LOCAL ? lhs->var.location : function_loc;
+  const VariableInfo var    = lhs->var;
+  const int32_t      amount = token->type == BIFROST_TOKEN_INC ? 1 : -1;
+
+  if (var.location == BIFROST_VM_INVALID_SLOT)
+  {
+    Parser_EmitError(self, "Invalid target for a postfix '%.*s'.", (int)token->str_range.str_len, token->str_range.str_bgn);
+    return;
+  }
+
+  /*
+    NOTE(SR):
+      The old value is copied into [write_loc] before the variable is
+      updated in place, 'postfix_copy' lets an expression statement drop
+      that copy since nothing reads it.
+  */
+  if (var.kind == V_LOCAL)
+  {
+    self->postfix_copy = BIFROST_ARRAY_INVALID_INDEX;
+
+    if (expr->write_loc != var.location)
+    {
+      self->postfix_copy = bfVMArray_size(&self->fn_builder->instructions);
+      bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, expr->write_loc, var.location);
+    }
 
-  if (lhs->var.kind != V_LOCAL)
+    bfFuncBuilder_addInstAsBx(self->fn_builder, BIFROST_VM_OP_MATH_INC, var.location, amount);
+  }
+  else
   {
-    parserVariableLoad(self, lhs->var, function_loc);
+    const uint16_t value_loc = bfFuncBuilder_pushTemp(self->fn_builder, 1);
+
+    /* @Optimization: The load of the variable is patched to go straight into the register that gets updated. */
+    if (lhs->read_loc != expr->write_loc || !bfFuncBuilder_retargetLastInst(self->fn_builder, 0, expr->write_loc, value_loc))
+    {
+      bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, value_loc, lhs->read_loc);
+    }
+
+    self->postfix_copy = bfVMArray_size(&self->fn_builder->instructions);
+    bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_STORE_MOVE, expr->write_loc, value_loc);
+    bfFuncBuilder_addInstAsBx(self->fn_builder, BIFROST_VM_OP_MATH_INC, value_loc, amount);
+    parserVariableStore(self, var, value_loc);
+    bfFuncBuilder_popTemp(self->fn_builder, value_loc);
   }
 
-  const VariableInfo function_var = VariableInfo_temp(real_function_loc);
-  const VariableInfo return_var   = VariableInfo_temp(expr->write_loc);
+  self->postfix_end = bfVMArray_size(&self->fn_builder->instructions);
+
+  *expr = exprMakeTemp(expr->write_loc);
+}
+
+static void Expr_parseCall(BifrostParser* const self, ExprInfo* expr, const ExprInfo* lhs, const bfToken* token, Precedence prec)
+{
+  (void)token;
+  (void)prec;
 
-  FunctionCall_finish(self, function_var, return_var, BIFROST_VM_INVALID_SLOT);
+  /* @Optimization: The callee is used from wherever the lhs left it rather than being loaded a second time. */
+  const uint16_t function_loc = lhs->read_loc;
+  const uint16_t base         = FunctionCall_begin(self, expr->write_loc);
+  const uint16_t num_args     = FunctionCall_parseParameters(self, 0, BIFROST_TOKEN_R_PAREN);
 
-  bfFuncBuilder_popTemp(self->fn_builder, function_loc);
+  bfParser_eat(self, BIFROST_TOKEN_R_PAREN, false, "Function call must end with a closing parenthesis.");
+
+  FunctionCall_end(self, base, function_loc, num_args, expr->write_loc, FunctionCall_inlineTarget(self, lhs, num_args, base));
+
+  *expr = exprMakeTemp(expr->write_loc);
 }
 
 static void Expr_parseMethodCall(BifrostParser* const self, ExprInfo* expr, const ExprInfo* lhs, const bfToken* token, Precedence prec)
 {
-  (void)self;
-  (void)expr;
-  (void)lhs;
   (void)token;
   (void)prec;
 
@@ -1172,30 +2372,26 @@ static void Expr_parseMethodCall(BifrostParser* const self, ExprInfo* expr, cons
 
   bfParser_eat(self, BIFROST_TOKEN_IDENTIFIER, false, "Function call must be done on an identifier.");
 
-  const uint16_t function_loc = bfFuncBuilder_pushTemp(self->fn_builder, 2);
-  const uint16_t var_loc      = function_loc + 1;
-  const size_t   sym          = parserGetSymbol(self, method_name);
-  const uint16_t real_var_loc = (lhs->var.kind == V_LOCAL) ? lhs->var.location : var_loc;
-
-  if (lhs->var.kind != V_LOCAL)
-  {
-    parserVariableLoad(self, lhs->var, var_loc);
-  }
+  const uint16_t base     = FunctionCall_begin(self, expr->write_loc);
+  const uint16_t self_loc = FunctionCall_pushSelf(self, lhs);
+  const size_t   sym      = parserGetSymbol(self, method_name);
 
   bfFuncBuilder_addInstABC(
    self->fn_builder,
    BIFROST_VM_OP_LOAD_SYMBOL,
-   function_loc,
-   real_var_loc,
+   base,
+   self_loc,
    (uint16_t)sym);
 
-  const VariableInfo function_var = VariableInfo_temp(function_loc);
-  const VariableInfo return_var   = VariableInfo_temp(expr->write_loc);
-
   bfParser_eat(self, BIFROST_TOKEN_L_PAREN, false, "Function call must start with an open parenthesis.");
-  FunctionCall_finish(self, function_var, return_var, real_var_loc);
 
-  bfFuncBuilder_popTemp(self->fn_builder, function_loc);
+  const uint16_t num_args = FunctionCall_parseParameters(self, 1, BIFROST_TOKEN_R_PAREN);
+
+  bfParser_eat(self, BIFROST_TOKEN_R_PAREN, false, "Function call must end with a closing parenthesis.");
+
+  FunctionCall_end(self, base, base, num_args, expr->write_loc, NULL);
+
+  *expr = exprMakeTemp(expr->write_loc);
 }
 
 static bool parserIsConstexpr(const BifrostParser* const self)
@@ -1242,14 +2438,13 @@ static void parseClassVarDecl(BifrostParser* const self, BifrostObjClass* clz, c
 
   if (is_static)
   {
-    bfVM_xSetVariable(&clz->symbols, self->vm, name_str, initial_value);
+    bfVM_xSetClassSymbol(clz, self->vm, name_str, initial_value);
   }
   else
   {
-    const size_t     symbol   = parserGetSymbol(self, name_str);
-    BifrostVMSymbol* var_init = bfVMArray_emplace(self->vm, &clz->field_initializers);
-    var_init->name            = self->vm->symbols[symbol];
-    var_init->value           = initial_value;
+    const size_t symbol = parserGetSymbol(self, name_str);
+
+    bfObjClass_addField(self->vm, clz, self->vm->symbols[symbol], initial_value);
   }
 
   bfParser_eat(self, BIFROST_TOKEN_SEMI_COLON, false, "Expected semi-colon after variable declaration.");
@@ -1270,7 +2465,7 @@ static void parseClassFunc(BifrostParser* const self, BifrostObjClass* const clz
 
   // TODO(Shareef): This same line is used in 3 (or more) places and should be put in a helper.
   BifrostObjFn* const fn = bfObj_NewFunction(self->vm, self->current_module);
-  bfVM_xSetVariable(&clz->symbols, self->vm, name_str, bfVMValue_fromPointer(fn));
+  bfVM_xSetClassSymbol(clz, self->vm, name_str, bfVMValue_fromPointer(fn));
   bfParser_popBuilder(self, fn, arity);
 }
 
@@ -1332,7 +2527,7 @@ static void parseClassDecl(BifrostParser* const self)
 
   BifrostObjClass* const clz = bfObj_NewClass(self->vm, self->current_module, name_str, base_clz, 0u);
 
-  bfVM_xSetVariable(&self->current_module->variables, self->vm, name_str, bfVMValue_fromPointer(clz));
+  bfVM_xSetModuleVariable(self->current_module, self->vm, name_str, bfVMValue_fromPointer(clz));
 
   self->current_clz = clz;
   {
@@ -1414,24 +2609,30 @@ static bool Parser_parseStatement(BifrostParser* const self)
       bfParser_match(self, BIFROST_TOKEN_RETURN);
 
       const uint16_t expr_loc = bfFuncBuilder_pushTemp(self->fn_builder, 1);
+      ExprInfo       ret_expr = exprMake(expr_loc, VariableInfo_temp(BIFROST_VM_INVALID_SLOT));
 
       if (!bfParser_is(self, BIFROST_TOKEN_SEMI_COLON))
       {
-        ExprInfo ret_expr = exprMake(expr_loc, VariableInfo_temp(BIFROST_VM_INVALID_SLOT));
-        parseExpr(self, &ret_expr, PREC_NONE);
+        parseExprDeferred(self, &ret_expr, PREC_NONE);
+      }
+      else
+      {
+        bfFuncBuilder_addInstABx(self->fn_builder, BIFROST_VM_OP_LOAD_BASIC, expr_loc, BIFROST_VM_OP_LOAD_BASIC_NULL);
       }
 
       bfFuncBuilder_addInstABx(
        self->fn_builder,
        BIFROST_VM_OP_RETURN,
        0,
-       expr_loc);
+       ret_expr.read_loc);
 
       bfFuncBuilder_popTemp(self->fn_builder, expr_loc);
 
       bfParser_match(self, BIFROST_TOKEN_SEMI_COLON);
 
-      while (!bfParser_is(self, BIFROST_TOKEN_R_CURLY))
+      while (!bfParser_is(self, BIFROST_TOKEN_R_CURLY) &&
+             !bfParser_is(self, BIFROST_TOKEN_CTRL_CASE) &&
+             !bfParser_is(self, BIFROST_TOKEN_CTRL_DEFAULT))
       {
         bfParser_match(self, self->current_token.type);
       }
@@ -1439,7 +2640,7 @@ static bool Parser_parseStatement(BifrostParser* const self)
       // NOTE(Shareef):
       //   @UnreachableCode
       //   Since nothing can be executed after a return we just
-      //   keep going until we hit a closing curly brace.
+      //   keep going until we hit a closing curly brace (or the next case of a switch).
       //   This optimizes away unreachable code.
       return false;
     }
@@ -1457,7 +2658,7 @@ static bool Parser_parseStatement(BifrostParser* const self)
       const uint16_t expr_loc = bfFuncBuilder_pushTemp(self->fn_builder, 1);
 
       ExprInfo expr = exprMake(expr_loc, VariableInfo_temp(BIFROST_VM_INVALID_SLOT));
-      parseExpr(self, &expr, PREC_NONE);
+      parseExprDeferred(self, &expr, PREC_NONE);
 
       bfParser_eat(self, BIFROST_TOKEN_R_PAREN, false, "If statements must have r paren after condition.");
 
@@ -1472,9 +2673,9 @@ static bool Parser_parseStatement(BifrostParser* const self)
         const uint32_t else_jump = parserMakeJump(self);
 
         // NOTE(Shareef):
-        //   [expr_loc] can be used here since the actual
+        //   [expr.read_loc] can be used here since the actual
         //   use is where the jump is NOT here.
-        parserPatchJump(self, if_jump, expr_loc, true);
+        parserPatchJump(self, if_jump, expr.read_loc, true);
 
         Parser_parseStatement(self);
 
@@ -1482,7 +2683,7 @@ static bool Parser_parseStatement(BifrostParser* const self)
       }
       else
       {
-        parserPatchJump(self, if_jump, expr_loc, true);
+        parserPatchJump(self, if_jump, expr.read_loc, true);
       }
       break;
     }
@@ -1499,7 +2700,7 @@ static bool Parser_parseStatement(BifrostParser* const self)
 
       bfParser_eat(self, BIFROST_TOKEN_L_PAREN, false, "while statements must be followed by a left parenthesis.");
       ExprInfo expr = exprMake(expr_loc, VariableInfo_temp(BIFROST_VM_INVALID_SLOT));
-      parseExpr(self, &expr, PREC_NONE);
+      parseExprDeferred(self, &expr, PREC_NONE);
       bfParser_eat(self, BIFROST_TOKEN_R_PAREN, false, "while statement conditions must end with a right parenthesis.");
 
       const uint32_t jmp_skip = parserMakeJump(self);
@@ -1508,7 +2709,7 @@ static bool Parser_parseStatement(BifrostParser* const self)
       loopPush(self, &loop);
       Parser_parseStatement(self);
       parserPatchJumpRev(self, jmp_back, BIFROST_VM_INVALID_SLOT, false);
-      parserPatchJump(self, jmp_skip, expr_loc, true);
+      parserPatchJump(self, jmp_skip, expr.read_loc, true);
 
       bfFuncBuilder_popTemp(self->fn_builder, expr_loc);
       loopPop(self);
@@ -1522,6 +2723,11 @@ static bool Parser_parseStatement(BifrostParser* const self)
       parseVarDecl(self, is_static);
       break;
     }
+    case BIFROST_TOKEN_CONST:
+    {
+      parseConstDecl(self);
+      break;
+    }
     case BIFROST_TOKEN_FUNC:
     {
       parseFunctionDecl(self);
@@ -1538,11 +2744,34 @@ static bool Parser_parseStatement(BifrostParser* const self)
       parseForStatement(self);
       break;
     }
+    case BIFROST_TOKEN_CTRL_SWITCH:
+    {
+      bfParser_match(self, BIFROST_TOKEN_CTRL_SWITCH);
+      parseSwitchStatement(self);
+      break;
+    }
     case BIFROST_TOKEN_IDENTIFIER:
+    case BIFROST_TOKEN_INC:
+    case BIFROST_TOKEN_DEC:
     {
       const uint16_t working_loc = bfFuncBuilder_pushTemp(self->fn_builder, 1);
       ExprInfo       expr        = exprMake(working_loc, VariableInfo_temp(BIFROST_VM_INVALID_SLOT));
-      parseExpr(self, &expr, PREC_NONE);
+      const size_t   expr_start  = bfVMArray_size(&self->fn_builder->instructions);
+
+      self->postfix_copy = BIFROST_ARRAY_INVALID_INDEX;
+
+      parseExprDeferred(self, &expr, PREC_NONE);
+
+      /* @Optimization: A postfix '++' / '--' that is the whole statement has nobody to hand the old value to. */
+      if (self->postfix_copy != BIFROST_ARRAY_INVALID_INDEX &&
+          self->postfix_copy >= expr_start &&
+          self->postfix_end == bfVMArray_size(&self->fn_builder->instructions))
+      {
+        bfFuncBuilder_removeInst(self->fn_builder, self->postfix_copy);
+      }
+
+      self->postfix_copy = BIFROST_ARRAY_INVALID_INDEX;
+
       bfParser_match(self, BIFROST_TOKEN_SEMI_COLON);
       bfFuncBuilder_popTemp(self->fn_builder, working_loc);
       break;
@@ -1557,7 +2786,7 @@ static bool Parser_parseStatement(BifrostParser* const self)
     {
       const uint16_t expr_loc = bfFuncBuilder_pushTemp(self->fn_builder, 1);
       ExprInfo       expr     = exprMake(expr_loc, VariableInfo_temp(expr_loc));
-      parseExpr(self, &expr, PREC_NONE);
+      parseExprDeferred(self, &expr, PREC_NONE);
       bfFuncBuilder_popTemp(self->fn_builder, expr_loc);
       break;
     }
@@ -21,6 +21,7 @@
 #ifndef BIFROST_VM_PARSER_H
 #define BIFROST_VM_PARSER_H
 
+#include "bifrost_vm_arena.h"  // BifrostVMArena
 #include "bifrost_vm_lexer.h"  // size_t, BifrostLexer, bfToken, bool
 
 #if __cplusplus
@@ -32,6 +33,7 @@ typedef struct BifrostVMFunctionBuilder BifrostVMFunctionBuilder;
 typedef struct BifrostObjModule         BifrostObjModule;
 typedef struct BifrostObjClass          BifrostObjClass;
 typedef struct BifrostObjFn             BifrostObjFn;
+typedef struct BifrostObjStr            BifrostObjStr;
 typedef struct LoopInfo                 LoopInfo;
 
 typedef struct BifrostParser
@@ -46,11 +48,16 @@ typedef struct BifrostParser
   BifrostVM*                vm;
   bool                      has_error;
   LoopInfo*                 loop_stack;
+  BifrostObjStr*            lazy_source;  /*!< When non NULL module level function bodies are skipped and compiled on their first call. */
+  BifrostVMArena            arena;        /*!< Transient compiler data, released all at once by 'bfParser_dtor'. */
+  size_t                    postfix_copy; /*!< Instruction that saved the old value for the last postfix '++' / '--', 'BIFROST_ARRAY_INVALID_INDEX' if none. */
+  size_t                    postfix_end;  /*!< Number of instructions once that postfix operator was compiled. */
 
 } BifrostParser;
 
 void bfParser_ctor(BifrostParser* self, struct BifrostVM* vm, BifrostLexer* lexer, struct BifrostObjModule* current_module);
 bool bfParser_compile(BifrostParser* self);
+bool bfParser_compileFunction(BifrostParser* self, BifrostObjFn* fn);
 void bfParser_dtor(BifrostParser* self);
 
 #if __cplusplus
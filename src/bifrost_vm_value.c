@@ -159,6 +159,24 @@ bool bfVMValue_ee(const BifrostValue lhs, const BifrostValue rhs)
   return lhs == rhs;
 }
 
+uint32_t bfVMValue_hash(const BifrostValue value)
+{
+  if (bfVMValue_isPointer(value) && BIFROST_AS_OBJ(value)->type == BIFROST_VM_OBJ_STRING)
+  {
+    return ((const BifrostObjStr*)BIFROST_AS_OBJ(value))->hash;
+  }
+
+  /* NOTE(SR): -0.0 and 0.0 compare equal so they must hash the same. */
+  BifrostValue bits = bfVMValue_isNumber(value) && bfVMValue_asNumber(value) == 0.0 ? bfVMValue_fromNumber(0.0) : value;
+
+  /* NOTE(SR): Finalizer from MurmurHash3. */
+  bits ^= bits >> 33;
+  bits *= 0xFF51AFD7ED558CCDull;
+  bits ^= bits >> 33;
+
+  return (uint32_t)bits;
+}
+
 bool bfVMValue_lt(const BifrostValue lhs, const BifrostValue rhs)
 {
   if (bfVMValue_isNumber(lhs) && bfVMValue_isNumber(rhs))
@@ -66,6 +66,7 @@ BifrostValue bfVMValue_sub(const BifrostValue lhs, const BifrostValue rhs);
 BifrostValue bfVMValue_mul(const BifrostValue lhs, const BifrostValue rhs);
 BifrostValue bfVMValue_div(const BifrostValue lhs, const BifrostValue rhs);
 bool      bfVMValue_ee(const BifrostValue lhs, const BifrostValue rhs);
+uint32_t  bfVMValue_hash(const BifrostValue value); /* Consistent with 'bfVMValue_ee'. */
 bool      bfVMValue_lt(const BifrostValue lhs, const BifrostValue rhs);
 bool      bfVMValue_gt(const BifrostValue lhs, const BifrostValue rhs);
 bool      bfVMValue_ge(const BifrostValue lhs, const BifrostValue rhs);
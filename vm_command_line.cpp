@@ -15,9 +15,30 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include "bifrost/bifrost_vm.hpp"  // VM C++ API
 
-#include <cassert>   // assert
-#include <cstdio>    // printf, fopen, fclose, ftell, fseek, fread, malloc
-#include <iostream>  // cin
+#include <algorithm>      // min
+#include <atomic>         // atomic
+#include <cassert>        // assert
+#include <chrono>         // steady_clock
+#include <cstdio>         // printf, fopen, fclose, ftell, fseek, fread, malloc, rename, snprintf
+#include <cctype>         // isalpha, isalnum, isspace
+#include <cstdlib>        // atoi
+#include <cstring>        // strcmp, strncmp, strstr, memcpy
+#include <iostream>       // cin
+#include <string>         // string, to_string
+#include <thread>         // thread
+#include <unordered_map>  // unordered_map
+#include <unordered_set>  // unordered_set
+#include <vector>         // vector
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>     // open, O_RDONLY
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+#define BIFROST_CLI_HAS_MMAP 1
+#else
+#define BIFROST_CLI_HAS_MMAP 0
+#endif
 
 struct MemoryUsageTracker final
 {
@@ -25,26 +46,33 @@ struct MemoryUsageTracker final
   std::size_t current_usage;
 };
 
+struct PrefetchedModule final
+{
+  std::string              contents;  // The source, or a bytecode image if it was compiled ahead of time.
+  std::vector<std::string> imports;   // Every non std:* module this one imports.
+};
+
+static const char*                                       s_CacheDirectory = nullptr;
+static std::unordered_map<std::string, PrefetchedModule> s_PrefetchedModules;
+
 static void  errorHandler(BifrostVM* vm, BifrostVMError err, int line_no, const char* message) noexcept;
 static void  printHandler(BifrostVM* vm, const char* message) noexcept;
 static void  moduleHandler(BifrostVM* vm, const char* from, const char* module, BifrostVMModuleLookUp* out) noexcept;
+static void  cacheLookUpHandler(BifrostVM* vm, const char* module, uint64_t source_hash, BifrostVMModuleLookUp* out) noexcept;
+static void  cacheStoreHandler(BifrostVM* vm, const char* module, uint64_t source_hash, const void* bytecode, size_t bytecode_size) noexcept;
 static void* memoryHandler(void* user_data, void* ptr, size_t old_size, size_t new_size) noexcept;
 static void  waitForInput() noexcept;
+static int   benchmarkCompile(const BifrostVMParams& params, int num_constants);
+static int   compileToBytecode(const BifrostVMParams& params, const char* src_file, const char* dst_file);
+static int   runMappedBytecode(const BifrostVMParams& params, const char* image_file);
+static int   runStreamed(const BifrostVMParams& params, const char* src_file);
+static int   runReloaded(const BifrostVMParams& params, const char* src_file, const char* new_file);
+static void  prefetchModules(const BifrostVMParams& params, const char* entry_file, int num_jobs);
 
 int main(int argc, char* argv[])
 {
 #if defined(__EMSCRIPTEN__) && __EMSCRIPTEN__
   const char* const file_name = "assets/scripts/test_script.bscript";
-#else
-  if (argc != 2)
-  {
-    std::printf("There is an example script loaded at 'assets/scripts/test_script.bscript'\n");
-    std::printf("usage %s <file-name>\n", argv[0]);
-    waitForInput();
-    return 0;
-  }
-
-  const char* const file_name = argv[1];
 #endif
 
   MemoryUsageTracker mem_tracker{0, 0};
@@ -57,6 +85,90 @@ int main(int argc, char* argv[])
   params.memory_fn = &memoryHandler;
   params.user_data = &mem_tracker;
 
+  if (argc >= 3 && std::strcmp(argv[1], "--strip-debug") == 0)
+  {
+    params.strip_debug_info = true;
+    --argc;
+    ++argv;
+  }
+
+  if (argc >= 3 && std::strcmp(argv[1], "--lazy") == 0)
+  {
+    params.lazy_compile = true;
+    --argc;
+    ++argv;
+  }
+
+#if !(defined(__EMSCRIPTEN__) && __EMSCRIPTEN__)
+  int num_jobs = 0;
+
+  for (;; argc -= 2, argv += 2)
+  {
+    if (argc >= 4 && std::strcmp(argv[1], "--cache") == 0)
+    {
+      s_CacheDirectory       = argv[2];
+      params.cache_lookup_fn = &cacheLookUpHandler;
+      params.cache_store_fn  = &cacheStoreHandler;
+    }
+    else if (argc >= 4 && std::strcmp(argv[1], "--jobs") == 0)
+    {
+      const int requested_jobs = std::atoi(argv[2]);
+
+      num_jobs = requested_jobs > 0 ? requested_jobs : int(std::max(std::thread::hardware_concurrency(), 1u));
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  if (argc == 3 && std::strcmp(argv[1], "--bench-compile") == 0)
+  {
+    return benchmarkCompile(params, std::atoi(argv[2]));
+  }
+
+  if (argc == 4 && std::strcmp(argv[1], "--compile") == 0)
+  {
+    return compileToBytecode(params, argv[2], argv[3]);
+  }
+
+  if (argc == 3 && std::strcmp(argv[1], "--map") == 0)
+  {
+    return runMappedBytecode(params, argv[2]);
+  }
+
+  if (argc == 3 && std::strcmp(argv[1], "--stream") == 0)
+  {
+    return runStreamed(params, argv[2]);
+  }
+
+  if (argc == 4 && std::strcmp(argv[1], "--reload") == 0)
+  {
+    return runReloaded(params, argv[2], argv[3]);
+  }
+
+  if (argc != 2)
+  {
+    std::printf("There is an example script loaded at 'assets/scripts/test_script.bscript'\n");
+    std::printf("usage %s <file-name>\n", argv[0]);
+    std::printf("      %s --bench-compile <num-constants>\n", argv[0]);
+    std::printf("      %s [--strip-debug] --compile <file-name> <output-file>\n", argv[0]);
+    std::printf("      %s --map <bytecode-file>\n", argv[0]);
+    std::printf("      %s --stream <file-name>\n", argv[0]);
+    std::printf("      %s --reload <file-name> <new-file-name>\n", argv[0]);
+    std::printf("      %s [--lazy] [--cache <directory>] [--jobs <num-threads>] <file-name>\n", argv[0]);
+    waitForInput();
+    return 0;
+  }
+
+  const char* const file_name = argv[1];
+
+  if (num_jobs)
+  {
+    prefetchModules(params, file_name, num_jobs);
+  }
+#endif
+
   {
     BifrostVM vm;
     bfVM_ctor(&vm, &params);
@@ -161,6 +273,20 @@ static void printHandler(BifrostVM* /*vm*/, const char* message) noexcept
 
 static void moduleHandler(BifrostVM* vm, const char* /*from*/, const char* module, BifrostVMModuleLookUp* out) noexcept
 {
+  const auto prefetched = s_PrefetchedModules.find(module);
+
+  if (prefetched != s_PrefetchedModules.end())
+  {
+    const std::string& contents = prefetched->second.contents;
+    char* const        buffer   = static_cast<char*>(memoryHandler(bfVM_userData(vm), nullptr, 0u, sizeof(char) * (contents.size() + 1)));
+
+    std::memcpy(buffer, contents.c_str(), contents.size() + 1);
+
+    out->source     = buffer;
+    out->source_len = contents.size();
+    return;
+  }
+
   FILE* const file      = std::fopen(module, "rb");  // NOLINT(android-cloexec-fopen)
   char*       buffer    = nullptr;
   long        file_size = 0u;
@@ -197,6 +323,50 @@ static void moduleHandler(BifrostVM* vm, const char* /*from*/, const char* modul
   out->source_len = file_size;
 }
 
+//
+// The compile cache is one bytecode image per module name + source hash,
+// editing a script just leaves its old image behind to be cleaned up manually.
+//
+static std::string cachePath(const char* module, uint64_t source_hash)
+{
+  std::string path = std::string(s_CacheDirectory) + "/";
+
+  for (const char* c = module; *c; ++c)
+  {
+    path += (*c == '/' || *c == '\\' || *c == ':') ? '_' : *c;
+  }
+
+  char hash_str[24];
+  std::snprintf(hash_str, sizeof(hash_str), "-%016llx", static_cast<unsigned long long>(source_hash));
+
+  return path + hash_str + ".bsc";
+}
+
+static void cacheLookUpHandler(BifrostVM* vm, const char* module, uint64_t source_hash, BifrostVMModuleLookUp* out) noexcept
+{
+  moduleHandler(vm, nullptr, cachePath(module, source_hash).c_str(), out);
+}
+
+static void cacheStoreHandler(BifrostVM* /*vm*/, const char* module, uint64_t source_hash, const void* bytecode, size_t bytecode_size) noexcept
+{
+  // Written to the side then renamed so a concurrent run never reads half an image.
+  const std::string path      = cachePath(module, source_hash);
+  const std::string temp_path = path + ".tmp";
+  FILE* const       file      = std::fopen(temp_path.c_str(), "wb");  // NOLINT(android-cloexec-fopen)
+
+  if (file)
+  {
+    const bool written = std::fwrite(bytecode, 1, bytecode_size, file) == bytecode_size;
+
+    if (std::fclose(file) == 0 && written && std::rename(temp_path.c_str(), path.c_str()) == 0)
+    {
+      return;
+    }
+
+    std::remove(temp_path.c_str());
+  }
+}
+
 static void* memoryHandler(void* user_data, void* ptr, size_t old_size, size_t new_size) noexcept
 {
   //
@@ -245,6 +415,484 @@ static void waitForInput() noexcept
 #endif
 }
 
+//
+// Generates a single function with [num_constants] unique number constants
+// (and a couple hundred locals referenced throughout) then times how long
+// it takes to compile, this is the worst case for machine generated data tables.
+//
+static int benchmarkCompile(const BifrostVMParams& params, int num_constants)
+{
+  static constexpr int k_NumLocals = 200;
+
+  if (num_constants <= 0)
+  {
+    std::printf("--bench-compile expects a positive number of constants.\n");
+    return 1;
+  }
+
+  std::string source = "func bench()\n{\n  var x;\n";
+
+  for (int i = 0; i < k_NumLocals; ++i)
+  {
+    source += "  var v" + std::to_string(i) + " = " + std::to_string(i) + ";\n";
+  }
+
+  for (int i = 0; i < num_constants; ++i)
+  {
+    source += "  x = " + std::to_string(i + k_NumLocals) + ".5;\n";
+    source += "  x = v" + std::to_string(i % k_NumLocals) + ";\n";
+  }
+
+  source += "}\n";
+
+  BifrostVM vm;
+  bfVM_ctor(&vm, &params);
+
+  const auto           time_bgn = std::chrono::steady_clock::now();
+  const BifrostVMError err      = bfVM_execInModule(&vm, nullptr, source.c_str(), source.length());
+  const auto           time_end = std::chrono::steady_clock::now();
+
+  bfVM_dtor(&vm);
+
+  if (err)
+  {
+    return err;
+  }
+
+  const double elapsed_ms = std::chrono::duration<double, std::milli>(time_end - time_bgn).count();
+
+  std::printf("Compiled %i constants (%u bytes of source) in %.3f ms\n", num_constants, unsigned(source.length()), elapsed_ms);
+
+  return 0;
+}
+
+//
+// Compiles [src_file] without running it and writes out the bytecode image,
+// the output can be passed back into this program (or imported) like a script.
+//
+static int compileToBytecode(const BifrostVMParams& params, const char* src_file, const char* dst_file)
+{
+  BifrostVM vm;
+  bfVM_ctor(&vm, &params);
+
+  BifrostVMModuleLookUp load_file;
+
+  moduleHandler(&vm, nullptr, src_file, &load_file);
+
+  if (!load_file.source || load_file.source_len == 0)
+  {
+    std::printf("failed to load '%s'\n", src_file);
+    bfVM_dtor(&vm);
+    return 1;
+  }
+
+  bfVM_stackResize(&vm, 1);
+  bfVM_moduleLoadStd(&vm, 0, BIFROST_VM_STD_MODULE_ALL);
+
+  BifrostVMError err = bfVM_compileInModule(&vm, nullptr, load_file.source, load_file.source_len);
+
+  memoryHandler(bfVM_userData(&vm), const_cast<char*>(load_file.source), sizeof(char) * (load_file.source_len + 1u), 0u);
+
+  if (!err)
+  {
+    FILE* const file = std::fopen(dst_file, "wb");  // NOLINT(android-cloexec-fopen)
+
+    if (file)
+    {
+      err = bfVM_moduleSaveBytecode(&vm, 0, [](void* user_data, const void* data, size_t data_size) {
+        std::fwrite(data, 1, data_size, static_cast<FILE*>(user_data));
+      }, file);
+
+      if (!err)
+      {
+        std::printf("Compiled '%s' to '%s' (%u bytes)\n", src_file, dst_file, unsigned(std::ftell(file)));
+      }
+
+      std::fclose(file);
+    }
+    else
+    {
+      std::printf("failed to open '%s' for writing\n", dst_file);
+      err = BIFROST_VM_ERROR_INVALID_ARGUMENT;
+    }
+  }
+
+  bfVM_dtor(&vm);
+
+  return err;
+}
+
+//
+// Runs an image made by '--compile' straight out of a read only mapping of
+// the file, the mapping has to outlive the vm.
+//
+static int runMappedBytecode(const BifrostVMParams& params, const char* image_file)
+{
+  BifrostVM vm;
+  bfVM_ctor(&vm, &params);
+
+  const void* image      = nullptr;
+  std::size_t image_size = 0u;
+
+#if BIFROST_CLI_HAS_MMAP
+  const int file = open(image_file, O_RDONLY);  // NOLINT(android-cloexec-open)
+
+  if (file != -1)
+  {
+    struct stat file_info;
+
+    if (fstat(file, &file_info) == 0 && file_info.st_size > 0)
+    {
+      void* const mapping = mmap(nullptr, std::size_t(file_info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+      if (mapping != MAP_FAILED)
+      {
+        image      = mapping;
+        image_size = std::size_t(file_info.st_size);
+      }
+    }
+
+    close(file);
+  }
+#else
+  BifrostVMModuleLookUp load_file;
+
+  moduleHandler(&vm, nullptr, image_file, &load_file);
+
+  image      = load_file.source;
+  image_size = load_file.source_len;
+#endif
+
+  if (!image || image_size == 0)
+  {
+    std::printf("failed to load '%s'\n", image_file);
+    bfVM_dtor(&vm);
+    return 1;
+  }
+
+  bfVM_stackResize(&vm, 1);
+  bfVM_moduleLoadStd(&vm, 0, BIFROST_VM_STD_MODULE_ALL);
+
+  const BifrostVMError err = bfVM_moduleMapBytecode(&vm, nullptr, image, image_size);
+
+  bfVM_dtor(&vm);
+
+#if BIFROST_CLI_HAS_MMAP
+  munmap(const_cast<void*>(image), image_size);
+#else
+  memoryHandler(params.user_data, const_cast<void*>(image), sizeof(char) * (image_size + 1u), 0u);
+#endif
+
+  return err;
+}
+
+static std::size_t readSourceChunk(void* user_data, char* buffer, std::size_t buffer_size) noexcept
+{
+  return std::fread(buffer, sizeof(char), buffer_size, static_cast<std::FILE*>(user_data));
+}
+
+static int runStreamed(const BifrostVMParams& params, const char* src_file)
+{
+  std::FILE* const file = std::fopen(src_file, "rb");
+
+  if (!file)
+  {
+    std::printf("failed to load '%s'\n", src_file);
+    return 1;
+  }
+
+  const MemoryUsageTracker& mem_tracker = *static_cast<const MemoryUsageTracker*>(params.user_data);
+
+  {
+    BifrostVM vm;
+    bfVM_ctor(&vm, &params);
+
+    bfVM_stackResize(&vm, 1);
+    bfVM_moduleLoadStd(&vm, 0, BIFROST_VM_STD_MODULE_ALL);
+
+    const BifrostVMError err = bfVM_execInModuleStream(&vm, nullptr, &readSourceChunk, file);
+
+    std::fclose(file);
+
+    if (err)
+    {
+      bfVM_dtor(&vm);
+      return err;
+    }
+
+    std::printf("Memory Stats:\n");
+    std::printf("\tPeak    Usage: %u (bytes)\n", unsigned(mem_tracker.peak_usage));
+    std::printf("\tCurrent Usage: %u (bytes)\n", unsigned(mem_tracker.current_usage));
+
+    bfVM_dtor(&vm);
+  }
+
+  std::printf("\tAfter    Dtor: %u (bytes)\n", unsigned(mem_tracker.current_usage));
+
+  return 0;
+}
+
+//
+// Runs [src_file] as a module named after the file, reloads that module
+// with the source of [new_file] then calls its 'main' function (if any)
+// so the reloaded code runs against the state the first run left behind.
+//
+static int runReloaded(const BifrostVMParams& params, const char* src_file, const char* new_file)
+{
+  BifrostVM vm;
+  bfVM_ctor(&vm, &params);
+
+  BifrostVMModuleLookUp load_file;
+  BifrostVMModuleLookUp load_new_file;
+
+  moduleHandler(&vm, nullptr, src_file, &load_file);
+  moduleHandler(&vm, nullptr, new_file, &load_new_file);
+
+  BifrostVMError err = BIFROST_VM_ERROR_NONE;
+
+  if (!load_file.source || load_file.source_len == 0 || !load_new_file.source || load_new_file.source_len == 0)
+  {
+    std::printf("failed to load '%s' or '%s'\n", src_file, new_file);
+    err = BIFROST_VM_ERROR_MODULE_NOT_FOUND;
+  }
+  else
+  {
+    bfVM_stackResize(&vm, 1);
+    bfVM_moduleLoadStd(&vm, 0, BIFROST_VM_STD_MODULE_ALL);
+
+    err = bfVM_execInModule(&vm, src_file, load_file.source, load_file.source_len);
+
+    if (!err)
+    {
+      err = bfVM_moduleReload(&vm, src_file, load_new_file.source, load_new_file.source_len);
+    }
+
+    if (!err)
+    {
+      bfVM_stackResize(&vm, 2);
+      bfVM_moduleLoad(&vm, 0, src_file, std::strlen(src_file));
+      bfVM_stackLoadVariable(&vm, 1, 0, "main");
+
+      if (bfVM_stackGetType(&vm, 1) == BIFROST_VM_FUNCTION)
+      {
+        err = bfVM_call(&vm, 1, 1, 0);
+      }
+    }
+  }
+
+  if (load_file.source)
+  {
+    memoryHandler(params.user_data, const_cast<char*>(load_file.source), sizeof(char) * (load_file.source_len + 1u), 0u);
+  }
+
+  if (load_new_file.source)
+  {
+    memoryHandler(params.user_data, const_cast<char*>(load_new_file.source), sizeof(char) * (load_new_file.source_len + 1u), 0u);
+  }
+
+  bfVM_dtor(&vm);
+
+  return err;
+}
+
+template<typename F>
+static void parallelFor(std::size_t count, int num_jobs, F&& fn)
+{
+  std::atomic<std::size_t> next_index{0u};
+  std::vector<std::thread> threads;
+
+  const auto worker = [&]() {
+    for (std::size_t i = next_index++; i < count; i = next_index++)
+    {
+      fn(i);
+    }
+  };
+
+  const std::size_t num_threads = std::min(count, std::size_t(num_jobs));
+
+  for (std::size_t i = 1; i < num_threads; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+
+  worker();
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+}
+
+static bool readFile(const char* path, std::string& out)
+{
+  FILE* const file = std::fopen(path, "rb");  // NOLINT(android-cloexec-fopen)
+
+  if (!file)
+  {
+    return false;
+  }
+
+  std::fseek(file, 0, SEEK_END);
+  const long file_size = std::ftell(file);
+  std::fseek(file, 0, SEEK_SET);
+
+  const bool success = file_size > 0 && (out.resize(std::size_t(file_size)), std::fread(&out[0], 1, out.size(), file) == out.size());
+
+  std::fclose(file);
+
+  return success;
+}
+
+//
+// A rough scan for 'import "<module>"' that only has to know enough
+// of the grammar to skip over comments and string literals.
+//
+static std::vector<std::string> scanImports(const std::string& source)
+{
+  std::vector<std::string> imports;
+  const char*              c   = source.c_str();
+  const char* const        end = c + source.size();
+
+  const auto skipString = [&end](const char* str) {
+    while (str < end && *str != '"')
+    {
+      str += (*str == '\\' && str + 1 < end) ? 2 : 1;
+    }
+
+    return str;
+  };
+
+  while (c < end)
+  {
+    if (c[0] == '/' && c[1] == '/')
+    {
+      while (c < end && *c != '\n') ++c;
+    }
+    else if (c[0] == '/' && c[1] == '*')
+    {
+      const char* const comment_end = std::strstr(c + 2, "*/");
+
+      c = comment_end ? comment_end + 2 : end;
+    }
+    else if (*c == '"')
+    {
+      c = skipString(c + 1) + 1;
+    }
+    else if (std::isalpha(static_cast<unsigned char>(*c)) || *c == '_')
+    {
+      const char* const word = c;
+
+      while (c < end && (std::isalnum(static_cast<unsigned char>(*c)) || *c == '_')) ++c;
+
+      if (c - word == 6 && std::strncmp(word, "import", 6) == 0)
+      {
+        while (c < end && std::isspace(static_cast<unsigned char>(*c))) ++c;
+
+        if (c < end && *c == '"')
+        {
+          const char* const name_end = skipString(c + 1);
+          const std::string name(c + 1, name_end);
+
+          if (name.compare(0, 4, "std:") != 0)
+          {
+            imports.push_back(name);
+          }
+
+          c = name_end + 1;
+        }
+      }
+    }
+    else
+    {
+      ++c;
+    }
+  }
+
+  return imports;
+}
+
+//
+// Loads the whole import graph of [entry_file] up front:
+//   1. Files are read and scanned for imports on [num_jobs] threads, a level of the graph at a time.
+//   2. Modules that only import std:* modules are compiled to bytecode images on
+//      the same threads with 'bfVM_compileDetached'.
+//   3. The real vm then runs as normal, 'moduleHandler' hands out the prefetched
+//      contents so the images are linked and initializers run in dependency order on this thread.
+// A module importing a user module has to be compiled on the vm's thread after
+// its dependencies ran since imports copy their variables at compile time.
+//
+static void prefetchModules(const BifrostVMParams& params, const char* entry_file, int num_jobs)
+{
+  std::vector<std::string>        frontier = {entry_file};
+  std::unordered_set<std::string> seen     = {entry_file};
+
+  while (!frontier.empty())
+  {
+    std::vector<PrefetchedModule> level(frontier.size());
+    std::vector<char>             found(frontier.size(), false);
+
+    parallelFor(frontier.size(), num_jobs, [&](std::size_t i) {
+      found[i] = readFile(frontier[i].c_str(), level[i].contents);
+
+      if (found[i])
+      {
+        level[i].imports = scanImports(level[i].contents);
+      }
+    });
+
+    std::vector<std::string> next_frontier;
+
+    for (std::size_t i = 0; i < frontier.size(); ++i)
+    {
+      if (!found[i])
+      {
+        continue;  // Left for 'moduleHandler' to report like any other missing module.
+      }
+
+      for (const std::string& import : level[i].imports)
+      {
+        if (seen.insert(import).second)
+        {
+          next_frontier.push_back(import);
+        }
+      }
+
+      s_PrefetchedModules.emplace(frontier[i], std::move(level[i]));
+    }
+
+    frontier = std::move(next_frontier);
+  }
+
+  std::vector<std::pair<const std::string, PrefetchedModule>*> leaves;
+
+  for (auto& module : s_PrefetchedModules)
+  {
+    if (module.second.imports.empty())
+    {
+      leaves.push_back(&module);
+    }
+  }
+
+  parallelFor(leaves.size(), num_jobs, [&](std::size_t i) {
+    const std::string& name   = leaves[i]->first;
+    PrefetchedModule&  module = leaves[i]->second;
+
+    // Errors are left for the real vm to report when it compiles the source in order.
+    MemoryUsageTracker worker_tracker{0, 0};
+    BifrostVMParams    worker_params = params;
+    worker_params.user_data          = &worker_tracker;
+
+    // The entry script runs in an anonymous module.
+    const char* const module_name = name == entry_file ? nullptr : name.c_str();
+    std::string       image;
+
+    if (!bfVM_compileDetached(&worker_params, module_name, module.contents.c_str(), module.contents.size(), [](void* user_data, const void* data, size_t data_size) { static_cast<std::string*>(user_data)->append(static_cast<const char*>(data), data_size); }, &image))
+    {
+      module.contents = std::move(image);
+    }
+  });
+}
+
 #if 0
 
 // TODO(SR): REMOVE ME